@@ -83,7 +83,12 @@ PartiallyGroundedAction::apply( const State& s, std::vector<Atom>& atoms ) const
 }
 
 GroundAction::GroundAction(unsigned id, const ActionData& action_data, const Binding& binding, const fs::Formula* precondition, const std::vector<const fs::ActionEffect*>& effects) :
-	ActionBase(action_data, binding, precondition, effects), _id(id)
+	ActionBase(action_data, binding, precondition, effects), _id(id), _program(_precondition)
+{}
+
+// The program needs to point to the precondition owned by this very action, not to that of 'other'
+GroundAction::GroundAction(const GroundAction& other) :
+	ActionBase(other), _id(other._id), _program(_precondition)
 {}
 
 void
@@ -5,6 +5,7 @@
 #include <fs/core/utils/binding.hxx>
 #include <fs/core/applicability/action_managers.hxx>
 #include <fs/core/languages/fstrips/axioms.hxx>
+#include <fs/core/languages/fstrips/bytecode.hxx>
 #include <utility>
 
 namespace fs0::language::fstrips {  class Term; class Formula; class ActionEffect; class ProceduralEffect; }
@@ -147,6 +148,9 @@ protected:
 	//! The id that identifies the concrete action within the whole set of ground actions
 	unsigned _id;
 
+	//! The precondition of the action, compiled into a flat program
+	fs::FormulaProgram _program;
+
 public:
 	//! Trait required by aptk::DetStateModel
 	using IdType = ActionIdx;
@@ -156,9 +160,12 @@ public:
 
 	GroundAction(unsigned id, const ActionData& action_data, const Binding& binding, const fs::Formula* precondition, const std::vector<const fs::ActionEffect*>& effects);
 	~GroundAction() override = default;
-	GroundAction(const GroundAction&) = default;
+	GroundAction(const GroundAction& other);
 
 	unsigned getId() const { return _id; }
+
+	//! The (compiled) precondition of the action, to be used for performant applicability checks
+	const fs::FormulaProgram& getPreconditionProgram() const { return _program; }
     void apply( const State& s, std::vector<Atom>& atoms ) const override;
 
 };
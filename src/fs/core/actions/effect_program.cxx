@@ -0,0 +1,226 @@
+
+#include <fs/core/actions/effect_program.hxx>
+#include <fs/core/problem_info.hxx>
+#include <fs/core/state.hxx>
+#include <fs/core/atom.hxx>
+
+
+namespace fs0 {
+
+EffectProgram::EffectProgram(const SimpleLiftedOperator& op, const ProblemInfo& info, TableStore& tables) :
+	_info(info)
+{
+	for (const auto& eff:op.effects) {
+		assert(!eff.atom.negated); // effect "atoms" cannot be negated, as they are in reality simple assignments
+		EffectT effect;
+		compile_condition(eff.condition, effect, tables);
+		effect.atom = compile_atom(eff.atom.predicate_id, eff.atom.arguments, tables);
+		effect.value = compile_operand(eff.atom.value);
+		_effects.push_back(effect);
+	}
+}
+
+EffectProgram::OperandT
+EffectProgram::compile_operand(const SimpleLiftedOperator::simple_term& term) const {
+	if (term.type == SimpleLiftedOperator::term_t::var) return {term.val.varidx, object_id::INVALID};
+	return {NONE, term.val.o};
+}
+
+void
+EffectProgram::compile_condition(const SimpleLiftedOperator::condition_t& condition, EffectT& effect, TableStore& tables) {
+	effect.eq_begin = _equalities.size();
+	for (const auto& eq:condition.simpleeqs) {
+		_equalities.push_back({compile_operand(eq.lhs), compile_operand(eq.rhs), !eq.is_eq()});
+	}
+	effect.eq_end = _equalities.size();
+
+	// Compile all atoms first, as that pushes elements into '_literals'
+	std::vector<LiteralT> literals;
+	for (const auto& atom:condition.fluents) {
+		literals.push_back({compile_atom(atom.predicate_id, atom.arguments, tables), compile_operand(atom.value), atom.negated});
+	}
+	effect.lit_begin = _literals.size();
+	_literals.insert(_literals.end(), literals.begin(), literals.end());
+	effect.lit_end = _literals.size();
+}
+
+uint32_t
+EffectProgram::compile_atom(unsigned symbol, const std::vector<SimpleLiftedOperator::simple_term>& arguments, TableStore& tables) {
+	AtomT atom;
+	atom.symbol = symbol;
+	atom.begin = _arguments.size();
+	for (const auto& arg:arguments) {
+		_arguments.push_back({compile_operand(arg), NONE, 0});
+	}
+	atom.end = _arguments.size();
+	atom.table = compile_table(atom, tables);
+	_atoms.push_back(atom);
+	return _atoms.size() - 1;
+}
+
+uint32_t
+EffectProgram::positions(TypeIdx type) {
+	for (unsigned i = 0; i < _position_types.size(); ++i) {
+		if (_position_types[i] == type) return i;
+	}
+
+	const auto& objects = _info.getTypeObjects(type);
+	std::vector<uint32_t> map;
+	for (unsigned i = 0; i < objects.size(); ++i) {
+		auto v = objects[i].value();
+		if (v >= MAX_TABLE_SIZE) return NONE; // e.g. negative integers; not worth a dense map
+		if (v >= map.size()) map.resize(v + 1, NONE);
+		map[v] = i;
+	}
+	_positions.push_back(std::move(map));
+	_position_types.push_back(type);
+	return _positions.size() - 1;
+}
+
+uint32_t
+EffectProgram::compile_table(AtomT& atom, TableStore& tables) {
+	const SymbolData& data = _info.getSymbolData(atom.symbol);
+	if (data.hasUnboundedArity() || data.getArity() != atom.end - atom.begin) return NONE;
+	const Signature& signature = data.getSignature();
+
+	// The domain of each argument that is a parameter, and the (mixed-radix) stride of the argument in the table.
+	// Note that the layout of the table does not depend on which parameters the arguments are, only on which ones
+	// are parameters, hence all atoms with the same symbol and constants can share it.
+	TableStore::KeyT key(atom.symbol, {});
+	std::size_t size = 1;
+	for (uint32_t i = atom.begin; i < atom.end; ++i) {
+		ArgumentT& arg = _arguments[i];
+		key.second.push_back(arg.operand.slot == NONE ? arg.operand.constant : object_id::INVALID);
+		if (arg.operand.slot == NONE) continue;
+		TypeIdx type = signature[i - atom.begin];
+		arg.positions = positions(type);
+		if (arg.positions == NONE) return NONE;
+		arg.stride = size;
+		size *= _info.getTypeObjects(type).size();
+		if (size > MAX_TABLE_SIZE) return NONE;
+	}
+
+	auto it = tables._tables.find(key);
+	if (it == tables._tables.end()) {
+		if (size > tables._budget) return NONE;
+		tables._budget -= size;
+		tables._num_cells += size;
+		it = tables._tables.emplace(std::move(key), build_table(atom, size)).first;
+	}
+
+	// Tables are few, so that a linear search is enough to avoid holding the same one twice
+	for (uint32_t t = 0; t < _tables.size(); ++t) {
+		if (_tables[t] == it->second) return t;
+	}
+	_tables.push_back(it->second);
+	return _tables.size() - 1;
+}
+
+std::shared_ptr<const EffectProgram::TableT>
+EffectProgram::build_table(const AtomT& atom, std::size_t size) const {
+	const SymbolData& data = _info.getSymbolData(atom.symbol);
+	const Signature& signature = data.getSignature();
+
+	// Fill in the table with all the ground atoms that can result from the lifted atom
+	const auto& fluents = _info.get_fluent_index();
+	auto table = std::make_shared<TableT>(size, CellT{INVALID_VARIABLE, object_id::INVALID});
+	std::vector<object_id> ground(atom.end - atom.begin);
+	for (std::size_t index = 0; index < size; ++index) {
+		for (uint32_t i = atom.begin; i < atom.end; ++i) {
+			const ArgumentT& arg = _arguments[i];
+			if (arg.operand.slot == NONE) {
+				ground[i - atom.begin] = arg.operand.constant;
+			} else {
+				const auto& domain = _info.getTypeObjects(signature[i - atom.begin]);
+				ground[i - atom.begin] = domain[(index / arg.stride) % domain.size()];
+			}
+		}
+
+		CellT& cell = (*table)[index];
+		auto it = fluents.find(std::make_pair(atom.symbol, ground));
+		if (it != fluents.end()) {
+			cell.variable = it->second;
+		} else if (data.isStatic()) {
+			// Some static functions are partial; such cells are left unresolved, and dealt with (if ever) at runtime
+			try { cell.value = data.getFunction()(ground); }
+			catch (const std::exception&) {}
+		}
+	}
+	return table;
+}
+
+const EffectProgram::CellT*
+EffectProgram::cell(const AtomT& atom, const std::vector<object_id>& binding) const {
+	if (atom.table == NONE) return nullptr;
+	const TableT& table = *_tables[atom.table];
+	std::size_t index = 0;
+	for (uint32_t i = atom.begin; i < atom.end; ++i) {
+		const ArgumentT& arg = _arguments[i];
+		if (arg.operand.slot == NONE) continue;
+		const auto& map = _positions[arg.positions];
+		auto v = binding[arg.operand.slot].value();
+		if (v >= map.size() || map[v] == NONE) return nullptr;
+		index += std::size_t(map[v]) * arg.stride;
+	}
+	const CellT* cell = &table[index];
+	if (cell->variable == INVALID_VARIABLE && cell->value == object_id::INVALID) return nullptr;
+	return cell;
+}
+
+void
+EffectProgram::bind(const AtomT& atom, const std::vector<object_id>& binding, std::vector<object_id>& arguments) const {
+	arguments.clear();
+	for (uint32_t i = atom.begin; i < atom.end; ++i) {
+		arguments.push_back(value(_arguments[i].operand, binding));
+	}
+}
+
+object_id
+EffectProgram::evaluate(const AtomT& atom, const State& state, const std::vector<object_id>& binding) const {
+	if (const CellT* c = cell(atom, binding)) {
+		return c->variable != INVALID_VARIABLE ? state.getValue(c->variable) : c->value;
+	}
+
+	// Slow path, as in 'evaluate_simple_lifted_operator'
+	thread_local std::vector<object_id> arguments;
+	bind(atom, binding, arguments);
+	const auto& fluents = _info.get_fluent_index();
+	auto it = fluents.find(std::make_pair(atom.symbol, arguments));
+	if (it != fluents.end()) return state.getValue(it->second);
+	return _info.getSymbolData(atom.symbol).evaluate(arguments);
+}
+
+VariableIdx
+EffectProgram::resolve(const AtomT& atom, const std::vector<object_id>& binding) const {
+	const CellT* c = cell(atom, binding);
+	if (c && c->variable != INVALID_VARIABLE) return c->variable;
+
+	thread_local std::vector<object_id> arguments;
+	bind(atom, binding, arguments);
+	return _info.resolveStateVariable(atom.symbol, arguments);
+}
+
+bool
+EffectProgram::holds(const EffectT& effect, const State& state, const std::vector<object_id>& binding) const {
+	for (uint32_t i = effect.eq_begin; i < effect.eq_end; ++i) {
+		const EqualityT& eq = _equalities[i];
+		if ((value(eq.lhs, binding) == value(eq.rhs, binding)) == eq.negated) return false;
+	}
+
+	for (uint32_t i = effect.lit_begin; i < effect.lit_end; ++i) {
+		const LiteralT& lit = _literals[i];
+		if ((evaluate(_atoms[lit.atom], state, binding) == value(lit.value, binding)) == lit.negated) return false;
+	}
+	return true;
+}
+
+void
+EffectProgram::run(const State& state, const std::vector<object_id>& binding, std::vector<Atom>& atoms) const {
+	atoms.clear();
+	for (const EffectT& effect:_effects) {
+		if (!holds(effect, state, binding)) continue;
+		atoms.emplace_back(resolve(_atoms[effect.atom], binding), value(effect.value, binding));
+	}
+}
+
+} // namespaces
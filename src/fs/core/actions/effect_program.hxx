@@ -0,0 +1,158 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <fs/core/fs_types.hxx>
+#include <fs/core/actions/simple_lifted_operators.hxx>
+
+namespace fs0 {
+
+class Atom;
+class ProblemInfo;
+class State;
+
+//! A flat program that computes the effects of an action schema directly from a binding of the schema parameters.
+//! It gives the same changeset as grounding the schema into a GroundAction and evaluating its effects, but no
+//! formula is cloned or simplified and nothing is allocated.
+//! Each lifted atom f(t_1, ..., t_n) of the effects resolves through a dense table, indexed by the values that the
+//! binding gives to the parameters among t_1, ..., t_n. A table cell holds the state variable of a fluent atom, or the
+//! value of a static atom. Tables are shared by all lifted atoms, of any program, with the same symbol and the same
+//! constants at the same positions. Atoms whose tables would be too large, or would exceed the total number of cells
+//! allowed for all programs, are resolved through the fluent index of the problem instead, as SimpleLiftedOperator does.
+class EffectProgram {
+protected:
+	//! The resolution of a ground atom: either a state variable, or the value of a static atom.
+	//! If both are invalid, the atom could not be resolved at compilation time.
+	struct CellT {
+		VariableIdx variable;
+		object_id value;
+	};
+
+	using TableT = std::vector<CellT>;
+
+public:
+	//! The maximum number of cells of the table of a single lifted atom
+	static const std::size_t MAX_TABLE_SIZE = 1u << 20;
+
+	//! The default maximum number of cells of all the tables of a TableStore
+	static const std::size_t MAX_TOTAL_CELLS = 1u << 22;
+
+	//! The tables built while compiling the programs of a model, so that programs can share them.
+	//! Only needed during compilation: programs keep their own references to the tables they use.
+	class TableStore {
+	public:
+		explicit TableStore(std::size_t max_cells = MAX_TOTAL_CELLS) : _budget(max_cells), _num_cells(0), _tables() {}
+
+		//! The total number of cells of the tables built so far
+		std::size_t num_cells() const { return _num_cells; }
+
+	protected:
+		friend class EffectProgram;
+
+		//! A lifted atom is identified by its symbol and its arguments, where parameters are given as invalid objects
+		using KeyT = std::pair<unsigned, std::vector<object_id>>;
+
+		std::size_t _budget;
+		std::size_t _num_cells;
+		std::map<KeyT, std::shared_ptr<const TableT>> _tables;
+	};
+
+	//! Compile the effects of the given lifted operator; the null operator yields an empty program
+	EffectProgram(const SimpleLiftedOperator& op, const ProblemInfo& info, TableStore& tables);
+
+	//! Write into 'atoms' the atoms that the action with the given binding makes true in the given state.
+	//! As with 'evaluate_simple_lifted_operator', the precondition of the action is not checked.
+	void run(const State& state, const std::vector<object_id>& binding, std::vector<Atom>& atoms) const;
+
+protected:
+	static constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+
+	//! Either the value of the parameter with index 'slot' in the binding, or a constant if 'slot' is NONE
+	struct OperandT {
+		uint32_t slot;
+		object_id constant;
+	};
+
+	//! An argument of a lifted atom. If the atom has a table, 'positions' is the index in '_positions' of the map from
+	//! the values of the parameter into their position in its domain, and 'stride' the stride of the parameter in the table
+	struct ArgumentT {
+		OperandT operand;
+		uint32_t positions;
+		uint32_t stride;
+	};
+
+	//! A lifted atom, with arguments '_arguments[begin, end)', and table '_tables[table]', if any
+	struct AtomT {
+		unsigned symbol;
+		uint32_t begin;
+		uint32_t end;
+		uint32_t table;
+	};
+
+	//! (In-)equalities between operands, and literals 'atom = value' / 'atom != value'
+	struct EqualityT {
+		OperandT lhs;
+		OperandT rhs;
+		bool negated;
+	};
+
+	struct LiteralT {
+		uint32_t atom;
+		OperandT value;
+		bool negated;
+	};
+
+	//! An effect 'atom := value', conditional on the equalities '_equalities[eq_begin, eq_end)' and literals '_literals[lit_begin, lit_end)'
+	struct EffectT {
+		uint32_t eq_begin, eq_end;
+		uint32_t lit_begin, lit_end;
+		uint32_t atom;
+		OperandT value;
+	};
+
+	const ProblemInfo& _info;
+
+	std::vector<EffectT> _effects;
+	std::vector<EqualityT> _equalities;
+	std::vector<LiteralT> _literals;
+	std::vector<AtomT> _atoms;
+	std::vector<ArgumentT> _arguments;
+
+	//! The (possibly shared) tables of the lifted atoms
+	std::vector<std::shared_ptr<const TableT>> _tables;
+
+	//! _positions[i][v] is the position of the object with value 'v' in the domain of some type, or NONE
+	std::vector<std::vector<uint32_t>> _positions;
+	std::vector<TypeIdx> _position_types;
+
+	OperandT compile_operand(const SimpleLiftedOperator::simple_term& term) const;
+	uint32_t compile_atom(unsigned symbol, const std::vector<SimpleLiftedOperator::simple_term>& arguments, TableStore& tables);
+	void compile_condition(const SimpleLiftedOperator::condition_t& condition, EffectT& effect, TableStore& tables);
+	uint32_t compile_table(AtomT& atom, TableStore& tables);
+
+	//! Build the table of the given atom, with the given number of cells
+	std::shared_ptr<const TableT> build_table(const AtomT& atom, std::size_t size) const;
+	uint32_t positions(TypeIdx type);
+
+	static object_id value(const OperandT& operand, const std::vector<object_id>& binding) {
+		return operand.slot == NONE ? operand.constant : binding[operand.slot];
+	}
+
+	//! The table cell of the given atom under the given binding, or nullptr if there is none
+	const CellT* cell(const AtomT& atom, const std::vector<object_id>& binding) const;
+
+	//! The value of the given atom, and the state variable of the given fluent atom
+	object_id evaluate(const AtomT& atom, const State& state, const std::vector<object_id>& binding) const;
+	VariableIdx resolve(const AtomT& atom, const std::vector<object_id>& binding) const;
+
+	//! Bind the arguments of the given atom into the given (per-thread) buffer
+	void bind(const AtomT& atom, const std::vector<object_id>& binding, std::vector<object_id>& arguments) const;
+
+	bool holds(const EffectT& effect, const State& state, const std::vector<object_id>& binding) const;
+};
+
+} // namespaces
@@ -0,0 +1,94 @@
+
+#include <fs/core/actions/ground_action_store.hxx>
+#include <fs/core/actions/actions.hxx>
+#include <fs/core/languages/fstrips/language.hxx>
+
+
+namespace fs0 {
+
+//! Return the state variable and value of a 'X=v' atom, or of a 'X!=v' atom over a Boolean X, or false if the formula is none of those
+static bool
+unpack_atom(const fs::Formula* formula, VariableIdx& variable, object_id& value) {
+	const auto* relational = dynamic_cast<const fs::RelationalFormula*>(formula);
+	if (!relational) return false;
+	bool eq = dynamic_cast<const fs::EQAtomicFormula*>(formula) != nullptr;
+	bool neq = dynamic_cast<const fs::NEQAtomicFormula*>(formula) != nullptr;
+	if (!eq && !neq) return false;
+
+	const auto* sv = dynamic_cast<const fs::StateVariable*>(relational->lhs());
+	const auto* c = dynamic_cast<const fs::Constant*>(relational->rhs());
+	if (!sv || !c) return false;
+
+	variable = sv->getValue();
+	value = c->getValue();
+	if (neq) {
+		if (o_type(value) != type_id::bool_t) return false; // The constant has the type of X
+		value = make_object(!fs0::value<bool>(value));
+	}
+	return true;
+}
+
+bool
+GroundActionStore::add_atoms(const GroundAction& action) {
+	if (action.getActionData().hasProceduralEffects()) return false;
+
+	VariableIdx variable;
+	object_id value;
+
+	const fs::Formula* precondition = action.getPrecondition();
+	if (!precondition->is_tautology()) {
+		const auto* conjunction = dynamic_cast<const fs::Conjunction*>(precondition);
+		if (conjunction) {
+			for (const fs::Formula* conjunct:conjunction->getSubformulae()) {
+				if (!unpack_atom(conjunct, variable, value)) return false;
+				_pre_variables.push_back(variable);
+				_pre_values.push_back(value);
+			}
+		} else {
+			if (!unpack_atom(precondition, variable, value)) return false;
+			_pre_variables.push_back(variable);
+			_pre_values.push_back(value);
+		}
+	}
+
+	for (const fs::ActionEffect* effect:action.getEffects()) {
+		if (!effect->condition()->is_tautology()) return false;
+		const auto* sv = dynamic_cast<const fs::StateVariable*>(effect->lhs());
+		const auto* c = dynamic_cast<const fs::Constant*>(effect->rhs());
+		if (!sv || !c) return false;
+		_eff_variables.push_back(sv->getValue());
+		_eff_values.push_back(c->getValue());
+	}
+	return true;
+}
+
+bool
+GroundActionStore::add(const GroundAction& action) {
+	assert(action.getId() == size());
+	bool strips = add_atoms(action);
+	if (!strips) { // Undo the atoms that were added before noticing
+		_pre_variables.resize(_pre_offsets.back());
+		_pre_values.resize(_pre_offsets.back());
+		_eff_variables.resize(_eff_offsets.back());
+		_eff_values.resize(_eff_offsets.back());
+	}
+
+	_strips.push_back(strips);
+	_pre_offsets.push_back(_pre_variables.size());
+	_eff_offsets.push_back(_eff_variables.size());
+	if (strips) ++_num_strips;
+	return strips;
+}
+
+void
+GroundActionStore::shrink_to_fit() {
+	_strips.shrink_to_fit();
+	_pre_offsets.shrink_to_fit();
+	_pre_variables.shrink_to_fit();
+	_pre_values.shrink_to_fit();
+	_eff_offsets.shrink_to_fit();
+	_eff_variables.shrink_to_fit();
+	_eff_values.shrink_to_fit();
+}
+
+} // namespaces
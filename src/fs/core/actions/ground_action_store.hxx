@@ -0,0 +1,63 @@
+#pragma once
+
+#include <vector>
+
+#include <fs/core/fs_types.hxx>
+
+namespace fs0 {
+
+class GroundAction;
+
+//! A compact, structure-of-arrays store of the ground actions of a problem that are in STRIPS form. An action is in
+//! STRIPS form when its precondition is a conjunction of atoms X=v (or X!=v, with X Boolean) and all of its effects
+//! are unconditional assignments X:=v of constant values to state variables.
+//! The variables and values of the precondition atoms of all actions are stored in two shared arrays, and the
+//! atoms of action 'a' are the elements in the range [pre_begin(a), pre_end(a)) of these arrays; likewise for effects.
+//! Actions that are not in STRIPS form are also given an (empty) entry, so that entries are indexed by action ID.
+class GroundActionStore {
+public:
+	GroundActionStore() : _pre_offsets{0}, _eff_offsets{0}, _num_strips(0) {}
+
+	//! Append the given action, whose ID must be the number of actions already in the store.
+	//! Return true iff the action is in STRIPS form.
+	bool add(const GroundAction& action);
+
+	//! The number of actions in the store
+	std::size_t size() const { return _strips.size(); }
+
+	bool is_strips(ActionIdx action) const { return _strips[action]; }
+
+	//! Whether all of the actions are in STRIPS form
+	bool all_strips() const { return _num_strips == size(); }
+
+	std::size_t pre_begin(ActionIdx action) const { return _pre_offsets[action]; }
+	std::size_t pre_end(ActionIdx action) const { return _pre_offsets[action + 1]; }
+	VariableIdx pre_variable(std::size_t i) const { return _pre_variables[i]; }
+	const object_id& pre_value(std::size_t i) const { return _pre_values[i]; }
+
+	std::size_t eff_begin(ActionIdx action) const { return _eff_offsets[action]; }
+	std::size_t eff_end(ActionIdx action) const { return _eff_offsets[action + 1]; }
+	VariableIdx eff_variable(std::size_t i) const { return _eff_variables[i]; }
+	const object_id& eff_value(std::size_t i) const { return _eff_values[i]; }
+
+	//! Release the memory that was reserved in excess while adding actions
+	void shrink_to_fit();
+
+protected:
+	std::vector<bool> _strips;
+
+	std::vector<std::size_t> _pre_offsets;
+	std::vector<VariableIdx> _pre_variables;
+	std::vector<object_id> _pre_values;
+
+	std::vector<std::size_t> _eff_offsets;
+	std::vector<VariableIdx> _eff_variables;
+	std::vector<object_id> _eff_values;
+
+	std::size_t _num_strips;
+
+	//! Append the atoms of the given action to the arrays, returning false as soon as some of them is not in STRIPS form
+	bool add_atoms(const GroundAction& action);
+};
+
+} // namespaces
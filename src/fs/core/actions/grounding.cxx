@@ -1,4 +1,5 @@
 
+#include <fstream>
 #include <unordered_set>
 
 #include <lapkt/tools/logging.hxx>
@@ -6,11 +7,14 @@
 #include <fs/core/problem_info.hxx>
 #include <fs/core/actions/grounding.hxx>
 #include <fs/core/actions/actions.hxx>
+#include <fs/core/actions/ground_action_store.hxx>
 #include <fs/core/utils/printers/binding.hxx>
 #include <fs/core/utils/printers/actions.hxx>
 #include <fs/core/utils/config.hxx>
 #include <fs/core/utils/binding_iterator.hxx>
 #include <fs/core/utils/utils.hxx>
+#include <fs/core/utils/serializer.hxx>
+#include <fs/core/utils/thread_pool.hxx>
 #include <fs/core/languages/fstrips/language.hxx>
 #include <fs/core/languages/fstrips/operations.hxx>
 #include <boost/algorithm/string/join.hpp>
@@ -182,11 +186,202 @@ _loadGroundActionsIfAvailable(const ProblemInfo& info, const std::vector<const A
 	return grounded;
 }
 
+//! A filter that discards, before any formula gets bound, those bindings of a schema that violate some conjunct
+//! of its precondition that involves only static symbols, parameters and constants, e.g. 'adjacent(?from, ?to)' or '?x != ?y'.
+class StaticPreconditionFilter {
+public:
+	StaticPreconditionFilter(const ActionData& data, const ProblemInfo& info) {
+		const fs::Formula* precondition = data.getPrecondition();
+		const auto* conjunction = dynamic_cast<const fs::Conjunction*>(precondition);
+		if (conjunction) {
+			for (const fs::Formula* conjunct:conjunction->getSubformulae()) compile(conjunct, data.getSignature().size(), info);
+		} else {
+			compile(precondition, data.getSignature().size(), info);
+		}
+	}
+
+	//! Return false if the given parameter values make some of the compiled conjuncts false
+	bool accepts(const std::vector<object_id>& values) const {
+		thread_local std::vector<object_id> arguments;
+		for (const ConjunctT& conjunct:_conjuncts) {
+			object_id lhs;
+			if (conjunct.function) {
+				arguments.clear();
+				for (const OperandT& arg:conjunct.arguments) arguments.push_back(value(arg, values));
+				lhs = (*conjunct.function)(arguments);
+			} else {
+				lhs = value(conjunct.arguments[0], values);
+			}
+			if ((lhs == value(conjunct.value, values)) == conjunct.negated) return false;
+		}
+		return true;
+	}
+
+	std::size_t size() const { return _conjuncts.size(); }
+
+protected:
+	//! Either the parameter with index 'slot', or a constant if the slot is negative
+	struct OperandT {
+		int slot;
+		object_id constant;
+	};
+
+	//! Either 'f(arguments) = value', or 'arguments[0] = value', if there is no function, possibly negated
+	struct ConjunctT {
+		const Function* function;
+		std::vector<OperandT> arguments;
+		OperandT value;
+		bool negated;
+	};
+
+	std::vector<ConjunctT> _conjuncts;
+
+	static object_id value(const OperandT& operand, const std::vector<object_id>& values) {
+		return operand.slot < 0 ? operand.constant : values[operand.slot];
+	}
+
+	//! Compile the given term into an operand, if it is a parameter or a constant
+	static bool compile(const fs::Term* term, unsigned num_parameters, OperandT& operand) {
+		if (const auto* bv = dynamic_cast<const fs::BoundVariable*>(term)) {
+			if (bv->getVariableId() >= num_parameters) return false; // A quantified variable
+			operand = {(int) bv->getVariableId(), object_id::INVALID};
+			return true;
+		}
+		if (const auto* c = dynamic_cast<const fs::Constant*>(term)) {
+			operand = {-1, c->getValue()};
+			return true;
+		}
+		return false;
+	}
+
+	void compile(const fs::Formula* formula, unsigned num_parameters, const ProblemInfo& info) {
+		bool eq = dynamic_cast<const fs::EQAtomicFormula*>(formula) != nullptr;
+		bool neq = dynamic_cast<const fs::NEQAtomicFormula*>(formula) != nullptr;
+		if (!eq && !neq) return;
+		const auto* relational = dynamic_cast<const fs::RelationalFormula*>(formula);
+
+		ConjunctT conjunct{nullptr, {}, {-1, object_id::INVALID}, neq};
+		if (!compile(relational->rhs(), num_parameters, conjunct.value)) return;
+
+		OperandT operand{-1, object_id::INVALID};
+		if (compile(relational->lhs(), num_parameters, operand)) {
+			conjunct.arguments.push_back(operand);
+
+		} else if (const auto* term = dynamic_cast<const fs::StaticHeadedNestedTerm*>(relational->lhs())) {
+			const SymbolData& data = info.getSymbolData(term->getSymbolId());
+			if (!data.isStatic()) return;
+			for (const fs::Term* subterm:term->getSubterms()) {
+				if (!compile(subterm, num_parameters, operand)) return;
+				conjunct.arguments.push_back(operand);
+			}
+			conjunct.function = &data.getFunction();
+
+		} else {
+			return;
+		}
+		_conjuncts.push_back(std::move(conjunct));
+	}
+};
+
+//! The elements of a ground action, which are computed in parallel before the action is actually created
+struct BoundActionT {
+	Binding binding;
+	const fs::Formula* precondition;
+	std::vector<const fs::ActionEffect*> effects;
+};
+
+//! Bind the precondition and effects of the given schema with the given (complete) binding,
+//! and return false if the resulting action is detected to be statically non-applicable
+bool
+_bind_elements(const ActionData& action_data, Binding&& binding, const ProblemInfo& info, std::vector<BoundActionT>& bound) {
+	const fs::Formula* precondition = fs::bind(*action_data.getPrecondition(), binding, info);
+	if (precondition->is_contradiction()) {
+		delete precondition;
+		return false;
+	}
+
+	auto effects = ActionGrounder::bind_effects(action_data, binding, info);
+	if (effects.empty()) {
+		delete precondition;
+		return false;
+	}
+
+	bound.push_back(BoundActionT{std::move(binding), precondition, std::move(effects)});
+	return true;
+}
+
+//! Ground the given schema, with the given number of bindings, in parallel.
+//! The space of bindings is split into chunks of consecutive bindings, which are grounded in waves: all chunks of a wave
+//! are grounded in parallel into per-chunk buffers, and then the resulting actions are created in order of chunk, so that
+//! the IDs of the ground actions are the same as with a sequential grounding, and only the actions of a single wave
+//! need to be held in the buffers at any time.
+unsigned
+_ground_schema_in_parallel(unsigned id, const ActionData* data, unsigned long num_bindings, const ProblemInfo& info,
+                           ThreadPool& pool, std::vector<const GroundAction*>& grounded, GroundActionStore* store) {
+	const unsigned long CHUNK_SIZE = 1024;
+	const unsigned long WAVE_SIZE = 64 * pool.size();
+
+	const Signature& signature = data->getSignature();
+	std::vector<const std::vector<object_id>*> domains;
+	std::vector<bool> valid;
+	static const std::vector<object_id> NIL = {object_id::INVALID};
+	for (TypeIdx type:signature) {
+		domains.push_back(type == INVALID_TYPE ? &NIL : &info.getTypeObjects(type));
+		valid.push_back(type != INVALID_TYPE);
+	}
+
+	StaticPreconditionFilter filter(*data, info);
+	LPT_DEBUG("cout", "Schema '" << data->getName() << "': " << filter.size() << " precondition conjuncts can be checked before binding");
+
+	std::vector<std::vector<BoundActionT>> buffers;
+	const unsigned long num_chunks = (num_bindings + CHUNK_SIZE - 1) / CHUNK_SIZE;
+	for (unsigned long wave = 0; wave < num_chunks; wave += WAVE_SIZE) {
+		buffers.resize(std::min(WAVE_SIZE, num_chunks - wave));
+
+		pool.parallel_for(buffers.size(), [&](std::size_t i, unsigned) {
+			std::vector<BoundActionT>& buffer = buffers[i];
+			buffer.clear();
+			std::vector<object_id> values(signature.size());
+			const unsigned long begin = (wave + i) * CHUNK_SIZE, end = std::min(begin + CHUNK_SIZE, num_bindings);
+			for (unsigned long index = begin; index < end; ++index) {
+				// Decode the index into a binding, in the same order as the binding iterator, i.e. last parameter first
+				for (unsigned long rest = index, p = signature.size(); p-- > 0;) {
+					const auto& domain = *domains[p];
+					values[p] = domain[rest % domain.size()];
+					rest /= domain.size();
+				}
+				if (!filter.accepts(values)) continue;
+				_bind_elements(*data, Binding(values, valid), info, buffer);
+			}
+		});
+
+		for (auto& buffer:buffers) {
+			for (BoundActionT& elements:buffer) {
+				auto action = new GroundAction(id++, *data, elements.binding, elements.precondition, elements.effects);
+				LPT_EDEBUG("groundings", "\t" << *action);
+				if (store) store->add(*action);
+				grounded.push_back(action);
+			}
+			buffer.clear();
+		}
+	}
+	return id;
+}
+
 std::vector<const GroundAction*>
-_ground_all_elements(const std::vector<const ActionData*>& action_data, const ProblemInfo& info, bool bind_effects) {
+_ground_all_elements(const std::vector<const ActionData*>& action_data, const ProblemInfo& info, bool bind_effects, GroundActionStore* store) {
 	std::vector<const GroundAction*> grounded;
 
-	unsigned total_num_bindings = 0;
+	unsigned long total_num_bindings = 0;
+
+	ThreadPool pool(ThreadPool::num_workers(Config::instance(), "grounding.threads"));
+	LPT_INFO("grounding", "Grounding with " << pool.size() << " threads");
+
+	// Actions that are created sequentially are added to the store as they are created
+	auto add_to_store = [&](std::size_t from) {
+		if (!store) return;
+		for (std::size_t i = from; i < grounded.size(); ++i) store->add(*grounded[i]);
+	};
 
 	unsigned id = 0;
 	for (const ActionData* data:action_data) {
@@ -198,6 +393,7 @@ _ground_all_elements(const std::vector<const ActionData*>& action_data, const Pr
 			LPT_DEBUG("cout", "Grounding schema '" << data->getName() << "' with no binding");
 			LPT_INFO("grounding", "Grounding the following schema with no binding:" << *data << "\n");
 			id = _ground(id, data, Binding::EMPTY_BINDING, info, grounded, bind_effects);
+			add_to_store(grounded_0);
 			++total_num_bindings;
 			continue;
 		}
@@ -220,24 +416,20 @@ _ground_all_elements(const std::vector<const ActionData*>& action_data, const Pr
 			LPT_DEBUG("cout", "WARNING - The number of ground elements is too high: " << num_bindings);
 		}
 
-// 		float onepercent = ((float)num_bindings / 100);
-// 		int progress = 0;
-// 		unsigned i = 0;
-		for (; !binding_generator.ended(); ++binding_generator) {
-			id = _ground(id, data, *binding_generator, info, grounded, bind_effects);
-// 			++i;
-
-			// Print 5%, 10%, 15%, ... progress indicators
-			/*
-			 * NOTE This is too expensive for problems with many ground actions!
-			while (i / onepercent > progress) {
-				++progress;
-				if (progress % 5 == 0) std::cout << progress << "%, " << std::flush;
+		// Procedural effects are instantiated through the (non-reentrant) component registry, hence grounded sequentially.
+		// So are schemas whose effects are not bound, and schemas with an overflowing number of bindings.
+		if (bind_effects && !data->hasProceduralEffects() && num_bindings > 0) {
+			id = _ground_schema_in_parallel(id, data, num_bindings, info, pool, grounded, store);
+			total_num_bindings += num_bindings;
+
+		} else {
+			for (; !binding_generator.ended(); ++binding_generator) {
+				id = _ground(id, data, *binding_generator, info, grounded, bind_effects);
+				++total_num_bindings;
 			}
-			*/
-			++total_num_bindings;
+			add_to_store(grounded_0);
 		}
-// 		std::cout << std::endl;
+
 		LPT_INFO("grounding", "Schema \"" << print::action_data_name(*data) << "\" results in " << grounded.size() - grounded_0 << " grounded elements");
 		LPT_DEBUG("cout", "Schema \"" << print::action_data_name(*data) << "\" results in " << grounded.size() - grounded_0 << " grounded elements");
 	}
@@ -249,13 +441,19 @@ _ground_all_elements(const std::vector<const ActionData*>& action_data, const Pr
 }
 
 std::vector<const GroundAction*>
-ActionGrounder::fully_ground(const std::vector<const ActionData*>& action_data, const ProblemInfo& info) {
+ActionGrounder::fully_ground(const std::vector<const ActionData*>& action_data, const ProblemInfo& info, GroundActionStore* store) {
 	std::vector<const GroundAction*> grounded = _loadGroundActionsIfAvailable(info, action_data);
 	if (!grounded.empty()) { // A previous grounding was found, return it
+		if (store) {
+			for (const GroundAction* action:grounded) store->add(*action);
+			store->shrink_to_fit();
+		}
 		return grounded;
 	}
 
-	return _ground_all_elements(action_data, info, true);
+	grounded = _ground_all_elements(action_data, info, true, store);
+	if (store) store->shrink_to_fit();
+	return grounded;
 }
 
 
@@ -15,6 +15,7 @@ class ActionBase;
 class GroundAction;
 class Binding;
 class PartiallyGroundedAction;
+class GroundActionStore;
 
 //! This exception is thrown whenever a variable cannot be resolved
 class TooManyGroundActionsError : public std::runtime_error {
@@ -38,7 +39,9 @@ public:
 	//! Generate fully-lifted actions from the action schema data
 	static std::vector<const PartiallyGroundedAction*> fully_lifted(const std::vector<const ActionData*>& action_data, const ProblemInfo& info);
 	
-	static std::vector<const GroundAction*> fully_ground(const std::vector<const ActionData*>& action_data, const ProblemInfo& info);
+	//! Ground all action schemas. Schemas are grounded in parallel, with as many threads as given by the option 'grounding.threads'
+	//! (0, the default, meaning as many as hardware threads). If a store is given, all ground actions are also added to it.
+	static std::vector<const GroundAction*> fully_ground(const std::vector<const ActionData*>& action_data, const ProblemInfo& info, GroundActionStore* store = nullptr);
 	
 	static const std::vector<const fs::ActionEffect*> compile_nested_fluents_away(const fs::ActionEffect* effect, const ProblemInfo& info);
 	
@@ -3,6 +3,7 @@
 #include <fs/core/actions/sdd_action_iterator.hxx>
 #include <fs/core/actions/action_id.hxx>
 #include <fs/core/actions/actions.hxx>
+#include <fs/core/models/expansion_context.hxx>
 #include <fs/core/languages/fstrips/formulae.hxx>
 #include <fs/core/utils/atom_index.hxx>
 #include <sdd/sddapi.hxx>
@@ -11,13 +12,16 @@
 
 namespace fs0 {
 
-    SDDActionIterator::SDDActionIterator(const State& state, const std::vector<std::shared_ptr<ActionSchemaSDD>>& sdds, const AtomIndex& tuple_index) :
-            state_(state), sdds_(sdds)
-    {}
+    SDDActionIterator::SDDActionIterator(const State& state, const std::vector<std::shared_ptr<ActionSchemaSDD>>& sdds, const AtomIndex& tuple_index, ExpansionContext& context) :
+            state_(state), sdds_(sdds), context_(context)
+    {
+        if (context_.sdd_conditionings().size() < sdds_.size()) context_.sdd_conditionings().resize(sdds_.size());
+    }
 
-    SDDActionIterator::Iterator::Iterator(const State& state, const std::vector<std::shared_ptr<ActionSchemaSDD>>& sdds, unsigned currentIdx) :
+    SDDActionIterator::Iterator::Iterator(const State& state, const std::vector<std::shared_ptr<ActionSchemaSDD>>& sdds, ExpansionContext& context, unsigned currentIdx) :
             state_(state),
             sdds_(sdds),
+            context_(context),
             current_sdd_idx_(currentIdx),
             current_sdd_(nullptr),
             current_models_computed_(false),
@@ -38,8 +42,12 @@ namespace fs0 {
             if (!current_models_computed_) {
                 assert (current_resultset_.empty());
 
-                RecursiveModelEnumerator enumerator(schema_sdd.manager(), schema_sdd.collect_state_literals(state_));
-                current_resultset_ = enumerator.models(schema_sdd.node());
+                // Condition the SDD on the state first, so that the enumeration only explores nodes consistent with it
+                SddNode* conditioned = schema_sdd.condition_on(state_, context_.sdd_conditionings()[current_sdd_idx_]);
+                if (!sdd_node_is_false(conditioned)) {
+                    RecursiveModelEnumerator enumerator(schema_sdd.manager(), schema_sdd.collect_state_literals(state_));
+                    current_resultset_ = enumerator.models(conditioned, true);
+                }
 
 //              std::cout << current_resultset_.size() << " models were actually retrieved" << std::endl;
 
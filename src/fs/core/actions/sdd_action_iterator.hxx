@@ -10,6 +10,7 @@
 namespace fs0 {
 	class State;
 	class LiftedActionID;
+	class ExpansionContext;
 }
 
 namespace fs0::language::fstrips { class Formula; }
@@ -28,8 +29,11 @@ namespace fs0 {
 
         const std::vector<std::shared_ptr<ActionSchemaSDD>>& sdds_;
 
+        //! The context that keeps the conditionings of the SDDs
+        ExpansionContext& context_;
+
     public:
-        SDDActionIterator(const State& state, const std::vector<std::shared_ptr<ActionSchemaSDD>>& sdds, const AtomIndex& tuple_index);
+        SDDActionIterator(const State& state, const std::vector<std::shared_ptr<ActionSchemaSDD>>& sdds, const AtomIndex& tuple_index, ExpansionContext& context);
 
         class Iterator {
             friend class SDDActionIterator;
@@ -39,12 +43,14 @@ namespace fs0 {
             ~Iterator();
 
         protected:
-            Iterator(const State& state, const std::vector<std::shared_ptr<ActionSchemaSDD>>& sdds, unsigned currentIdx);
+            Iterator(const State& state, const std::vector<std::shared_ptr<ActionSchemaSDD>>& sdds, ExpansionContext& context, unsigned currentIdx);
 
             const State& state_;
 
             const std::vector<std::shared_ptr<ActionSchemaSDD>>& sdds_;
 
+            ExpansionContext& context_;
+
             unsigned current_sdd_idx_;
 
             SddNode* current_sdd_;
@@ -73,8 +79,8 @@ namespace fs0 {
             bool operator!=(const Iterator &other) const { return !(this->operator==(other)); }
         };
 
-        Iterator begin() const { return {state_, sdds_, 0}; }
-        Iterator end() const { return {state_, sdds_, (unsigned int) sdds_.size()}; }
+        Iterator begin() const { return {state_, sdds_, context_, 0}; }
+        Iterator end() const { return {state_, sdds_, context_, (unsigned int) sdds_.size()}; }
     };
 
 
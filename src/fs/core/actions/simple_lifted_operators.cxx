@@ -170,7 +170,7 @@ object_id evaluate_atom(
 
     // else it's a static atom, let's take its value from the static symbol-data index
     const auto& function = info.getSymbolData(predicate_id);
-    return function.getFunction()(args);
+    return function.evaluate(args);
 }
 
 bool evaluate_simple_condition(
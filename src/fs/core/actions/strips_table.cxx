@@ -0,0 +1,90 @@
+#include <algorithm>
+
+#include <fs/core/actions/strips_table.hxx>
+#include <fs/core/actions/ground_action_store.hxx>
+
+
+namespace fs0 {
+
+std::unique_ptr<StripsActionTable>
+StripsActionTable::create(const GroundActionStore& store, const StateAtomIndexer& indexer) {
+	std::unique_ptr<StripsActionTable> table(new StripsActionTable());
+	table->_pre_offsets.push_back(0);
+	table->_eff_offsets.push_back(0);
+	table->_atom_offsets.push_back(0);
+
+	for (ActionIdx action = 0; action < store.size(); ++action) {
+		bool covered = store.is_strips(action) && table->add(store, indexer, action);
+		table->_covered.push_back(covered);
+		if (covered) ++table->_num_covered;
+		table->_pre_offsets.push_back(table->_pre.size());
+		table->_eff_offsets.push_back(table->_eff.size());
+		table->_atom_offsets.push_back(table->_atoms.size());
+	}
+
+	if (table->_num_covered == 0) return nullptr;
+	return table;
+}
+
+//! Return a reference to the mask entry of the given word, appending it to 'entries' (from position 'begin' on) if not there yet
+template <typename EntryT>
+static EntryT&
+entry(std::vector<EntryT>& entries, std::size_t begin, unsigned word) {
+	for (std::size_t i = begin; i < entries.size(); ++i) {
+		if (entries[i].word == word) return entries[i];
+	}
+	entries.push_back(EntryT{word, 0, 0});
+	return entries.back();
+}
+
+bool
+StripsActionTable::add(const GroundActionStore& store, const StateAtomIndexer& indexer, ActionIdx action) {
+	for (std::size_t i = store.pre_begin(action); i < store.pre_end(action); ++i) {
+		if (!indexer.field(store.pre_variable(i)).predicative) return false;
+	}
+	for (std::size_t i = store.eff_begin(action); i < store.eff_end(action); ++i) {
+		if (!indexer.field(store.eff_variable(i)).predicative) return false;
+	}
+
+	const std::size_t pre_begin = _pre.size(), eff_begin = _eff.size();
+
+	for (std::size_t i = store.pre_begin(action); i < store.pre_end(action); ++i) {
+		const auto& field = indexer.field(store.pre_variable(i));
+		PreconditionT& pre = entry(_pre, pre_begin, field.word);
+		const WordT bit = WordT(1) << field.shift;
+		if (fs0::value<bool>(store.pre_value(i))) pre.positive |= bit;
+		else pre.negative |= bit;
+	}
+
+	// Effects are applied in order, as when applying their atoms, hence a later effect on some variable overrides an earlier one
+	for (std::size_t i = store.eff_begin(action); i < store.eff_end(action); ++i) {
+		const auto& field = indexer.field(store.eff_variable(i));
+		EffectT& eff = entry(_eff, eff_begin, field.word);
+		const WordT bit = WordT(1) << field.shift;
+		eff.mask |= bit;
+		if (fs0::value<bool>(store.eff_value(i))) eff.values |= bit;
+		else eff.values &= ~bit;
+		_atoms.emplace_back(store.eff_variable(i), store.eff_value(i));
+	}
+
+	// Visit the words in increasing order, which is friendlier to the cache
+	auto by_word = [](const auto& e1, const auto& e2) { return e1.word < e2.word; };
+	std::sort(_pre.begin() + pre_begin, _pre.end(), by_word);
+	std::sort(_eff.begin() + eff_begin, _eff.end(), by_word);
+	return true;
+}
+
+State
+StripsActionTable::next(ActionIdx action, const State& state, std::vector<Atom>& changeset) const {
+	assert(covers(action));
+	changeset.assign(_atoms.begin() + _atom_offsets[action], _atoms.begin() + _atom_offsets[action + 1]);
+
+	State successor(state);
+	for (unsigned i = _eff_offsets[action], end = _eff_offsets[action + 1]; i < end; ++i) {
+		const EffectT& eff = _eff[i];
+		successor.update_bits(eff.word, eff.mask, eff.values);
+	}
+	return successor;
+}
+
+} // namespaces
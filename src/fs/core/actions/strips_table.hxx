@@ -0,0 +1,81 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <fs/core/fs_types.hxx>
+#include <fs/core/atom.hxx>
+#include <fs/core/state.hxx>
+
+namespace fs0 {
+
+class GroundActionStore;
+
+//! A bit-level form of the STRIPS actions of a problem whose atoms are all over predicative state variables,
+//! which are stored one bit each in the packed representation of the state (see StateAtomIndexer).
+//! The precondition of each such action is compiled into a pair of masks for each of the words of the state it
+//! touches, one with the bits that must be set and one with those that must be clear, so that applicability is checked
+//! with a couple of word-wise operations per word; likewise, its effects are compiled into a mask of the bits
+//! that the action changes plus their new values, which are written directly onto the words of the successor state.
+//! Actions that are not covered (e.g. not in STRIPS form, or over multivalued variables) must be dealt with
+//! through their formulas, as usual.
+class StripsActionTable {
+public:
+	using WordT = State::WordT;
+
+	//! Return a table for the actions of the given store, or nullptr if none of them can be covered
+	static std::unique_ptr<StripsActionTable> create(const GroundActionStore& store, const StateAtomIndexer& indexer);
+
+	//! The number of actions covered by the table
+	std::size_t num_covered() const { return _num_covered; }
+
+	bool covers(ActionIdx action) const { return action < _covered.size() && _covered[action]; }
+
+	//! Return true iff the precondition of the given (covered) action holds in the given state
+	bool applicable(ActionIdx action, const State& state) const {
+		const WordT* words = state.words();
+		for (unsigned i = _pre_offsets[action], end = _pre_offsets[action + 1]; i < end; ++i) {
+			const PreconditionT& pre = _pre[i];
+			const WordT w = words[pre.word];
+			if (((w & pre.positive) ^ pre.positive) | (w & pre.negative)) return false;
+		}
+		return true;
+	}
+
+	//! Return the successor of the given state through the given (covered) action, leaving in 'changeset' the effects of the action
+	State next(ActionIdx action, const State& state, std::vector<Atom>& changeset) const;
+
+protected:
+	StripsActionTable() = default;
+
+	struct PreconditionT {
+		unsigned word;
+		WordT positive; // The bits that must be set
+		WordT negative; // The bits that must be clear
+	};
+
+	struct EffectT {
+		unsigned word;
+		WordT mask; // The bits changed by the action
+		WordT values; // Their new values
+	};
+
+	std::vector<bool> _covered;
+	std::size_t _num_covered = 0;
+
+	//! The masks of action 'a' are those in the range [_pre_offsets[a], _pre_offsets[a+1]) of '_pre'; likewise for effects
+	std::vector<unsigned> _pre_offsets;
+	std::vector<PreconditionT> _pre;
+
+	std::vector<unsigned> _eff_offsets;
+	std::vector<EffectT> _eff;
+
+	//! The effects of each action as atoms, for clients that need the changeset of the last applied action
+	std::vector<unsigned> _atom_offsets;
+	std::vector<Atom> _atoms;
+
+	//! Add the masks of the given action, if it can be covered, and return whether it was
+	bool add(const GroundActionStore& store, const StateAtomIndexer& indexer, ActionIdx action);
+};
+
+} // namespaces
@@ -8,6 +8,7 @@
 
 #include <fs/core/applicability/action_managers.hxx>
 #include <fs/core/actions/actions.hxx>
+#include <fs/core/actions/strips_table.hxx>
 #include <fs/core/state.hxx>
 #include <fs/core/problem_info.hxx>
 #include <fs/core/utils/atom_index.hxx>
@@ -24,7 +25,7 @@ NaiveApplicabilityManager::NaiveApplicabilityManager(const std::vector<const fs:
 //! An action is applicable iff its preconditions hold and its application does not violate any state constraint.
 bool NaiveApplicabilityManager::isApplicable(const State& state, const GroundAction& action, bool enforce_state_constraints) const {
     if (!action.isControl()) return false;
-	if (!checkFormulaHolds(action.getPrecondition(), state)) return false;
+	if (!action.getPreconditionProgram().satisfied(state)) return false;
 
     if (enforce_state_constraints && !_state_constraints.empty()) { // If we have no constraints, we can spare the cost of creating the new state.
 		auto atoms = computeEffects(state, action);
@@ -56,7 +57,8 @@ computeEffects(const State& state, const std::vector<const fs::ActionEffect*>& e
     for (const fs::ActionEffect* effect:effects) {
         if (effect->applicable(state)) {
             atoms.emplace_back(effect->apply(state));
-            assert(ProblemInfo::getInstance().checkValueIsValid(atoms.back().getVariable(), atoms.back().getValue()));  // A safety check - perhaps introduces some overhead
+            // A safety check. Values out of the domain of (object and Boolean) variables are rejected by the state itself.
+            assert(state.indexer().field(atoms.back().getVariable()).type == o_type(atoms.back().getValue()));
         }
     }
 }
@@ -354,6 +356,7 @@ _process_state_constraints(const fs::Formula* state_constraints) {
 
 NaiveActionManager::NaiveActionManager(const std::vector<const GroundAction*>& actions, const std::vector<const fs::Formula*>& state_constraints) :
 	_actions(actions),
+	_strips(nullptr),
 	_state_constraints(state_constraints),
 	_all_actions_whitelist(_build_all_actions_whitelist(actions.size()))
 {}
@@ -361,11 +364,15 @@ NaiveActionManager::NaiveActionManager(const std::vector<const GroundAction*>& a
 bool
 NaiveActionManager::applicable(const State& state, const GroundAction& action, bool enforce_state_constraints) const {
     if (!action.isControl()) return false;
-	if (!NaiveApplicabilityManager::checkFormulaHolds(action.getPrecondition(), state)) return false;
+	if (_strips && _strips->covers(action.getId())) {
+		if (!_strips->applicable(action.getId(), state)) return false;
+	} else if (!action.getPreconditionProgram().satisfied(state)) return false;
 
 	if (enforce_state_constraints && !_state_constraints.empty()) { // If we have no constraints, we can spare the cost of further checks
-		NaiveApplicabilityManager::computeEffects(state, action, _effects_cache);
-		State next(state, _effects_cache);
+		// A per-thread buffer to avoid memory allocations, which keeps the manager usable from different threads
+		thread_local std::vector<Atom> effects;
+		NaiveApplicabilityManager::computeEffects(state, action, effects);
+		State next(state, effects);
 		return check_constraints(action.getId(), next);
 	}
 	return true;
@@ -15,6 +15,7 @@ class State;
 class GroundAction;
 class Atom;
 class AtomIndex;
+class StripsActionTable;
 
 
 //! A simple manager that only checks applicability of actions in a non-relaxed setting.
@@ -99,19 +100,23 @@ public:
 
 	const std::vector<const GroundAction*>& getAllActions() const override { return _actions; }
 
+	//! Check the preconditions of the actions covered by the given table (if not null) through the table,
+	//! rather than through their formulas. The table must outlive the manager.
+	void use_strips_table(const StripsActionTable* table) { _strips = table; }
+
 protected:
 	//! The set of all ground actions managed by this object
 	const std::vector<const GroundAction*>& _actions;
 
+	//! The bit-level form of the STRIPS actions, if any
+	const StripsActionTable* _strips;
+
 	//! The state constraints relevant to this object
 	const std::vector<const fs::Formula*>& _state_constraints;
 
 	//! A list <0,1, ..., num_actions>
 	const std::vector<ActionIdx> _all_actions_whitelist;
 
-	//! Optimization - A cache to hold the effects of the last-applied action and avoid memory allocations.
-	mutable std::vector<Atom> _effects_cache;
-
 
 protected:
 	//! Check whether any state constraint is violated in the given state, knowing the last-applied action
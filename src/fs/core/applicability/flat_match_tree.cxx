@@ -0,0 +1,95 @@
+
+#include <fs/core/applicability/flat_match_tree.hxx>
+#include <lapkt/tools/logging.hxx>
+
+
+namespace fs0 {
+
+FlatMatchTree::FlatMatchTree(const BaseNode& root, const StateAtomIndexer& indexer) :
+	_indexer(indexer), _nodes(), _edges(), _items()
+{
+	if (!indexer.is_fully_binary()) {
+		throw std::runtime_error("Flat Match Tree: Variable domains not binary.");
+	}
+	uint32_t index = root.flatten(*this);
+	_unused(index);
+	assert(index == 0 || index == NONE);
+	_nodes.shrink_to_fit();
+	_edges.shrink_to_fit();
+	_items.shrink_to_fit();
+}
+
+uint32_t
+FlatMatchTree::add_node(const std::vector<ActionIdx>& items) {
+	NodeT node;
+	node.begin = _items.size();
+	_items.insert(_items.end(), items.begin(), items.end());
+	node.end = _items.size();
+	node.word = node.shift = 0;
+	node.edges = node.default_child = NONE;
+	_nodes.push_back(node);
+	return _nodes.size() - 1;
+}
+
+void
+FlatMatchTree::set_switch(uint32_t index, VariableIdx pivot, const std::vector<uint32_t>& children, uint32_t default_child) {
+	const StateAtomIndexer::FieldT& field = _indexer.field(pivot);
+	assert(field.predicative && field.mask == 1);
+	assert(children.size() <= 2);
+
+	NodeT& node = _nodes[index];
+	node.word = field.word;
+	node.shift = field.shift;
+	node.edges = _edges.size();
+	node.default_child = default_child;
+
+	for (uint32_t value = 0; value < 2; ++value) {
+		_edges.push_back(value < children.size() ? children[value] : NONE);
+	}
+}
+
+void
+FlatMatchTree::generate_applicable_items(const State& state, std::vector<ActionIdx>& actions) const {
+	if (_nodes.empty()) return;
+
+	// A per-thread stack, so that different threads can walk the tree concurrently
+	thread_local std::vector<uint32_t> stack;
+	stack.clear();
+	stack.push_back(0);
+
+	const WordT* words = state.words();
+	while (!stack.empty()) {
+		const NodeT& node = _nodes[stack.back()];
+		stack.pop_back();
+
+		actions.insert(actions.end(), _items.begin() + node.begin, _items.begin() + node.end);
+		if (node.edges == NONE) continue; // A leaf
+
+		// The default child is pushed first, so that the matching child is fully explored before it, as in the pointer-based tree
+		if (node.default_child != NONE) stack.push_back(node.default_child);
+		const uint32_t child = _edges[node.edges + ((words[node.word] >> node.shift) & 1)];
+		if (child != NONE) stack.push_back(child);
+	}
+}
+
+
+FlatMatchTreeActionManager::FlatMatchTreeActionManager(const std::vector<const GroundAction*>& actions,
+                                                       const std::vector<const fs::Formula*>& state_constraints,
+                                                       const AtomIndex& tuple_idx, const StateAtomIndexer& indexer) :
+	MatchTreeActionManager(actions, state_constraints, tuple_idx),
+	_flat(*_tree, indexer)
+{
+	// The pointer-based tree is no longer needed
+	delete _tree;
+	_tree = nullptr;
+	LPT_DEBUG("cout", "Flat Match Tree created with " << _flat.count_nodes() << " nodes");
+}
+
+std::vector<ActionIdx>
+FlatMatchTreeActionManager::compute_whitelist(const State& state) const {
+	std::vector<ActionIdx> result;
+	_flat.generate_applicable_items(state, result);
+	return result;
+}
+
+} // namespaces
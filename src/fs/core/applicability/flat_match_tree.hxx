@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <fs/core/fs_types.hxx>
+#include <fs/core/state.hxx>
+#include <fs/core/applicability/match_tree.hxx>
+
+
+namespace fs0 {
+
+//! A compiled, read-only version of a match tree, where all nodes are laid out in pre-order in a single
+//! contiguous array. Children are referred to by their index in that array, and the actions of each node
+//! are a range of a single, shared array of actions. The tree is walked iteratively, with an explicit stack,
+//! and the value of each pivot variable is read straight from the packed representation of the state.
+//! As the pointer-based match tree, it only supports fully binary states, i.e. every pivot is a single bit.
+//! Each walk yields exactly the same actions, in the same order, as the pointer-based tree it is compiled from.
+class FlatMatchTree {
+public:
+	using WordT = StateAtomIndexer::WordT;
+
+	//! The index that denotes an empty subtree
+	static constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+
+	//! Compile the tree rooted at the given node, for states with the layout given by the indexer
+	FlatMatchTree(const BaseNode& root, const StateAtomIndexer& indexer);
+
+	//! Append to 'actions' the indexes of all actions whose preconditions are satisfied by the given state
+	void generate_applicable_items(const State& state, std::vector<ActionIdx>& actions) const;
+
+	//! The total number of actions in the tree
+	unsigned count() const { return _items.size(); }
+
+	//! The total number of (non-empty) nodes of the tree
+	unsigned count_nodes() const { return _nodes.size(); }
+
+	//! Construction interface, meant to be used by the nodes of the pointer-based tree.
+	//! Add a new node that makes applicable the given actions, and return its index
+	uint32_t add_node(const std::vector<ActionIdx>& items);
+
+	//! Turn the given node into a switch on the given (predicative) variable, where 'children[v]' is the index of the subtree
+	//! to be explored if the pivot variable takes value 'v' (0 or 1), and 'default_child' the index of the subtree to be always explored
+	void set_switch(uint32_t node, VariableIdx pivot, const std::vector<uint32_t>& children, uint32_t default_child);
+
+protected:
+	struct NodeT {
+		//! The range [begin, end) of '_items' with the actions that the node makes applicable
+		uint32_t begin;
+		uint32_t end;
+
+		//! The word and offset in the state of the bit of the pivot variable
+		uint32_t word;
+		uint32_t shift;
+
+		//! The offset in '_edges' of the two children of the node, indexed by the value of the pivot variable,
+		//! or NONE if the node is a leaf
+		uint32_t edges;
+
+		//! The child to be explored regardless of the value of the pivot variable
+		uint32_t default_child;
+	};
+
+	const StateAtomIndexer& _indexer;
+
+	std::vector<NodeT> _nodes;
+	std::vector<uint32_t> _edges;
+	std::vector<ActionIdx> _items;
+};
+
+
+//! A match-tree action manager that walks the flat version of the match tree
+class FlatMatchTreeActionManager : public MatchTreeActionManager {
+public:
+	FlatMatchTreeActionManager(const std::vector<const GroundAction*>& actions, const std::vector<const fs::Formula*>& state_constraints,
+	                           const AtomIndex& tuple_idx, const StateAtomIndexer& indexer);
+
+	FlatMatchTreeActionManager(const FlatMatchTreeActionManager&) = delete;
+
+	unsigned count() const { return _flat.count(); }
+
+protected:
+	FlatMatchTree _flat;
+
+	std::vector<ActionIdx> compute_whitelist(const State& state) const override;
+};
+
+} // namespaces
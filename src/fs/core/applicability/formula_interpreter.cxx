@@ -37,7 +37,7 @@ FormulaInterpreter::FormulaInterpreter(const FormulaInterpreter& other) :
 
 
 bool DirectFormulaInterpreter::satisfied(const State& state) const {
-	return _formula->interpret(state);
+	return _program.satisfied(state);
 }
 
 CSPFormulaInterpreter::CSPFormulaInterpreter(const fs::Formula* formula, const AtomIndex& tuple_index) :
@@ -2,6 +2,7 @@
 #pragma once
 
 #include <fs/core/languages/fstrips/language_fwd.hxx>
+#include <fs/core/languages/fstrips/bytecode.hxx>
 
 #include <memory>
 
@@ -34,17 +35,21 @@ protected:
 };
 
 
-//! A satisfiability manager that models formula satisfaction as a CSP in order to determine whether a given formula is satisfiable or not.
+//! A satisfiability manager that checks the formula directly on the state, through a compiled program
 class DirectFormulaInterpreter : public FormulaInterpreter {
 public:
-	DirectFormulaInterpreter(const fs::Formula* formula) : FormulaInterpreter(formula) {}
+	DirectFormulaInterpreter(const fs::Formula* formula) : FormulaInterpreter(formula), _program(_formula) {}
 	~DirectFormulaInterpreter() = default;
-	DirectFormulaInterpreter(const DirectFormulaInterpreter&) = default;
+	DirectFormulaInterpreter(const DirectFormulaInterpreter& other) : FormulaInterpreter(other), _program(_formula) {}
 
 	DirectFormulaInterpreter* clone() const { return new DirectFormulaInterpreter(*this); }
 	
 	//! Returns true if the formula represented by the current object is satisfied in the given state
 	bool satisfied(const State& state) const;
+
+protected:
+	//! The formula compiled into a flat program, which refers to the (cloned) formula owned by this object
+	fs::FormulaProgram _program;
 };
 
 
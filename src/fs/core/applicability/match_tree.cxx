@@ -2,6 +2,7 @@
 #include <numeric>
 
 #include <fs/core/applicability/match_tree.hxx>
+#include <fs/core/applicability/flat_match_tree.hxx>
 #include <algorithm>
 #include <lapkt/tools/logging.hxx>
 #include <fs/core/problem_info.hxx>
@@ -208,6 +209,26 @@ namespace fs0 {
         }
     }
 
+    uint32_t EmptyNode::flatten(FlatMatchTree& tree) const {
+		return FlatMatchTree::NONE;
+	}
+
+    uint32_t LeafNode::flatten(FlatMatchTree& tree) const {
+		return tree.add_node(_applicable_items);
+	}
+
+    uint32_t SwitchNode::flatten(FlatMatchTree& tree) const {
+		// Nodes are laid out in pre-order, i.e. in the order in which they are (most likely) visited
+		uint32_t node = tree.add_node(_immediate_items);
+		std::vector<uint32_t> children;
+		for (const auto child:_children) {
+			children.push_back(child->flatten(tree));
+		}
+		uint32_t default_child = _default_child->flatten(tree);
+		tree.set_switch(node, _pivot, children, default_child);
+		return node;
+	}
+
     MatchTreeActionManager::MatchTreeActionManager( const std::vector<const GroundAction*>& actions,
                                                     const std::vector<const fs::Formula*>& state_constraints,
                                                     const AtomIndex& tuple_idx)
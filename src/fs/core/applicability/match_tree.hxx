@@ -23,12 +23,13 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #pragma once
 
+#include <cstdint>
 #include <unordered_set>
 #include <fs/core/fs_types.hxx>
 #include <fs/core/applicability/action_managers.hxx>
 
 
-namespace fs0 {	class ProblemInfo; class MatchTreeActionManager;}
+namespace fs0 {	class ProblemInfo; class MatchTreeActionManager; class FlatMatchTree; }
 
 namespace fs0 { namespace language { namespace fstrips { class Formula; class AtomicFormula; } }}
 namespace fs = fs0::language::fstrips;
@@ -66,6 +67,9 @@ public:
 		virtual void count_nodes(unsigned& sw, unsigned& leaf, unsigned& empty) const = 0;
         virtual void print( std::stringstream& stream, std::string indent, const MatchTreeActionManager& manager ) const = 0;
 
+		//! Append the subtree rooted at this node to the given flat tree, and return the index of its root there
+		virtual uint32_t flatten(FlatMatchTree& tree) const = 0;
+
     	static BaseNode::ptr
         create_tree(std::vector<ActionIdx>&& actions, NodeCreationContext& context);
 
@@ -94,6 +98,7 @@ public:
 		void count_nodes(unsigned& sw, unsigned& leaf, unsigned& empty) const override;
 
         void print(std::stringstream& stream, std::string indent, const MatchTreeActionManager& manager) const override;
+		uint32_t flatten(FlatMatchTree& tree) const override;
     };
 
 
@@ -106,6 +111,7 @@ public:
     	unsigned count_nodes() const override { return 1; }
     	void count_nodes(unsigned& sw, unsigned& leaf, unsigned& empty) const override { ++leaf; }
         void print(std::stringstream& stream, std::string indent, const MatchTreeActionManager& manager) const override;
+		uint32_t flatten(FlatMatchTree& tree) const override;
     };
 
 
@@ -116,6 +122,7 @@ public:
     	unsigned count_nodes() const override { return 1; }
     	void count_nodes(unsigned& sw, unsigned& leaf, unsigned& empty) const override { ++empty; }
         void print(std::stringstream& stream, std::string indent, const MatchTreeActionManager& manager) const override;
+		uint32_t flatten(FlatMatchTree& tree) const override;
     };
 
 
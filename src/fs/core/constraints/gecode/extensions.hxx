@@ -61,6 +61,9 @@ public:
 	std::vector<Gecode::TupleSet> generate_extensions() const;
 	
 	Gecode::TupleSet generate_extension(unsigned symbol_id) const;
+	
+	//! Whether the extension of the given symbol is managed by this handler
+	bool is_managed(unsigned symbol_id) const { return _managed.at(symbol_id); }
 };
 
 
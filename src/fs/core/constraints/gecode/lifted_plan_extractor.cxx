@@ -41,14 +41,12 @@ void LiftedPlanExtractor::processTuple(AtomIdx tuple, std::vector<Atom>& relevan
 	if (_graph.getSeed().contains(atom)) return; // The atom was already on the seed state, thus has empty support.
 	if (processed.find(tuple) != processed.end()) return; // The atom has already been processed
 	
-	const RPGIndex::TupleSupport& support = _graph.getTupleSupport(tuple);
-	
-	const ActionID* action_id = std::get<1>(support);
+	const ActionID* action_id = _graph.get_achiever(tuple);
 	assert(action_id);
-	unsigned layer_idx = std::get<0>(support);
-// 	std::cout << "Inserting: " << *action_id << " on layer #" << std::get<0>(support) << ", support size: " << std::get<2>(support).size() << std::endl;
+	unsigned layer_idx = _graph.get_layer(tuple);
+// 	std::cout << "Inserting: " << *action_id << " on layer #" << layer_idx << ", support size: " << _graph.get_support(tuple).size() << std::endl;
 	perLayerSupporters[layer_idx].insert(action_id);
-	enqueueTuples(std::get<2>(support)); // Push the full support of the atom
+	for (AtomIdx supporter:_graph.get_support(tuple)) pending.push(supporter); // Push the full support of the atom
 	processed.insert(tuple); // Tag the atom as processed.
 	
 	// We store all those atoms that have been identified as supports of some action of the relaxed plan
@@ -7,6 +7,9 @@
 
 #include <lapkt/tools/logging.hxx>
 
+#include <algorithm>
+#include <atomic>
+
 
 namespace fs0::gecode::v2 {
 
@@ -95,11 +98,18 @@ SymbolExtensionGenerator::SymbolExtensionGenerator(
         const ProblemInfo& info,
         const AtomIndex& tuple_index,
         std::vector<unsigned> managed) :
-    managed(managed)
+    managed(managed),
+    variable_symbol(info.getNumVariables(), NO_SYMBOL)
 {
+    static std::atomic<unsigned long> next_id(0);
+    _id = ++next_id;
+
     for (unsigned s=0; s < managed.size(); ++s) {
         if ((bool) managed[s]) {
             individuals.emplace_back(s, info, tuple_index);
+            for (const auto& elem:individuals.back().fluent_tuples) {
+                variable_symbol.at(std::get<0>(elem)) = s;
+            }
         } else {
             // NOLINTNEXTLINE  (the nullary constructor is protected, hence cannot use emplace_back)
             individuals.push_back(IndividualSymbolExtensionGenerator());
@@ -107,7 +117,82 @@ SymbolExtensionGenerator::SymbolExtensionGenerator(
     }
 }
 
+//! The extensions last instantiated by some thread on a few states, along with a copy of the words of those states.
+//! Slots are shared by all generators, and tagged with the one that filled them.
+struct ExtensionCacheT {
+    static constexpr unsigned NUM_SLOTS = 4;
+
+    struct SlotT {
+        unsigned long generator = 0; // The ID of the generator that filled the slot, 0 meaning none.
+        const StateAtomIndexer* indexer = nullptr;
+        std::vector<StateAtomIndexer::WordT> words;
+        std::vector<Gecode::TupleSet> extensions;
+        unsigned long last_use = 0;
+    };
+
+    SlotT slots[NUM_SLOTS];
+    unsigned long clock = 0;
+
+    //! Scratch buffers
+    std::vector<VariableIdx> changed;
+    std::vector<bool> dirty;
+};
+
 std::vector<Gecode::TupleSet> SymbolExtensionGenerator::instantiate(const State& state) const {
+    using SlotT = ExtensionCacheT::SlotT;
+    thread_local ExtensionCacheT cache;
+
+    const StateAtomIndexer& indexer = state.indexer();
+    const auto* words = state.words();
+    ++cache.clock;
+
+    // The slot of this generator with the state closest to the given one, if any
+    SlotT* base = nullptr;
+    std::size_t base_changes = std::numeric_limits<std::size_t>::max();
+    for (SlotT& slot:cache.slots) {
+        if (slot.generator != _id || slot.indexer != &indexer) continue;
+        cache.changed.clear();
+        indexer.diff(slot.words.data(), words, cache.changed);
+        if (cache.changed.size() < base_changes) {
+            base = &slot;
+            base_changes = cache.changed.size();
+        }
+    }
+
+    if (base && base_changes == 0) {
+        base->last_use = cache.clock;
+        return base->extensions;
+    }
+
+    // The least recently used slot other than the base one is overwritten with the extensions of the new state
+    SlotT* target = nullptr;
+    for (SlotT& slot:cache.slots) {
+        if (&slot != base && (!target || slot.last_use < target->last_use)) target = &slot;
+    }
+
+    if (!base) {
+        target->extensions = instantiate_from_scratch(state);
+    } else {
+        target->extensions = base->extensions;
+        cache.changed.clear();
+        indexer.diff(base->words.data(), words, cache.changed);
+        cache.dirty.assign(managed.size(), false);
+        for (VariableIdx var:cache.changed) {
+            unsigned s = variable_symbol[var];
+            if (s == NO_SYMBOL || cache.dirty[s]) continue;
+            cache.dirty[s] = true;
+            target->extensions[s] = individuals[s].instantiate(state);
+        }
+    }
+
+    target->generator = _id;
+    target->indexer = &indexer;
+    target->words.assign(words, words + state.num_words());
+    target->last_use = cache.clock;
+    return target->extensions;
+}
+
+std::vector<Gecode::TupleSet> SymbolExtensionGenerator::instantiate_from_scratch(const State& state) const {
     std::vector<Gecode::TupleSet> result;
     result.reserve(managed.size());
 
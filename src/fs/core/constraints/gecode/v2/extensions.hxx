@@ -1,6 +1,9 @@
 
 #pragma once
 
+#include <limits>
+#include <vector>
+
 #include <fs/core/base.hxx>
 
 #include <gecode/int.hh>
@@ -28,6 +31,13 @@ class IndividualSymbolExtensionGenerator;
 //!
 //! Note that function extensions include the function codomain value, i.e. contain tuples of size equal to the arity
 //! of the function plus one.
+//!
+//! Since successive calls to `instantiate` usually take states that differ only in the few variables touched by some
+//! action (e.g. a parent and its children, or two siblings), each thread keeps the extensions of the last few states it
+//! instantiated, and builds those of a new state from the closest of them, rebuilding only the extensions of those symbols
+//! affected by some variable whose value changed. Keeping several states means that instantiating a child does not evict
+//! its parent, from which its siblings will be built next. The extensions of the rest of symbols are shared, Gecode
+//! tuple sets being reference-counted handles.
 class SymbolExtensionGenerator {
 public:
     //! `managed[i]` denotes that we want to manage symbol with ID i.
@@ -38,8 +48,13 @@ public:
     SymbolExtensionGenerator& operator=(const SymbolExtensionGenerator&) = delete;
     SymbolExtensionGenerator& operator=(SymbolExtensionGenerator&&) = delete;
 
+    //! Return the extensions of all managed symbols on the given state, incrementally from those of the
+    //! closest of the last states instantiated by the calling thread
     std::vector<Gecode::TupleSet> instantiate(const State& state) const;
 
+    //! Return the extensions of all managed symbols on the given state, computed from scratch
+    std::vector<Gecode::TupleSet> instantiate_from_scratch(const State& state) const;
+
     Gecode::TupleSet retrieve_static_tupleset(unsigned symbol_id) const;
 
     //! Return whether the given symbol has no fluent tuples, meaning it can be evaluated statically
@@ -49,6 +64,15 @@ protected:
     std::vector<unsigned> managed;
 
     std::vector<IndividualSymbolExtensionGenerator> individuals;
+
+    //! variable_symbol[x] is the ID of the symbol whose extension depends on the value of state variable x, if any,
+    //! or NO_SYMBOL otherwise
+    std::vector<unsigned> variable_symbol;
+    static constexpr unsigned NO_SYMBOL = std::numeric_limits<unsigned>::max();
+
+    //! A unique ID used to tell apart the per-thread caches of different generators. Copies share the ID,
+    //! since they generate the very same extensions.
+    unsigned long _id;
 };
 
 //! While the above SymbolExtensionGenerator class takes care of all symbols in the problem, this class just takes
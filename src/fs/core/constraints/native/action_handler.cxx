@@ -140,7 +140,7 @@ NativeActionHandler::process(RPGIndex& graph) {
 
     for (auto achievable:_directly_achievable_tuples) {
         if (achievable != INVALID_TUPLE && !graph.reached(achievable)) {
-            graph.add(achievable, new PlainActionID(&_action), std::vector<AtomIdx>(base_support));
+            graph.add(achievable, new PlainActionID(&_action), base_support);
             num_novel_atoms++;
         }
     }
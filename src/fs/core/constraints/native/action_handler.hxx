@@ -23,6 +23,9 @@ public:
 
     bool check_reachable(const RPGIndex& graph, SupportT& support) const;
 
+    const std::vector<std::pair<VariableIdx, object_id>>& equality_atoms() const { return _equality_atoms; }
+    const std::vector<std::pair<VariableIdx, object_id>>& inequality_atoms() const { return _inequality_atoms; }
+
 protected:
     const AtomIndex& _tuple_index;
 
@@ -51,6 +54,13 @@ public:
 
 	const fs::Formula* get_precondition() const;
 
+	const GroundAction& get_action() const { return _action; }
+
+	const SimpleFormulaChecker& get_precondition_checker() const { return _precondition_checker; }
+
+	//! The atoms achieved by the effects of form X := c, and INVALID_TUPLE for each effect of form X := Y
+	const std::vector<AtomIdx>& get_achievable_tuples() const { return _directly_achievable_tuples; }
+
 	void process(RPGIndex& graph);
 
 protected:
@@ -0,0 +1,133 @@
+
+#include <fs/core/heuristics/heuristic_cache.hxx>
+#include <fs/core/state.hxx>
+#include <fs/core/atom.hxx>
+#include <fs/core/utils/config.hxx>
+#include <lapkt/tools/logging.hxx>
+
+
+namespace fs0 {
+
+HeuristicCache::HeuristicCache(std::size_t num_entries, std::size_t num_relevant) :
+	_entries(),
+	_mask(0),
+	_ring(),
+	_ring_mask(0),
+	_cursor(0)
+{
+	std::size_t size = 1;
+	while (size < num_entries) size <<= 1;
+	_entries.reset(new EntryT[size]);
+	_mask = size - 1;
+
+	for (std::size_t i = 0; i < size; ++i) {
+		EntryT& entry = _entries[i];
+		entry.version.store(0, std::memory_order_relaxed);
+		entry.size.store(NO_RELEVANT, std::memory_order_relaxed);
+		entry.fingerprint.store(0, std::memory_order_relaxed);
+		entry.h.store(0, std::memory_order_relaxed);
+		entry.offset.store(0, std::memory_order_relaxed);
+	}
+
+	std::size_t ring_size = 1;
+	while (ring_size < num_relevant) ring_size <<= 1;
+	_ring.reset(new std::atomic<uint64_t>[ring_size * ATOM_WORDS]);
+	_ring_mask = ring_size - 1;
+	for (std::size_t i = 0; i < ring_size * ATOM_WORDS; ++i) _ring[i].store(0, std::memory_order_relaxed);
+}
+
+std::unique_ptr<HeuristicCache>
+HeuristicCache::create(const Config& config) {
+	int mb = config.getOption<int>("heuristic_cache.mb", 64);
+	if (mb <= 0) return nullptr;
+	const std::size_t atom_bytes = ATOM_WORDS * sizeof(uint64_t);
+	std::size_t num_entries = (std::size_t(mb) << 20) / (sizeof(EntryT) + RELEVANT_PER_ENTRY * atom_bytes);
+	std::unique_ptr<HeuristicCache> cache(new HeuristicCache(num_entries, num_entries * RELEVANT_PER_ENTRY));
+	std::size_t bytes = cache->size() * sizeof(EntryT) + cache->ring_size() * atom_bytes;
+	LPT_INFO("cout", "Heuristic cache: " << cache->size() << " entries, " << cache->ring_size() << " relevant atoms (" << (bytes >> 20) << " MB)");
+	return cache;
+}
+
+uint64_t
+HeuristicCache::fingerprint(const State& state) {
+	const State::WordT* words = state.words();
+	uint64_t h = 0x243F6A8885A308D3ULL;
+	for (std::size_t i = 0, n = state.num_words(); i < n; ++i) {
+		h = (h ^ words[i]) * 0x9E3779B97F4A7C15ULL;
+		h ^= h >> 29;
+	}
+	return h | 1;
+}
+
+bool
+HeuristicCache::lookup(const State& state, long& h, std::vector<Atom>* relevant) const {
+	const EntryT& entry = _entries[state.hash() & _mask];
+
+	uint32_t version = entry.version.load(std::memory_order_acquire);
+	if (version & 1) return false; // The entry is being written
+
+	if (entry.fingerprint.load(std::memory_order_relaxed) != fingerprint(state)) return false;
+	long value = entry.h.load(std::memory_order_relaxed);
+	uint32_t size = entry.size.load(std::memory_order_relaxed);
+	uint64_t offset = entry.offset.load(std::memory_order_relaxed);
+	if (relevant && size == NO_RELEVANT) return false;
+
+	// Decoding the atoms involves no lookup that could fail on an atom that was being overwritten, hence we decode
+	// them right away, and discard them if it turns out that they were overwritten while we were reading them
+	std::size_t first = relevant ? relevant->size() : 0;
+	if (relevant) {
+		for (uint64_t i = offset; i < offset + size; ++i) {
+			std::size_t pos = (i & _ring_mask) * ATOM_WORDS;
+			uint64_t variable = _ring[pos].load(std::memory_order_relaxed);
+			uint64_t object = _ring[pos + 1].load(std::memory_order_relaxed);
+			relevant->emplace_back(VariableIdx(variable), make_object(type_id(object >> 32), uint32_t(object)));
+		}
+	}
+
+	// Make sure that neither the entry nor, if needed, its atoms were overwritten while we were reading them.
+	// An atom at position 'i' is only overwritten once the cursor has gone beyond 'i + ring_size()'.
+	std::atomic_thread_fence(std::memory_order_acquire);
+	bool valid = entry.version.load(std::memory_order_relaxed) == version;
+	if (valid && relevant && size > 0) valid = _cursor.load(std::memory_order_relaxed) <= offset + ring_size();
+	if (!valid) {
+		if (relevant) relevant->erase(relevant->begin() + first, relevant->end());
+		return false;
+	}
+
+	h = value;
+	return true;
+}
+
+void
+HeuristicCache::store(const State& state, long h, const std::vector<Atom>* relevant) {
+	EntryT& entry = _entries[state.hash() & _mask];
+
+	uint32_t version = entry.version.load(std::memory_order_relaxed);
+	if ((version & 1) || !entry.version.compare_exchange_strong(version, version + 1, std::memory_order_acquire)) {
+		return; // Some other thread is writing on the entry; it is only a cache, so we just give up
+	}
+	std::atomic_thread_fence(std::memory_order_release);
+
+	uint32_t size = NO_RELEVANT;
+	uint64_t offset = 0;
+	if (relevant && relevant->size() <= ring_size()) {
+		size = relevant->size();
+		offset = _cursor.fetch_add(size, std::memory_order_relaxed);
+		// Readers that see the atoms written below also see the cursor moved past them (see lookup)
+		std::atomic_thread_fence(std::memory_order_release);
+		for (unsigned i = 0; i < size; ++i) {
+			const Atom& atom = (*relevant)[i];
+			std::size_t pos = ((offset + i) & _ring_mask) * ATOM_WORDS;
+			_ring[pos].store(atom.getVariable(), std::memory_order_relaxed);
+			_ring[pos + 1].store((uint64_t(o_type(atom.getValue())) << 32) | atom.getValue().value(), std::memory_order_relaxed);
+		}
+	}
+	entry.size.store(size, std::memory_order_relaxed);
+	entry.offset.store(offset, std::memory_order_relaxed);
+	entry.h.store(h, std::memory_order_relaxed);
+	entry.fingerprint.store(fingerprint(state), std::memory_order_relaxed);
+
+	entry.version.store(version + 2, std::memory_order_release);
+}
+
+} // namespaces
@@ -0,0 +1,136 @@
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <fs/core/fs_types.hxx>
+
+namespace fs0 { class State; class Atom; class Config; }
+
+namespace fs0 {
+
+//! A bounded cache of heuristic values, shared by all evaluations of a search run (e.g. by the successive
+//! breadth-first searches of EHC and by the GBFS that might follow it). The cache is a direct-mapped table of
+//! fixed-size entries, indexed by the hash of the state, each of which stores an independent 64-bit fingerprint
+//! of the state and its heuristic value. The atoms of the first layer of its relaxed plan are kept out of line, in a
+//! ring buffer that all entries append to, and the entry only records where they start and how many they are.
+//! Entries are simply overwritten on collision, and atoms once the ring wraps around, so that memory stays bounded;
+//! a lookup that needs the atoms of an entry whose atoms have been overwritten misses, but one that needs only its
+//! heuristic value still hits. The table is lock-free: every entry is guarded by a version counter (a seqlock), so that
+//! readers detect, and treat as misses, entries that are being written concurrently, and writers simply drop their value
+//! if some other thread is writing the same entry. Writers reserve their range of the ring with an atomic cursor.
+class HeuristicCache {
+public:
+	//! The number of relevant atoms per entry that the ring is sized for, on average
+	static const unsigned RELEVANT_PER_ENTRY = 8;
+
+	//! A cache with (at least) the given number of entries and a ring of (at least) the given number of relevant atoms,
+	//! both rounded up to a power of two
+	HeuristicCache(std::size_t num_entries, std::size_t num_relevant);
+
+	//! Return a cache sized according to the 'heuristic_cache.mb' option, or nullptr if it is disabled
+	static std::unique_ptr<HeuristicCache> create(const Config& config);
+
+	HeuristicCache(const HeuristicCache&) = delete;
+	HeuristicCache(HeuristicCache&&) = delete;
+	HeuristicCache& operator=(const HeuristicCache&) = delete;
+	HeuristicCache& operator=(HeuristicCache&&) = delete;
+
+	//! Look up the heuristic value of the given state, and return true iff it was found. If 'relevant' is not null,
+	//! the lookup only succeeds if the relevant atoms of the state are still stored as well, in which case they are added to it.
+	bool lookup(const State& state, long& h, std::vector<Atom>* relevant) const;
+
+	//! Store the heuristic value (and the relevant atoms, if not null) of the given state
+	void store(const State& state, long h, const std::vector<Atom>* relevant);
+
+	std::size_t size() const { return _mask + 1; }
+
+	//! The number of relevant atoms that the ring can hold
+	std::size_t ring_size() const { return _ring_mask + 1; }
+
+protected:
+	//! The size of an entry, if it holds no relevant atoms
+	static const uint32_t NO_RELEVANT = std::numeric_limits<uint32_t>::max();
+
+	struct alignas(32) EntryT {
+		std::atomic<uint32_t> version; // Odd while the entry is being written
+		std::atomic<uint32_t> size; // The number of relevant atoms, or NO_RELEVANT
+		std::atomic<uint64_t> fingerprint; // 0 if the entry is empty
+		std::atomic<int64_t> h;
+		std::atomic<uint64_t> offset; // The position of the first relevant atom in the (unbounded) sequence of atoms of the ring
+	};
+
+	//! Each atom takes two words of the ring: its variable, and the type and value of the object
+	static const unsigned ATOM_WORDS = 2;
+
+	std::unique_ptr<EntryT[]> _entries;
+
+	std::size_t _mask;
+
+	std::unique_ptr<std::atomic<uint64_t>[]> _ring;
+
+	std::size_t _ring_mask;
+
+	//! The number of atoms ever written to the ring. Atom 'i' is stored at position 'i & _ring_mask' of the ring.
+	std::atomic<uint64_t> _cursor;
+
+	//! A 64-bit hash of the words of the state, independent of (Zobrist) hash used to index the table, and never 0
+	static uint64_t fingerprint(const State& state);
+};
+
+
+//! An adaptor that serves the evaluations of a heuristic from a HeuristicCache (if any), and counts in the search stats
+//! the cache hits and misses, and the evaluations, i.e. the cache misses if there is a cache.
+//! Meant to be built on the spot, right before an evaluation.
+template <typename HeuristicT, typename StatsT>
+class CachedHeuristic {
+public:
+	CachedHeuristic(HeuristicT& heuristic, HeuristicCache* cache, StatsT& stats) :
+		_heuristic(heuristic), _cache(cache), _stats(stats)
+	{}
+
+	long evaluate(const State& state, std::vector<Atom>& relevant) {
+		if (!_cache) {
+			_stats.evaluation();
+			return _heuristic.evaluate(state, relevant);
+		}
+		long h;
+		if (_cache->lookup(state, h, &relevant)) {
+			_stats.cache_hit();
+			return h;
+		}
+		_stats.cache_miss();
+		_stats.evaluation();
+		h = _heuristic.evaluate(state, relevant);
+		_cache->store(state, h, &relevant);
+		return h;
+	}
+
+	long evaluate(const State& state) {
+		if (!_cache) {
+			_stats.evaluation();
+			return _heuristic.evaluate(state);
+		}
+		long h;
+		if (_cache->lookup(state, h, nullptr)) {
+			_stats.cache_hit();
+			return h;
+		}
+		_stats.cache_miss();
+		_stats.evaluation();
+		h = _heuristic.evaluate(state);
+		_cache->store(state, h, nullptr);
+		return h;
+	}
+
+protected:
+	HeuristicT& _heuristic;
+	HeuristicCache* _cache;
+	StatsT& _stats;
+};
+
+} // namespaces
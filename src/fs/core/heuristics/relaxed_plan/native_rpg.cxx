@@ -23,8 +23,19 @@ NativeRPG::NativeRPG(const Problem& problem, const fs::Formula* goal_formula, co
 	_tuple_index(problem.get_tuple_index()),
 	_managers(std::move(managers)),
 	_extension_handler(std::move(extension_handler)),
-    _goal_checker(goal_formula, _tuple_index, true)
+    _goal_checker(goal_formula, _tuple_index, true),
+	_explorer()
 {
+	if (Config::instance().getOption<bool>("native.explorer", false)) {
+		_explorer = RelaxedExplorer::create(_managers, _goal_checker, _tuple_index);
+		LPT_INFO("cout", "NativeRPG: " << (_explorer ? "using queue-driven relaxed exploration" : "actions not in STRIPS form, using layered RPG"));
+		if (_explorer && Config::instance().getOption<bool>("native.incremental", false)) {
+			unsigned max_delta = Config::instance().getOption<int>("native.incremental.max_delta", 32);
+			_explorer->set_incremental(max_delta);
+			LPT_INFO("cout", "NativeRPG: repairing the relaxed fixpoint of the last state evaluated for up to " << max_delta << " changed atoms");
+		}
+	}
+
 	LPT_INFO("heuristic", "NativeRPG heuristic initialized");
 	if (_managers.empty()) {
 		LPT_INFO("cout", "*** WARNING - Heuristic initialized with no applicable action ***");
@@ -37,6 +48,21 @@ long NativeRPG::evaluate(const State& seed, std::vector<Atom>& relevant) {
 
 	if (_problem.getGoalSatManager().satisfied(seed)) return 0; // The seed state is a goal
 
+	if (_explorer) {
+		// The atoms of the seed state make up layer 0 (false predicative atoms are not atoms of the RPG)
+		_seed_atoms.clear();
+		for (VariableIdx variable = 0; variable < seed.numAtoms(); ++variable) {
+			object_id value = seed.getValue(variable);
+			if (seed.indexer().field(variable).predicative && !fs0::value<bool>(value)) continue;
+			_seed_atoms.push_back(_tuple_index.to_index(variable, value));
+		}
+
+		_relevant_atoms.clear();
+		long h = _explorer->hff(_seed_atoms, _relevant_atoms);
+		for (AtomIdx atom:_relevant_atoms) relevant.push_back(_tuple_index.to_atom(atom));
+		return h;
+	}
+
 	LPT_EDEBUG("heuristic", std::endl << "Computing RPG from seed state: " << std::endl << seed << std::endl << "****************************************");
 
 	RPGIndex graph(seed, _tuple_index, _extension_handler);
@@ -9,6 +9,7 @@
 #include <unordered_set>
 #include <fs/core/constraints/gecode/handlers/ground_effect_csp.hxx>
 #include <fs/core/constraints/native/action_handler.hxx>
+#include <fs/core/heuristics/relaxed_plan/relaxed_explorer.hxx>
 
 namespace fs0 { class Problem; class State; class RPGData; }
 
@@ -61,6 +62,13 @@ protected:
 	ExtensionHandler _extension_handler;
 
     SimpleFormulaChecker _goal_checker;
+
+	//! The queue-driven relaxed exploration, if all actions are simple enough for it; otherwise the RPG is built layer by layer
+	std::unique_ptr<RelaxedExplorer> _explorer;
+
+	//! The workspace of the explorer: the atoms of the seed state and the relevant atoms of the relaxed plan
+	std::vector<AtomIdx> _seed_atoms;
+	std::vector<AtomIdx> _relevant_atoms;
 };
 
 } } // namespaces
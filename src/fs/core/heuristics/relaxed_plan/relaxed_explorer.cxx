@@ -0,0 +1,314 @@
+#include <algorithm>
+
+#include <fs/core/heuristics/relaxed_plan/relaxed_explorer.hxx>
+#include <fs/core/constraints/native/action_handler.hxx>
+#include <fs/core/utils/atom_index.hxx>
+
+
+namespace fs0 { namespace gecode {
+
+const unsigned RelaxedExplorer::UNREACHED;
+
+std::unique_ptr<RelaxedExplorer>
+RelaxedExplorer::create(const std::vector<std::unique_ptr<NativeActionHandler>>& handlers, const SimpleFormulaChecker& goal, const AtomIndex& tuple_index) {
+	if (!goal.inequality_atoms().empty()) return nullptr;
+	for (const auto& handler:handlers) {
+		if (!handler->get_precondition_checker().inequality_atoms().empty()) return nullptr;
+		const auto& achievable = handler->get_achievable_tuples();
+		if (std::find(achievable.begin(), achievable.end(), INVALID_TUPLE) != achievable.end()) return nullptr;
+	}
+
+	std::vector<std::vector<AtomIdx>> preconditions, effects;
+	for (const auto& handler:handlers) {
+		preconditions.emplace_back();
+		for (const auto& pre:handler->get_precondition_checker().equality_atoms()) {
+			preconditions.back().push_back(tuple_index.to_index(pre.first, pre.second));
+		}
+		effects.push_back(handler->get_achievable_tuples());
+	}
+
+	std::vector<AtomIdx> goal_atoms;
+	for (const auto& atom:goal.equality_atoms()) goal_atoms.push_back(tuple_index.to_index(atom.first, atom.second));
+
+	return std::unique_ptr<RelaxedExplorer>(new RelaxedExplorer(tuple_index.size(), preconditions, effects, goal_atoms));
+}
+
+RelaxedExplorer::RelaxedExplorer(unsigned num_atoms, const std::vector<std::vector<AtomIdx>>& preconditions, const std::vector<std::vector<AtomIdx>>& effects, const std::vector<AtomIdx>& goal) :
+	_incremental(false),
+	_valid(false),
+	_max_delta(0)
+{
+	assert(preconditions.size() == effects.size());
+	const unsigned num_actions = preconditions.size();
+
+	std::vector<unsigned> num_triggers(num_atoms, 0);
+	_pre_offsets.push_back(0);
+	_add_offsets.push_back(0);
+	for (unsigned a = 0; a < num_actions; ++a) {
+		for (AtomIdx atom:preconditions[a]) {
+			_pre.push_back(atom);
+			++num_triggers[atom];
+		}
+		_add.insert(_add.end(), effects[a].begin(), effects[a].end());
+		_pre_offsets.push_back(_pre.size());
+		_add_offsets.push_back(_add.size());
+		if (_pre_offsets[a] == _pre_offsets[a + 1]) _unconditional.push_back(a);
+	}
+
+	// Invert the preconditions into a (CSR) index from atoms to the actions they trigger
+	_trigger_offsets.assign(num_atoms + 1, 0);
+	for (unsigned p = 0; p < num_atoms; ++p) _trigger_offsets[p + 1] = _trigger_offsets[p] + num_triggers[p];
+	_triggers.resize(_pre.size());
+	std::vector<unsigned> cursor(_trigger_offsets.begin(), _trigger_offsets.end() - 1);
+	for (unsigned a = 0; a < num_actions; ++a) {
+		for (unsigned i = _pre_offsets[a]; i < _pre_offsets[a + 1]; ++i) {
+			_triggers[cursor[_pre[i]]++] = a;
+		}
+	}
+
+	// Likewise for the actions that achieve each atom
+	std::vector<unsigned> num_achievers(num_atoms, 0);
+	for (AtomIdx atom:_add) ++num_achievers[atom];
+	_achiever_offsets.assign(num_atoms + 1, 0);
+	for (unsigned p = 0; p < num_atoms; ++p) _achiever_offsets[p + 1] = _achiever_offsets[p] + num_achievers[p];
+	_achievers.resize(_add.size());
+	cursor.assign(_achiever_offsets.begin(), _achiever_offsets.end() - 1);
+	for (unsigned a = 0; a < num_actions; ++a) {
+		for (unsigned i = _add_offsets[a]; i < _add_offsets[a + 1]; ++i) {
+			_achievers[cursor[_add[i]]++] = a;
+		}
+	}
+
+	_is_goal.assign(num_atoms, false);
+	for (AtomIdx atom:goal) {
+		if (!_is_goal[atom]) _goal.push_back(atom);
+		_is_goal[atom] = true;
+	}
+
+	_counter.resize(num_actions);
+	for (unsigned a = 0; a < num_actions; ++a) _counter[a] = _pre_offsets[a + 1] - _pre_offsets[a];
+	_layer.assign(num_atoms, UNREACHED);
+	_achiever.assign(num_atoms, UNREACHED);
+	_in_plan.assign(num_actions, false);
+	_is_supported.assign(num_atoms, false);
+	_in_seed.assign(num_atoms, false);
+}
+
+void
+RelaxedExplorer::reset() {
+	for (AtomIdx atom:_reached) _layer[atom] = _achiever[atom] = UNREACHED;
+	for (unsigned action:_touched) _counter[action] = _pre_offsets[action + 1] - _pre_offsets[action];
+	_reached.clear();
+	_touched.clear();
+	_current.clear();
+	_next.clear();
+}
+
+void
+RelaxedExplorer::reach(AtomIdx atom, unsigned layer, unsigned action, std::vector<AtomIdx>& bucket, unsigned& pending_goals) {
+	if (_layer[atom] != UNREACHED) return;
+	_layer[atom] = layer;
+	_achiever[atom] = action;
+	_reached.push_back(atom);
+	bucket.push_back(atom);
+	if (_is_goal[atom]) --pending_goals;
+}
+
+void
+RelaxedExplorer::fire(unsigned action, unsigned layer, unsigned& pending_goals) {
+	for (unsigned i = _add_offsets[action]; i < _add_offsets[action + 1]; ++i) {
+		reach(_add[i], layer + 1, action, _next, pending_goals);
+	}
+}
+
+bool
+RelaxedExplorer::explore(const std::vector<AtomIdx>& seed) {
+	reset();
+	unsigned pending_goals = _goal.size();
+
+	// The atoms of the seed state make up layer 0
+	for (AtomIdx atom:seed) reach(atom, 0, UNREACHED, _current, pending_goals);
+
+	for (unsigned action:_unconditional) fire(action, 0, pending_goals);
+
+	// Process the atoms layer by layer: an action fires on the layer where its last precondition is reached.
+	// Note that layer 0 might be empty and still have the effects of the unconditional actions follow it.
+	for (unsigned layer = 0; pending_goals > 0 && (!_current.empty() || !_next.empty()); ++layer) {
+		for (AtomIdx atom:_current) {
+			for (unsigned i = _trigger_offsets[atom]; i < _trigger_offsets[atom + 1]; ++i) {
+				unsigned action = _triggers[i];
+				unsigned& counter = _counter[action];
+				if (counter == _pre_offsets[action + 1] - _pre_offsets[action]) _touched.push_back(action); // First time touched
+				if (--counter == 0) fire(action, layer, pending_goals);
+			}
+		}
+		std::swap(_current, _next);
+		_next.clear();
+	}
+	return pending_goals == 0;
+}
+
+void
+RelaxedExplorer::set_incremental(unsigned max_delta) {
+	_incremental = true;
+	_valid = false;
+	_max_delta = max_delta;
+	_action_layer.assign(_counter.size(), UNREACHED);
+}
+
+bool
+RelaxedExplorer::update(const std::vector<AtomIdx>& seed) {
+	if (!_valid) {
+		rebuild(seed);
+	} else {
+		// Find out the atoms by which the seed differs from that of the current fixpoint
+		_deleted.clear();
+		_added.clear();
+		for (AtomIdx atom:seed) {
+			if (!_in_seed[atom]) _added.push_back(atom);
+		}
+		for (AtomIdx atom:_seed) _in_seed[atom] = false;
+		for (AtomIdx atom:seed) _in_seed[atom] = true;
+		for (AtomIdx atom:_seed) {
+			if (!_in_seed[atom]) _deleted.push_back(atom);
+		}
+		_seed.assign(seed.begin(), seed.end());
+
+		if (_deleted.size() + _added.size() > _max_delta) {
+			rebuild(seed);
+		} else {
+			// Atoms no longer in the seed might have their layer increased, as might all atoms that depend on them.
+			// Atoms newly in the seed only decrease layers, which the propagation takes care of.
+			for (AtomIdx atom:_deleted) {
+				_layer[atom] = _achiever[atom] = UNREACHED;
+				_invalidated.push_back(atom);
+			}
+			invalidate();
+			for (AtomIdx atom:_added) improve(atom, 0, UNREACHED);
+			propagate();
+		}
+	}
+
+	for (AtomIdx atom:_goal) {
+		if (_layer[atom] == UNREACHED) return false;
+	}
+	return true;
+}
+
+void
+RelaxedExplorer::rebuild(const std::vector<AtomIdx>& seed) {
+	std::fill(_layer.begin(), _layer.end(), UNREACHED);
+	std::fill(_achiever.begin(), _achiever.end(), UNREACHED);
+	std::fill(_action_layer.begin(), _action_layer.end(), UNREACHED);
+
+	for (AtomIdx atom:_seed) _in_seed[atom] = false;
+	_seed.assign(seed.begin(), seed.end());
+	for (AtomIdx atom:seed) {
+		_in_seed[atom] = true;
+		improve(atom, 0, UNREACHED);
+	}
+
+	// Actions with no precondition are never triggered by the propagation, and never invalidated
+	for (unsigned action:_unconditional) {
+		_action_layer[action] = 0;
+		for (unsigned i = _add_offsets[action]; i < _add_offsets[action + 1]; ++i) improve(_add[i], 1, action);
+	}
+
+	propagate();
+	_valid = true;
+}
+
+void
+RelaxedExplorer::invalidate() {
+	// An action is invalidated if any of its preconditions is, and an atom if its first achiever is.
+	// Note that '_invalidated' grows while we iterate over it.
+	for (unsigned k = 0; k < _invalidated.size(); ++k) {
+		AtomIdx atom = _invalidated[k];
+		for (unsigned i = _trigger_offsets[atom]; i < _trigger_offsets[atom + 1]; ++i) {
+			unsigned action = _triggers[i];
+			if (_action_layer[action] == UNREACHED) continue;
+			_action_layer[action] = UNREACHED;
+			for (unsigned j = _add_offsets[action]; j < _add_offsets[action + 1]; ++j) {
+				AtomIdx effect = _add[j];
+				if (_achiever[effect] != action) continue;
+				_layer[effect] = _achiever[effect] = UNREACHED;
+				_invalidated.push_back(effect);
+			}
+		}
+	}
+
+	// The invalidated atoms get their best layer through the actions that remain valid, if any
+	for (AtomIdx atom:_invalidated) {
+		for (unsigned i = _achiever_offsets[atom]; i < _achiever_offsets[atom + 1]; ++i) {
+			unsigned action = _achievers[i];
+			if (_action_layer[action] != UNREACHED) improve(atom, _action_layer[action] + 1, action);
+		}
+	}
+	_invalidated.clear();
+}
+
+void
+RelaxedExplorer::improve(AtomIdx atom, unsigned layer, unsigned action) {
+	if (layer >= _layer[atom]) return;
+	_layer[atom] = layer;
+	_achiever[atom] = action;
+	if (layer >= _buckets.size()) _buckets.resize(layer + 1);
+	_buckets[layer].push_back(atom);
+}
+
+void
+RelaxedExplorer::propagate() {
+	// Atoms are processed in order of layer, and an atom can only improve the atoms of higher layers,
+	// hence each atom is settled the first time it is popped with its current layer.
+	for (unsigned layer = 0; layer < _buckets.size(); ++layer) {
+		for (unsigned k = 0; k < _buckets[layer].size(); ++k) {
+			AtomIdx atom = _buckets[layer][k];
+			if (_layer[atom] != layer) continue; // A stale entry
+
+			for (unsigned i = _trigger_offsets[atom]; i < _trigger_offsets[atom + 1]; ++i) {
+				unsigned action = _triggers[i];
+				unsigned action_layer = 0;
+				for (unsigned j = _pre_offsets[action]; j < _pre_offsets[action + 1] && action_layer != UNREACHED; ++j) {
+					action_layer = std::max(action_layer, _layer[_pre[j]]);
+				}
+				if (action_layer >= _action_layer[action]) continue;
+
+				_action_layer[action] = action_layer;
+				for (unsigned j = _add_offsets[action]; j < _add_offsets[action + 1]; ++j) improve(_add[j], action_layer + 1, action);
+			}
+		}
+		_buckets[layer].clear();
+	}
+}
+
+long
+RelaxedExplorer::hff(const std::vector<AtomIdx>& seed, std::vector<AtomIdx>& relevant) {
+	if (!(_incremental ? update(seed) : explore(seed))) return -1;
+
+	// Backchain from the goal atoms through the first achiever of each atom
+	long h = 0;
+	_open.assign(_goal.begin(), _goal.end());
+	while (!_open.empty()) {
+		AtomIdx atom = _open.back();
+		_open.pop_back();
+		if (_is_supported[atom] || _layer[atom] == 0) continue;
+		_is_supported[atom] = true;
+		_supported.push_back(atom);
+		if (_layer[atom] == 1) relevant.push_back(atom);
+
+		unsigned action = _achiever[atom];
+		if (_in_plan[action]) continue;
+		_in_plan[action] = true;
+		_plan.push_back(action);
+		++h;
+		_open.insert(_open.end(), _pre.begin() + _pre_offsets[action], _pre.begin() + _pre_offsets[action + 1]);
+	}
+
+	for (AtomIdx atom:_supported) _is_supported[atom] = false;
+	for (unsigned action:_plan) _in_plan[action] = false;
+	_supported.clear();
+	_plan.clear();
+	return h;
+}
+
+} } // namespaces
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <fs/core/fs_types.hxx>
+
+namespace fs0 { class AtomIndex; }
+
+namespace fs0 { namespace gecode {
+
+class NativeActionHandler;
+class SimpleFormulaChecker;
+
+//! A relaxed reachability analysis for problems whose (relaxed) actions all have conjunctions of atoms X=c as preconditions
+//! and only effects of the form X := c, i.e. for ground STRIPS problems. Rather than building the RPG layer by layer
+//! and checking all actions on each layer, the exploration is driven by a queue of newly-reached atoms, bucketed
+//! by layer: each action keeps a counter of its unreached preconditions, which is decreased as the atoms get reached,
+//! and the action fires (i.e. its add effects are reached on the next layer) when the counter drops to zero. The cost
+//! of an evaluation is thus linear in the size of the part of the problem that is reached before the goal is.
+//! The layers computed are those of the RPG, i.e. the layer of each atom is its h_max value, and the h_FF value is
+//! the number of distinct actions of the relaxed plan obtained by backchaining from the goal through the first achiever of each atom.
+//! All data used by an evaluation is preallocated once and reset in time linear in the size of the previous exploration.
+//! In incremental mode, the explorer instead keeps the full relaxed fixpoint of the last state evaluated, and repairs it
+//! for the atoms by which the next state differs: the atoms whose layer might increase (i.e. those that depend, through
+//! their first achiever, on some atom that is no longer in the seed) are invalidated and recomputed, and all layer decreases
+//! are then propagated through a bucket queue, as in a Dijkstra-like exploration. If the states differ in too many atoms,
+//! the fixpoint is computed from scratch.
+//! The explorer works on atom indexes only: the seed of each evaluation is given as the list of its atoms.
+class RelaxedExplorer {
+public:
+	static const unsigned UNREACHED = std::numeric_limits<unsigned>::max();
+
+	//! Return an explorer for the given actions and goal, or nullptr if some of them is not in the required form
+	static std::unique_ptr<RelaxedExplorer> create(const std::vector<std::unique_ptr<NativeActionHandler>>& handlers, const SimpleFormulaChecker& goal, const AtomIndex& tuple_index);
+
+	//! An explorer over 'num_atoms' atoms, where action 'a' has the atoms 'preconditions[a]' as precondition and 'effects[a]' as add effects
+	RelaxedExplorer(unsigned num_atoms, const std::vector<std::vector<AtomIdx>>& preconditions, const std::vector<std::vector<AtomIdx>>& effects, const std::vector<AtomIdx>& goal);
+
+	//! The h_FF value of the state with the given (distinct) atoms, or -1 if the goal is unreachable. 'relevant' gets the atoms
+	//! of the relaxed plan that lie on the first layer, as in the layered RPG.
+	long hff(const std::vector<AtomIdx>& seed, std::vector<AtomIdx>& relevant);
+
+	//! The layer of the given atom in the last evaluation, i.e. its h_max value, or UNREACHED. Note that, unless in incremental
+	//! mode, the exploration stops as soon as all goal atoms are reached, hence only the layers up to that of the goal are complete.
+	unsigned layer(AtomIdx atom) const { return _layer[atom]; }
+
+	//! Switch to incremental mode, recomputing the fixpoint from scratch only for states that differ in more
+	//! than 'max_delta' atoms from the last state evaluated
+	void set_incremental(unsigned max_delta);
+
+protected:
+	//! The precondition atoms of action 'a' are those in the range [_pre_offsets[a], _pre_offsets[a+1]) of '_pre';
+	//! likewise for its add atoms, and for the actions that have atom 'p' in their precondition ('_triggers')
+	std::vector<unsigned> _pre_offsets;
+	std::vector<AtomIdx> _pre;
+	std::vector<unsigned> _add_offsets;
+	std::vector<AtomIdx> _add;
+	std::vector<unsigned> _trigger_offsets;
+	std::vector<unsigned> _triggers;
+
+	//! The actions with no precondition
+	std::vector<unsigned> _unconditional;
+
+	//! The actions that have atom 'p' as an add effect are those in the range [_achiever_offsets[p], _achiever_offsets[p+1]) of '_achievers'
+	std::vector<unsigned> _achiever_offsets;
+	std::vector<unsigned> _achievers;
+
+	//! The (distinct) goal atoms
+	std::vector<AtomIdx> _goal;
+	std::vector<bool> _is_goal;
+
+	//! The workspace of the exploration: the number of unreached preconditions of each action, the layer
+	//! and first achiever of each atom, and the atoms reached on the current and next layer
+	std::vector<unsigned> _counter;
+	std::vector<unsigned> _layer;
+	std::vector<unsigned> _achiever;
+	std::vector<AtomIdx> _current;
+	std::vector<AtomIdx> _next;
+
+	//! The atoms and actions touched by the last exploration, which need to be reset before the next one
+	std::vector<AtomIdx> _reached;
+	std::vector<unsigned> _touched;
+
+	//! The workspace of the extraction of the relaxed plan: the atoms yet to be supported, the atoms
+	//! already supported, and the actions of the plan, plus the corresponding marks
+	std::vector<AtomIdx> _open;
+	std::vector<AtomIdx> _supported;
+	std::vector<unsigned> _plan;
+	std::vector<bool> _is_supported;
+	std::vector<bool> _in_plan;
+
+	//! The state of the incremental mode: whether it is enabled and holds a valid fixpoint, the atoms of the seed
+	//! of that fixpoint, plus the corresponding marks, and the layer of each action, i.e. the max. layer of its preconditions
+	bool _incremental;
+	bool _valid;
+	unsigned _max_delta;
+	std::vector<AtomIdx> _seed;
+	std::vector<bool> _in_seed;
+	std::vector<unsigned> _action_layer;
+
+	//! The workspace of the repair: the seed atoms deleted and added, the atoms invalidated, and the atoms
+	//! whose layer has changed, bucketed by their new layer
+	std::vector<AtomIdx> _deleted;
+	std::vector<AtomIdx> _added;
+	std::vector<AtomIdx> _invalidated;
+	std::vector<std::vector<AtomIdx>> _buckets;
+
+	//! Run the exploration from the given state until all goal atoms are reached. Return false if they cannot be.
+	bool explore(const std::vector<AtomIdx>& seed);
+
+	//! Bring the full fixpoint up to date with the given state, and return false if some goal atom is not reached
+	bool update(const std::vector<AtomIdx>& seed);
+
+	//! Compute the full fixpoint from scratch
+	void rebuild(const std::vector<AtomIdx>& seed);
+
+	//! Invalidate the layers that depend on the atoms of '_invalidated', which must already be marked as unreached,
+	//! and set them to the best value they can get from the actions that are still valid
+	void invalidate();
+
+	//! Set the layer of the given atom, if that is an improvement, and schedule the propagation of the change
+	void improve(AtomIdx atom, unsigned layer, unsigned action);
+
+	//! Propagate all scheduled changes until the fixpoint is reached
+	void propagate();
+
+	//! Reset the workspace left by the last exploration
+	void reset();
+
+	//! Mark the given atom as reached on the given layer through the given action, if it was not reached yet
+	void reach(AtomIdx atom, unsigned layer, unsigned action, std::vector<AtomIdx>& bucket, unsigned& pending_goals);
+
+	//! Fire the given action on the given layer
+	void fire(unsigned action, unsigned layer, unsigned& pending_goals);
+};
+
+} } // namespaces
@@ -12,88 +12,112 @@ namespace fs0 { namespace gecode {
 
 
 RPGIndex::RPGIndex(const State& seed, const AtomIndex& tuple_index, ExtensionHandler& extension_handler) :
-	_reached(tuple_index.size(), nullptr),
+	_layers(tuple_index.size(), UNREACHED),
+	_achievers(tuple_index.size(), nullptr),
+	_support_begin(tuple_index.size(), 0),
+	_support_end(tuple_index.size(), 0),
+	_supports(),
+	_reached(),
 	_novel_tuples(),
 	_current_layer(0),
 	_extension_handler(extension_handler),
+	_extensions(),
+	_extension_ready(),
+	_domains(seed.numAtoms()),
+	_domain_ready(seed.numAtoms(), false),
+	_domains_raw(seed.numAtoms()),
+	_layer_domain_size(seed.numAtoms(), 0),
 	_tuple_index(tuple_index),
 	_seed(seed)
 {
-	_domains.reserve(seed.numAtoms());
 	_extension_handler.reset();
 	
-	_domains_raw.resize(seed.numAtoms());
-	
 	// Initially we insert the seed state atoms
 	for (unsigned variable = 0; variable < seed.numAtoms(); ++variable) {
 		object_id value = seed.getValue(variable);
 		
 		AtomIdx tuple_index = _extension_handler.process_atom(variable, value);
 		if (tuple_index != INVALID_TUPLE) {
-			_domains.push_back(Gecode::IntSet(fs0::value<int>(value), fs0::value<int>(value)));
 			add(tuple_index, nullptr, {});
-			
-		} else {
-			_domains.push_back(Gecode::IntSet()); // We simply push an empty domain for those predicative state variables that are set to false.
 		}
+		// Predicative state variables that are set to false simply get an empty domain.
+		_layer_domain_size[variable] = _domains_raw[variable].size();
 	}
+
+	std::size_t num_symbols = ProblemInfo::getInstance().getNumLogicalSymbols();
+	_extensions.resize(num_symbols);
+	_extension_ready.assign(num_symbols, false);
 	next();
 }
 
 void RPGIndex::advance() {
 	_extension_handler.advance();
 	
+	// Only the domains of the variables and the extensions of the symbols of the novel tuples change
 	for (AtomIdx tuple:_novel_tuples) {
 		_extension_handler.process_tuple(tuple);
-	}
-	
-	// Now update the per-variable domains
-	for (unsigned variable = 0; variable < _domains_raw.size(); ++variable) {
-		const auto& all = _domains_raw[variable];
-		std::vector<int> vals = fs0::values<int>(all, ObjectTable::EMPTY_TABLE);
-		_domains[variable] = Gecode::IntSet(vals.data(), vals.size());
+		_extension_ready[_tuple_index.symbol(tuple)] = false;
+
+		VariableIdx variable = _tuple_index.to_atom(tuple).getVariable();
+		_layer_domain_size[variable] = _domains_raw[variable].size();
+		_domain_ready[variable] = false;
 	}
 	
 	next();
 }
 
 void RPGIndex::next() {
-	_extensions = _extension_handler.generate_extensions();
 	_novel_tuples.clear();
 	++_current_layer;
 }
 
-
-RPGIndex::~RPGIndex() {
-	// delete all the pointers to action IDs, which belong to this container
-	for (auto element:_reached) {
-		if (element != nullptr) {
-			const ActionID* action_id = std::get<1>(*element);
-			delete action_id;
-			delete element;
-		}
+const Gecode::TupleSet& RPGIndex::get_extension(unsigned symbol_id) const {
+	if (!_extension_ready.at(symbol_id)) {
+		_extensions[symbol_id] = _extension_handler.is_managed(symbol_id) ? _extension_handler.generate_extension(symbol_id) : Gecode::TupleSet();
+		_extension_ready[symbol_id] = true;
 	}
+	return _extensions[symbol_id];
 }
 
-
-RPGIndex::TupleSupport* RPGIndex::createTupleSupport(const ActionID* action, std::vector<AtomIdx>&& support) const {
-	return new TupleSupport(_current_layer, action, std::move(support));
+const Gecode::IntSet& RPGIndex::get_domain(VariableIdx variable) const {
+	if (!_domain_ready.at(variable)) {
+		// Values reached on the current layer are not part of the domain until the layer is complete
+		const auto& all = _domains_raw[variable];
+		std::vector<int> vals;
+		vals.reserve(_layer_domain_size[variable]);
+		for (unsigned i = 0; i < _layer_domain_size[variable]; ++i) vals.push_back(fs0::value<int>(all[i]));
+		_domains[variable] = Gecode::IntSet(vals.data(), vals.size());
+		_domain_ready[variable] = true;
+	}
+	return _domains[variable];
 }
 
-const RPGIndex::TupleSupport& RPGIndex::getTupleSupport(AtomIdx tuple) const {
-	auto support = _reached.at(tuple);
-	assert(support != nullptr);
-	return *support;
+const std::vector<Gecode::IntSet>& RPGIndex::get_domains() const {
+	for (VariableIdx variable = 0; variable < _domains.size(); ++variable) get_domain(variable);
+	return _domains;
 }
 
-bool RPGIndex::reached(AtomIdx tuple) const {
-	return _reached.at(tuple) != nullptr;
+
+RPGIndex::~RPGIndex() {
+	// delete all the pointers to action IDs, which belong to this container
+	for (AtomIdx tuple:_reached) delete _achievers[tuple];
 }
 
-void RPGIndex::add(AtomIdx tuple, const ActionID* action, std::vector<AtomIdx>&& support) {
-	auto& it = _reached.at(tuple);
-	if (it != nullptr) return; // Don't insert the atom if it was already tracked by the RPG
-	it = createTupleSupport(action, std::move(support)); // This effectively inserts the tuple into '_reached'
+
+void RPGIndex::add(AtomIdx tuple, const ActionID* action, const std::vector<AtomIdx>& support) {
+	assert(tuple < _layers.size());
+	if (_layers[tuple] != UNREACHED) { // Don't insert the atom if it was already tracked by the RPG
+		delete action;
+		return;
+	}
+
+	_layers[tuple] = _current_layer;
+	_achievers[tuple] = action;
+	_support_begin[tuple] = _supports.size();
+	_supports.insert(_supports.end(), support.begin(), support.end());
+	_support_end[tuple] = _supports.size();
+
+	_reached.push_back(tuple);
 	_novel_tuples.push_back(tuple);
 	const Atom& atom = _tuple_index.to_atom(tuple);
 	auto& domain = _domains_raw.at(atom.getVariable());
@@ -101,28 +125,17 @@ void RPGIndex::add(AtomIdx tuple, const ActionID* action, std::vector<AtomIdx>&&
 	domain.push_back(atom.getValue());
 }
 
-/*
-unsigned RPGIndex::compute_hmax_sum(const std::vector<Atom>& atoms) const {
-	unsigned sum = 0;
-	for (const Atom& atom:atoms) {
-		sum += std::get<0>(getTupleSupport(atom));
-	}
-	return sum;
-}
-*/
-
 std::ostream& RPGIndex::print(std::ostream& os) const {
 	const ProblemInfo& info = ProblemInfo::getInstance();
 	os << "RPG Tuples: " << std::endl;
 	unsigned cnt = 0;
-	for (unsigned i = 0; i < _reached.size(); ++i) {
-		TupleSupport* support = _reached[i];
-		if (support != nullptr) {
-			const ActionID* action_id = std::get<1>(*support);
+	for (unsigned i = 0; i < _layers.size(); ++i) {
+		if (reached(i)) {
+			const ActionID* action_id = _achievers[i];
 			os << "Tuple: " << i  << "\t(Atom: " << _tuple_index.to_atom(i) << ")\t- action: ";
 			(action_id ? os << *action_id : os << "[INVALID-ACTION]");
-			os << "\t- layer #" << std::get<0>(*support) << " - support: ";
-			printAtoms(std::get<2>(*support), os);
+			os << "\t- layer #" << _layers[i] << " - support: ";
+			printAtoms(get_support(i), os);
 			os << std::endl;
 			++cnt;
 		}
@@ -131,14 +144,14 @@ std::ostream& RPGIndex::print(std::ostream& os) const {
 	
 	os << "RPG State Variable Domains: " << std::endl;
 	for (unsigned variable = 0; variable < _domains.size(); ++variable) {
-		os << info.getVariableName(variable) << ": " << _domains[variable] << std::endl;
+		os << info.getVariableName(variable) << ": " << get_domain(variable) << std::endl;
 	}
 	
 	return os;
 }
 
-void RPGIndex::printAtoms(const std::vector<AtomIdx>& vector, std::ostream& os) const {
-	for (const auto& element:vector) {
+void RPGIndex::printAtoms(const SupportT& support, std::ostream& os) const {
+	for (const auto& element:support) {
 		os << element << ", ";
 	}
 }
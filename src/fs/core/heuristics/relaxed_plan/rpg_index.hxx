@@ -3,6 +3,7 @@
 
 #include <gecode/int.hh>
 #include <fs/core/fs_types.hxx>
+#include <limits>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -20,24 +21,45 @@ class ExtensionHandler;
  * the atoms that make an action applicable (in a certain RPG layer) and the "extra"
  * atoms that make a particular effect reachable, i.e. those related to the relevant
  * variables of the effect procedure that achieves the effect.
+ * The support data is kept in structure-of-arrays form, indexed by atom, and the supports of all atoms
+ * are stored one after the other in a single buffer, so that reaching an atom does not allocate memory
+ * of its own. The Gecode domains and extensions of each layer, which only the CSP-based action handlers need,
+ * are generated lazily, the first time they are requested on the layer, and only for the state variables and
+ * symbols that have changed since they were last generated.
  */
 class RPGIndex {
 public:
-	//! <layer ID, Action ID, support>, where 'support' is a vector of indexes of logical symbol tuples
-	typedef std::tuple<unsigned, const ActionID*, std::vector<AtomIdx>> TupleSupport;
-	
-	//! A map from the index of a logical symbol tuple to its support in the RPG
-// 	typedef std::unordered_map<AtomIdx, TupleSupport> SupportMap;
-	typedef std::vector<TupleSupport*> SupportMap;
+	static const unsigned UNREACHED = std::numeric_limits<unsigned>::max();
+
+	//! A view of the atoms that support the achievement of some atom. It is invalidated when new atoms are reached.
+	class SupportT {
+	public:
+		SupportT(const AtomIdx* first, const AtomIdx* last) : _first(first), _last(last) {}
+		const AtomIdx* begin() const { return _first; }
+		const AtomIdx* end() const { return _last; }
+		std::size_t size() const { return _last - _first; }
+		bool empty() const { return _first == _last; }
+	protected:
+		const AtomIdx* _first;
+		const AtomIdx* _last;
+	};
 
 protected:
 	/**
-	 * A map with all tuples that have been reached in the RPG. Each tuple index 'I' is mapped to a pair < L, A, V >, where:
-	 * - 'L' is the first layer at which the atom has been achieved.
-	 * - 'A' is the index of one of the actions that achieves the atom.
-	 * - 'V' is a vector with the indexes of all tuples that support the achievement of tuple 'I' through the application of action A.
+	 * The data of all tuples that have been reached in the RPG. For each tuple index 'I':
+	 * - '_layers[I]' is the first layer at which the atom has been achieved, or UNREACHED.
+	 * - '_achievers[I]' is one of the actions that achieves the atom.
+	 * - The range [_support_begin[I], _support_end[I]) of '_supports' holds the indexes of all tuples
+	 *   that support the achievement of tuple 'I' through the application of that action.
 	 */
-	SupportMap _reached;
+	std::vector<unsigned> _layers;
+	std::vector<const ActionID*> _achievers;
+	std::vector<unsigned> _support_begin;
+	std::vector<unsigned> _support_end;
+	std::vector<AtomIdx> _supports;
+
+	//! All the tuples reached so far, in order of achievement
+	std::vector<AtomIdx> _reached;
 
 	//! This keeps a reference to the novel atoms that have been inserted in the most recent layer of the RPG.
 	std::vector<AtomIdx> _novel_tuples;
@@ -47,14 +69,20 @@ protected:
 	
 	ExtensionHandler& _extension_handler;
 	
-	//! The allowed values in the relation that corresponds to every predicate
-	std::vector<Gecode::TupleSet> _extensions;
+	//! The allowed values in the relation that corresponds to every predicate, valid only if the corresponding flag is set
+	mutable std::vector<Gecode::TupleSet> _extensions;
+	mutable std::vector<bool> _extension_ready;
 	
-	//! The set of reached values for every state variable
-	std::vector<Gecode::IntSet> _domains;
+	//! The set of reached values for every state variable (up to the start of the current layer),
+	//! valid only if the corresponding flag is set
+	mutable std::vector<Gecode::IntSet> _domains;
+	mutable std::vector<bool> _domain_ready;
 	
 	//! This is the set of all values reached so far for each state variable
 	std::vector<std::vector<object_id>> _domains_raw;
+
+	//! The number of values of each state variable that had been reached at the start of the current layer
+	std::vector<unsigned> _layer_domain_size;
 	
 	const AtomIndex& _tuple_index;
 	
@@ -63,14 +91,19 @@ protected:
 public:
 	explicit RPGIndex(const State& seed, const AtomIndex& tuple_index, ExtensionHandler& extension_handler);
 	~RPGIndex();
+
+	RPGIndex(const RPGIndex&) = delete;
+	RPGIndex(RPGIndex&&) = default;
+	RPGIndex& operator=(const RPGIndex&) = delete;
+	RPGIndex& operator=(RPGIndex&&) = delete;
 	
 	//! Returns true if the given tuple has already been reached in the current graph.
-	bool reached(AtomIdx tuple) const;
+	bool reached(AtomIdx tuple) const { assert(tuple < _layers.size()); return _layers[tuple] != UNREACHED; }
 	
 	bool is_true(VariableIdx variable) const;
-	const Gecode::TupleSet& get_extension(unsigned symbol_id) const { return _extensions.at(symbol_id); }
-	const std::vector<Gecode::IntSet>& get_domains() const { return _domains; }
-	const Gecode::IntSet& get_domain(VariableIdx variable) const { return _domains.at(variable); }
+	const Gecode::TupleSet& get_extension(unsigned symbol_id) const;
+	const std::vector<Gecode::IntSet>& get_domains() const;
+	const Gecode::IntSet& get_domain(VariableIdx variable) const;
 
 	//! Returns the number of layers of the RPG.
 	unsigned getNumLayers() const  {return _current_layer + 1; } // 0-indexed!
@@ -78,8 +111,13 @@ public:
 	//! Returns the current layer index
 	unsigned getCurrentLayerIdx() const  {return _current_layer; }
 
-	//! Returns the support for the given atom
-	const TupleSupport& getTupleSupport(AtomIdx tuple) const;
+	//! Returns the layer, the achiever and the support of the given (reached) atom
+	unsigned get_layer(AtomIdx tuple) const { assert(reached(tuple)); return _layers[tuple]; }
+	const ActionID* get_achiever(AtomIdx tuple) const { assert(reached(tuple)); return _achievers[tuple]; }
+	SupportT get_support(AtomIdx tuple) const {
+		assert(reached(tuple));
+		return SupportT(_supports.data() + _support_begin[tuple], _supports.data() + _support_end[tuple]);
+	}
 	
 	const State& getSeed() const { return _seed; }
 
@@ -96,11 +134,9 @@ public:
 	
 	
 	//! Add an atom to the set of newly-reached atoms, only if it is indeed new.
-	void add(AtomIdx tuple, const ActionID* action, std::vector<AtomIdx>&& support);
+	//! The RPG takes ownership of the action ID, which is deleted right away if the atom was not new.
+	void add(AtomIdx tuple, const ActionID* action, const std::vector<AtomIdx>& support);
 	
-	//! Compute the sum of h_max values of all the given atoms, assuming that they have already been reached in the RPG data structure
-// 	unsigned compute_hmax_sum(const std::vector<Atom>& atoms) const;
-
 	//! Prints a representation of the RPG data to the given stream.
 	friend std::ostream& operator<<(std::ostream &os, const RPGIndex& data) { return data.print(os); }
 	std::ostream& print(std::ostream& os) const;
@@ -108,16 +144,11 @@ public:
 	//! Return the set of all tuples that have not been yet reached in the current RPG.
 	std::vector<bool> achieved_atoms(const AtomIndex& tuple_index) const;
 	
-// 	const std::set<unsigned>& get_modified_symbols() const;
-
 	const std::vector<object_id>& getRawDomain(VariableIdx var) const { return _domains_raw.at(var); }
 
 
 protected:
-	//! Creates an atom support data structure with the given data and taking into account the current RPG layer
-	TupleSupport* createTupleSupport(const ActionID* action, std::vector<AtomIdx>&& support) const;
-	
-	void printAtoms(const std::vector<AtomIdx>& vector, std::ostream& os) const;
+	void printAtoms(const SupportT& support, std::ostream& os) const;
 	
 	void next();
 };
@@ -8,6 +8,7 @@
 namespace fs0 {
 
 class Problem;
+class Atom;
 
 std::vector<std::shared_ptr<const fs::Formula>> extract_formula_components(const fs::Formula* formula, const AtomIndex&);
 
@@ -20,6 +21,12 @@ public:
 	//! The actual evaluation of the heuristic value for any given non-relaxed state s.
 	unsigned evaluate(const State& state) const;
 
+	//! The counter computes no relaxed plan, hence no atom is ever relevant
+	long evaluate(const State& state, std::vector<Atom>& relevant) const { return evaluate(state); }
+
+	//! The number of goal atoms, i.e. the maximum value the heuristic can take
+	unsigned num_atoms() const { return _formula_atoms.size(); }
+
 protected:
 	const std::vector<std::shared_ptr<const fs::Formula>> _formula_atoms;
 };
@@ -0,0 +1,159 @@
+
+#include <cmath>
+
+#include <fs/core/languages/fstrips/bytecode.hxx>
+#include <fs/core/languages/fstrips/formulae.hxx>
+#include <fs/core/languages/fstrips/terms.hxx>
+#include <fs/core/problem_info.hxx>
+#include <fs/core/state.hxx>
+
+
+namespace fs0 { namespace language { namespace fstrips {
+
+FormulaProgram::FormulaProgram(const Formula* formula) :
+	_code(), _constants(), _operands(), _terms(), _formulas(), _num_registers(0)
+{
+	compile(formula);
+}
+
+void
+FormulaProgram::compile(const Formula* formula) {
+	if (dynamic_cast<const Tautology*>(formula)) return;
+
+	if (dynamic_cast<const Contradiction*>(formula)) {
+		_code.push_back({OpCode::Fail, Comparison::EQ, 0, 0, 0, 0});
+		return;
+	}
+
+	if (const auto* conjunction = dynamic_cast<const Conjunction*>(formula)) {
+		for (const Formula* conjunct:conjunction->getSubformulae()) compile(conjunct);
+		return;
+	}
+
+	if (const auto* relational = dynamic_cast<const RelationalFormula*>(formula)) {
+		uint32_t lhs = compile(relational->lhs());
+		uint32_t rhs = compile(relational->rhs());
+		auto cmp = static_cast<Comparison>(relational->symbol()); // Both enums list the operators in the same order
+		_code.push_back({OpCode::Test, cmp, 0, (uint32_t) _formulas.size(), lhs, rhs});
+		_formulas.push_back(formula);
+		return;
+	}
+
+	_code.push_back({OpCode::Formula, Comparison::EQ, 0, 0, (uint32_t) _formulas.size(), 0});
+	_formulas.push_back(formula);
+}
+
+uint32_t
+FormulaProgram::compile(const Term* term) {
+	if (const auto* constant = dynamic_cast<const Constant*>(term)) {
+		_code.push_back({OpCode::Constant, Comparison::EQ, 0, _num_registers, (uint32_t) _constants.size(), 0});
+		_constants.push_back(constant->getValue());
+		return _num_registers++;
+	}
+
+	if (const auto* variable = dynamic_cast<const StateVariable*>(term)) {
+		_code.push_back({OpCode::Variable, Comparison::EQ, 0, _num_registers, (uint32_t) variable->getValue(), 0});
+		return _num_registers++;
+	}
+
+	const auto* fluent = dynamic_cast<const FluentHeadedNestedTerm*>(term);
+	const auto* user_defined = dynamic_cast<const UserDefinedStaticTerm*>(term);
+	if (fluent || user_defined) {
+		const auto* nested = static_cast<const NestedTerm*>(term);
+		std::vector<uint32_t> arguments;
+		for (const Term* subterm:nested->getSubterms()) arguments.push_back(compile(subterm));
+
+		OpCode op = fluent ? OpCode::Fluent : OpCode::Static;
+		_code.push_back({op, Comparison::EQ, (uint16_t) arguments.size(), _num_registers, nested->getSymbolId(), (uint32_t) _operands.size()});
+		_operands.insert(_operands.end(), arguments.begin(), arguments.end());
+		return _num_registers++;
+	}
+
+	_code.push_back({OpCode::Term, Comparison::EQ, 0, _num_registers, (uint32_t) _terms.size(), 0});
+	_terms.push_back(term);
+	return _num_registers++;
+}
+
+bool
+FormulaProgram::satisfied(const State& state) const {
+	thread_local std::vector<object_id> registers;
+	thread_local std::vector<object_id> arguments;
+	if (registers.size() < _num_registers) registers.resize(_num_registers);
+
+	for (const InstructionT& ins:_code) {
+		switch (ins.op) {
+			case OpCode::Constant:
+				registers[ins.dst] = _constants[ins.a];
+				break;
+
+			case OpCode::Variable:
+				registers[ins.dst] = state.getValue(ins.a);
+				break;
+
+			case OpCode::Fluent:
+			case OpCode::Static: {
+				const ProblemInfo& info = ProblemInfo::getInstance();
+				arguments.resize(ins.n);
+				for (uint16_t i = 0; i < ins.n; ++i) arguments[i] = registers[_operands[ins.b + i]];
+				if (ins.op == OpCode::Fluent) registers[ins.dst] = state.getValue(info.resolveStateVariable(ins.a, arguments));
+				else registers[ins.dst] = info.getSymbolData(ins.a).evaluate(arguments);
+				break;
+			}
+
+			case OpCode::Term:
+				registers[ins.dst] = _terms[ins.a]->interpret(state);
+				break;
+
+			case OpCode::Test:
+				if (!test(ins.cmp, registers[ins.a], registers[ins.b], _formulas[ins.dst], state)) return false;
+				break;
+
+			case OpCode::Formula:
+				if (!_formulas[ins.a]->interpret(state)) return false;
+				break;
+
+			case OpCode::Fail:
+				return false;
+		}
+	}
+	return true;
+}
+
+bool
+FormulaProgram::test(Comparison cmp, const object_id& lhs, const object_id& rhs, const Formula* formula, const State& state) {
+	const type_id t = lhs.type();
+
+	if (t == rhs.type()) {
+		if (t == type_id::object_t || t == type_id::bool_t) {
+			if (cmp == Comparison::EQ) return lhs == rhs;
+			if (cmp == Comparison::NEQ) return lhs != rhs;
+
+		} else if (t == type_id::int_t) {
+			int l = fs0::value<int>(lhs), r = fs0::value<int>(rhs);
+			switch (cmp) {
+				case Comparison::EQ: return l == r;
+				case Comparison::NEQ: return l != r;
+				case Comparison::LT: return l < r;
+				case Comparison::LEQ: return l <= r;
+				case Comparison::GT: return l > r;
+				case Comparison::GEQ: return l >= r;
+			}
+
+		} else if (t == type_id::float_t) {
+			float l = fs0::value<float>(lhs), r = fs0::value<float>(rhs);
+			switch (cmp) {
+				case Comparison::EQ: return std::fabs(l - r) <= RelationalFormula::FP_TOLERANCE;
+				case Comparison::NEQ: return std::fabs(l - r) > RelationalFormula::FP_TOLERANCE;
+				case Comparison::LT: return l < r;
+				case Comparison::LEQ: return l <= r;
+				case Comparison::GT: return l > r;
+				case Comparison::GEQ: return l >= r;
+			}
+		}
+	}
+
+	// Type mismatches and unsupported operators are left to the AST, which reports them appropriately
+	return formula->interpret(state);
+}
+
+} } } // namespaces
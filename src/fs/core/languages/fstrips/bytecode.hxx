@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <fs/core/languages/fstrips/language_fwd.hxx>
+#include <fs/core/fs_types.hxx>
+
+namespace fs0 { class State; }
+
+namespace fs0 { namespace language { namespace fstrips {
+
+//! A (ground) formula compiled into a flat, register-based program, which can be evaluated on a state without
+//! the recursive, virtual walk over the formula AST. The program is a straight sequence of instructions:
+//! term instructions load some value into a register (a constant, the value of a state variable, or the value of a
+//! nested term on the values of the registers of its subterms), and test instructions check some relational atom on
+//! two registers and make the whole formula false, if the atom does not hold. Conjunctions are thus flattened into
+//! their atoms, which are evaluated in order until one of them fails, as in the AST.
+//! Formulas and terms that the program does not support natively (e.g. quantified formulas, disjunctions,
+//! arithmetic terms) are evaluated through the AST, by means of dedicated fallback instructions.
+//! Programs are immutable and keep all scratch data in per-thread buffers, so that they can be evaluated concurrently.
+//! The AST of the formula must outlive the program.
+class FormulaProgram {
+public:
+	explicit FormulaProgram(const Formula* formula);
+
+	FormulaProgram(const FormulaProgram&) = default;
+	FormulaProgram(FormulaProgram&&) = default;
+	FormulaProgram& operator=(const FormulaProgram&) = default;
+	FormulaProgram& operator=(FormulaProgram&&) = default;
+
+	//! Return true iff the formula holds in the given state
+	bool satisfied(const State& state) const;
+
+	//! The number of instructions of the program
+	std::size_t size() const { return _code.size(); }
+
+protected:
+	enum class OpCode : uint8_t {
+		Constant,  // r[dst] = constants[a]
+		Variable,  // r[dst] = state[a]
+		Fluent,    // r[dst] = state[variable of symbol 'a' on the 'n' registers listed at operands[b]]
+		Static,    // r[dst] = static symbol 'a' on the 'n' registers listed at operands[b]
+		Term,      // r[dst] = terms[a], interpreted through the AST
+		Test,      // fail unless relational atom formulas[dst] holds on registers a and b
+		Formula,   // fail unless formulas[a], interpreted through the AST, holds
+		Fail       // fail
+	};
+
+	enum class Comparison : uint8_t {EQ, NEQ, LT, LEQ, GT, GEQ};
+
+	struct InstructionT {
+		OpCode op;
+		Comparison cmp;
+		uint16_t n;
+		uint32_t dst;
+		uint32_t a;
+		uint32_t b;
+	};
+
+	std::vector<InstructionT> _code;
+
+	std::vector<object_id> _constants;
+
+	//! The registers that hold the arguments of nested terms
+	std::vector<uint32_t> _operands;
+
+	//! The AST nodes of the fallback instructions, and the relational atoms of the test instructions
+	std::vector<const Term*> _terms;
+	std::vector<const Formula*> _formulas;
+
+	uint32_t _num_registers;
+
+	void compile(const Formula* formula);
+	uint32_t compile(const Term* term);
+
+	//! Evaluate the relational atom 'formula' on the given values
+	static bool test(Comparison cmp, const object_id& lhs, const object_id& rhs, const Formula* formula, const State& state);
+};
+
+} } } // namespaces
@@ -32,13 +32,15 @@ AtomicFormula::~AtomicFormula() {
 AtomicFormula* AtomicFormula::clone() const { return clone(Utils::clone(_subterms)); }
 
 bool AtomicFormula::interpret(const PartialAssignment& assignment, Binding& binding) const {
-	NestedTerm::interpret_subterms(_subterms, assignment, binding, _interpreted_subterms);
-	return _satisfied(_interpreted_subterms);
+	SubtermBuffer subterms(_subterms.size());
+	NestedTerm::interpret_subterms(_subterms, assignment, binding, subterms.values());
+	return _satisfied(subterms.values());
 }
 
 bool AtomicFormula::interpret(const State& state, Binding& binding) const {
-	NestedTerm::interpret_subterms(_subterms, state, binding, _interpreted_subterms);
-	return _satisfied(_interpreted_subterms);
+	SubtermBuffer subterms(_subterms.size());
+	NestedTerm::interpret_subterms(_subterms, state, binding, subterms.values());
+	return _satisfied(subterms.values());
 }
 
 type_id RelationalFormula::
@@ -121,8 +123,9 @@ bool AxiomaticFormula::interpret(const PartialAssignment& assignment, Binding& b
 }
 
 bool AxiomaticFormula::interpret(const State& state, Binding& binding) const {
-	NestedTerm::interpret_subterms(_subterms, state, binding, _interpreted_subterms);
-	return compute(state, _interpreted_subterms);
+	SubtermBuffer subterms(_subterms.size());
+	NestedTerm::interpret_subterms(_subterms, state, binding, subterms.values());
+	return compute(state, subterms.values());
 }
 
 
@@ -53,7 +53,7 @@ class AtomicFormula : public Formula {
 public:
 	LOKI_DEFINE_CONST_VISITABLE()
 
-	AtomicFormula(const std::vector<const Term*>& subterms) : _subterms(subterms), _interpreted_subterms(subterms.size(), object_id::INVALID) {}
+	AtomicFormula(const std::vector<const Term*>& subterms) : _subterms(subterms) {}
 
 	virtual ~AtomicFormula();
 
@@ -75,9 +75,6 @@ public:
 protected:
 	//! The formula subterms
 	std::vector<const Term*> _subterms;
-
-	//! The last interpretation of the subterms (acts as a cache)
-	mutable std::vector<object_id> _interpreted_subterms;
 };
 
 class ExternallyDefinedFormula : public AtomicFormula {
@@ -20,8 +20,7 @@ object_id Term::interpret(const State& state) const  { return interpret(state, B
 
 NestedTerm::NestedTerm(const NestedTerm& term) :
 	_symbol_id(term._symbol_id),
-	_subterms(Utils::clone(term._subterms)),
-	_interpreted_subterms(term._interpreted_subterms)
+	_subterms(Utils::clone(term._subterms))
 {}
 
 UserDefinedStaticTerm::UserDefinedStaticTerm(unsigned symbol_id, const std::vector<const Term*>& subterms)
@@ -42,17 +41,19 @@ AxiomaticTermWrapper::AxiomaticTermWrapper(const AxiomaticTermWrapper& other) :
 {}
 
 object_id AxiomaticTermWrapper::interpret(const PartialAssignment& assignment, const Binding& binding) const {
-	NestedTerm::interpret_subterms(_subterms, assignment, binding, _interpreted_subterms);
+	SubtermBuffer subterms(_subterms.size());
+	NestedTerm::interpret_subterms(_subterms, assignment, binding, subterms.values());
 
 	// The binding to interpret the inner condition of the axiom is independent, i.e. axioms need to be sentences
 	Binding axiom_binding;
-	_axiom->getBindingUnit().update_binding(axiom_binding, _interpreted_subterms);
+	_axiom->getBindingUnit().update_binding(axiom_binding, subterms.values());
 	bool res = _axiom->getDefinition()->interpret(assignment, axiom_binding);
 	return make_object<int>(res); // The hack: transform the bool into an int
 }
 
 object_id AxiomaticTermWrapper::interpret(const State& state, const Binding& binding) const {
-	NestedTerm::interpret_subterms(_subterms, state, binding, _interpreted_subterms);
+	SubtermBuffer subterms(_subterms.size());
+	NestedTerm::interpret_subterms(_subterms, state, binding, subterms.values());
 
 	// The binding to interpret the inner condition of the axiom is independent, i.e. axioms need to be sentences
 	Binding axiom_binding;
@@ -72,19 +73,22 @@ AxiomaticTerm* AxiomaticTerm::clone() const { return clone(Utils::clone(_subterm
 
 
 object_id UserDefinedStaticTerm::interpret(const PartialAssignment& assignment, const Binding& binding) const {
-	interpret_subterms(_subterms, assignment, binding, _interpreted_subterms);
-	return _function.getFunction()(_interpreted_subterms);
+	SubtermBuffer subterms(_subterms.size());
+	interpret_subterms(_subterms, assignment, binding, subterms.values());
+	return _function.evaluate(subterms.values());
 }
 
 object_id UserDefinedStaticTerm::interpret(const State& state, const Binding& binding) const {
-	interpret_subterms(_subterms, state, binding, _interpreted_subterms);
-	return _function.getFunction()(_interpreted_subterms);
+	SubtermBuffer subterms(_subterms.size());
+	interpret_subterms(_subterms, state, binding, subterms.values());
+	return _function.evaluate(subterms.values());
 }
 
 
 object_id AxiomaticTerm::interpret(const State& state, const Binding& binding) const {
-	interpret_subterms(_subterms, state, binding, _interpreted_subterms);
-	return compute(state, _interpreted_subterms);
+	SubtermBuffer subterms(_subterms.size());
+	interpret_subterms(_subterms, state, binding, subterms.values());
+	return compute(state, subterms.values());
 }
 
 
@@ -99,8 +103,8 @@ object_id FluentHeadedNestedTerm::interpret(const State& state, const Binding& b
 
 object_id StateVariable::interpret(const State& state, const Binding& binding) const {
 	#ifdef DEBUG
-	const ProblemInfo& info = ProblemInfo::getInstance();
-	assert( info.sv_type(_variable_id) == o_type(state.getValue(_variable_id)) );
+	// The layout of the state knows the type of each variable, so there is no need to look it up in the ProblemInfo
+	assert( state.indexer().field(_variable_id).type == o_type(state.getValue(_variable_id)) );
 	#endif
 	return state.getValue(_variable_id);
 }
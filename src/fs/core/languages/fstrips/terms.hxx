@@ -1,6 +1,8 @@
 
 #pragma once
 
+#include <deque>
+
 #include <fs/core/languages/fstrips/base.hxx>
 #include <fs/core/fs_types.hxx>
 
@@ -27,6 +29,45 @@ public:
 	std::ostream& print(std::ostream& os, const ProblemInfo& info) const override;
 };
 
+//! A scratch buffer where to interpret the subterms of some nested term or atomic formula.
+//! Buffers are taken from a per-thread stack, since interpretation is recursive and each nesting level
+//! needs its own buffer; buffers are reused across interpretations to avoid memory allocations.
+//! This keeps the interpretation of terms and formulae reentrant, so that it can be run concurrently.
+class SubtermBuffer {
+public:
+	explicit SubtermBuffer(std::size_t size) : _values(acquire(size)) {}
+	~SubtermBuffer() { --stack().depth; }
+
+	SubtermBuffer(const SubtermBuffer&) = delete;
+	SubtermBuffer(SubtermBuffer&&) = delete;
+	SubtermBuffer& operator=(const SubtermBuffer&) = delete;
+	SubtermBuffer& operator=(SubtermBuffer&&) = delete;
+
+	std::vector<object_id>& values() { return _values; }
+
+protected:
+	struct StackT {
+		//! A deque, so that growing the stack does not invalidate buffers in use
+		std::deque<std::vector<object_id>> buffers;
+		std::size_t depth = 0;
+	};
+
+	static StackT& stack() {
+		thread_local StackT s;
+		return s;
+	}
+
+	static std::vector<object_id>& acquire(std::size_t size) {
+		StackT& s = stack();
+		if (s.depth == s.buffers.size()) s.buffers.emplace_back();
+		std::vector<object_id>& buffer = s.buffers[s.depth++];
+		buffer.resize(size);
+		return buffer;
+	}
+
+	std::vector<object_id>& _values;
+};
+
 //! A nested logical term in FSTRIPS, i.e. a term of the form f(t_1, ..., t_n)
 //! The class is abstract and intended to have two possible subclasses, depending on whether
 //! the functional symbol 'f' is fluent or not.
@@ -35,7 +76,7 @@ public:
 	LOKI_DEFINE_CONST_VISITABLE();
 
 	NestedTerm(unsigned symbol_id, const std::vector<const Term*>& subterms)
-		: _symbol_id(symbol_id), _subterms(subterms), _interpreted_subterms(subterms.size(), object_id::INVALID)
+		: _symbol_id(symbol_id), _subterms(subterms)
 	{}
 
 	~NestedTerm() {
@@ -72,9 +113,6 @@ protected:
 	//! The tuple of fixed, constant symbols of the state variable, e.g. {A, B} in the state variable 'on(A,B)'
 	// TODO This should be const
 	std::vector<const Term*> _subterms;
-	
-	//! The last interpretation of the subterms (acts as a cache)
-	mutable std::vector<object_id> _interpreted_subterms;
 };
 
 
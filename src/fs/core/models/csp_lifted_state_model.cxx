@@ -8,6 +8,7 @@
 #include <fs/core/languages/fstrips/language.hxx>
 #include <fs/core/models/utils.hxx>
 #include <fs/core/problem.hxx>
+#include <fs/core/search/cancellation.hxx>
 #include <fs/core/state.hxx>
 #include <fs/core/utils/system.hxx>
 
@@ -32,9 +33,17 @@ CSPLiftedStateModel::CSPLiftedStateModel(
     _subgoals(std::move(subgoals)),
     schemas(std::move(schemas)),
     lifted_operators(std::move(lifted_operators)),
+    effect_programs(),
     schema_csps(std::move(schema_csps)),
     extension_generator(std::move(extension_generator))
-{}
+{
+    const ProblemInfo& info = ProblemInfo::getInstance();
+    EffectProgram::TableStore tables;
+    effect_programs.reserve(this->lifted_operators.size());
+    for (const auto& op:this->lifted_operators) {
+        effect_programs.emplace_back(op, info, tables);
+    }
+}
 
 CSPLiftedStateModel::~CSPLiftedStateModel() = default;
 
@@ -51,16 +60,16 @@ bool CSPLiftedStateModel::goal(const State& state) const {
 }
 
 
-State CSPLiftedStateModel::next(const State& state, const LiftedActionID& aid) const {
+State CSPLiftedStateModel::next(const State& state, const LiftedActionID& aid, ExpansionContext& context) const {
     auto& adata = aid.getActionData();
-    auto& op = lifted_operators[adata.getId()];
     // Note that we don't need to check the precondition of the operator, only evaluate the effects:
-    evaluate_simple_lifted_operator(state, op, aid.get_binding(), ProblemInfo::getInstance(), false, _effects_cache);
-    return State(state, _effects_cache); // Copy everything into the new state and apply the changeset
+    effect_programs[adata.getId()].run(state, aid.get_binding(), context.changeset());
+    return State(state, context.changeset()); // Copy everything into the new state and apply the changeset
 }
 
-gecode::CSPActionIterator CSPLiftedStateModel::applicable_actions(const State& state, bool enforce_state_constraints) const {
+gecode::CSPActionIterator CSPLiftedStateModel::applicable_actions(const State& state, bool enforce_state_constraints, ExpansionContext& context) const {
     // TODO At the moment we don't support state constraints anymore
+    Cancellation::check();
     return gecode::CSPActionIterator(state, schema_csps, extension_generator.instantiate(state), schemas);
 }
 
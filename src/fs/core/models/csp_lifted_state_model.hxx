@@ -3,7 +3,9 @@
 
 #include <fs/core/actions/csp_action_iterator.hxx>
 #include <fs/core/actions/simple_lifted_operators.hxx>
+#include <fs/core/actions/effect_program.hxx>
 #include <fs/core/constraints/gecode/v2/extensions.hxx>
+#include <fs/core/models/expansion_context.hxx>
 
 
 namespace fs0::gecode { class LiftedActionCSP; }
@@ -51,14 +53,15 @@ public:
 	//! Returns true if state is a goal state
 	bool goal(const State& state) const;
 
-	//! Returns applicable action set object
-	gecode::CSPActionIterator applicable_actions(const State& state, bool enforce_state_constraints) const;
-	gecode::CSPActionIterator applicable_actions(const State& state) const {
-		return applicable_actions(state, true);
+	//! Returns applicable action set object, using the given context (by default, that of the calling thread) as scratch space
+	gecode::CSPActionIterator applicable_actions(const State& state, bool enforce_state_constraints, ExpansionContext& context = ExpansionContext::local()) const;
+	gecode::CSPActionIterator applicable_actions(const State& state, ExpansionContext& context = ExpansionContext::local()) const {
+		return applicable_actions(state, true, context);
 	}
 
-	//! Returns the state resulting from applying the given action action on the given state
-	State next(const State& state, const ActionType& aid) const;
+	//! Returns the state resulting from applying the given action action on the given state,
+	//! using the given context (by default, that of the calling thread) as scratch space
+	State next(const State& state, const ActionType& aid, ExpansionContext& context = ExpansionContext::local()) const;
 
 	const Problem& getTask() const { return problem; }
 
@@ -68,8 +71,9 @@ public:
 	//! Returns true iff the given state satisfies the i-th subgoal
 	bool goal(const StateT& s, unsigned i) const;
 
-	const std::vector<Atom>& get_last_changeset() const {
-		return _effects_cache;
+	//! The atoms made true by the last action applied through the given context
+	const std::vector<Atom>& get_last_changeset(const ExpansionContext& context = ExpansionContext::local()) const {
+		return context.changeset();
 	}
 
 protected:
@@ -82,12 +86,12 @@ protected:
 
     std::vector<SimpleLiftedOperator> lifted_operators;
 
+    //! effect_programs[i] computes the effects of the i-th lifted operator
+    std::vector<EffectProgram> effect_programs;
+
     std::vector<gecode::v2::ActionSchemaCSP> schema_csps;
 
     gecode::v2::SymbolExtensionGenerator extension_generator;
-
-	//! A cache to hold the effects of the last-applied action and avoid memory allocations.
-	mutable std::vector<Atom> _effects_cache;
 };
 
 } // namespaces
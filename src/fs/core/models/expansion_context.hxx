@@ -0,0 +1,44 @@
+#pragma once
+
+#include <vector>
+
+#include <fs/core/atom.hxx>
+#include <fs/core/utils/sdd.hxx>
+
+namespace fs0 {
+
+//! The scratch data that a state model needs to compute applicable actions and generate successor states, e.g. the effects
+//! of the last applied action.
+//! State models keep no such data of their own, so that one single model can be used concurrently from different threads,
+//! as long as each of them passes its own context. The methods of the models that take no explicit context use the
+//! default context of the calling thread.
+class ExpansionContext {
+public:
+	ExpansionContext() = default;
+	~ExpansionContext() = default;
+
+	ExpansionContext(const ExpansionContext&) = delete;
+	ExpansionContext& operator=(const ExpansionContext&) = delete;
+	ExpansionContext(ExpansionContext&&) = default;
+	ExpansionContext& operator=(ExpansionContext&&) = default;
+
+	//! The atoms made true by the last action applied through this context
+	std::vector<Atom>& changeset() { return _changeset; }
+	const std::vector<Atom>& changeset() const { return _changeset; }
+
+	//! The conditionings of the action-schema SDDs on the last state whose applicable actions were computed through this
+	//! context, one per schema of the SDD state model
+	std::vector<SDDConditioning>& sdd_conditionings() { return _sdd_conditionings; }
+
+	//! The default context of the calling thread
+	static ExpansionContext& local() {
+		thread_local ExpansionContext context;
+		return context;
+	}
+
+protected:
+	std::vector<Atom> _changeset;
+	std::vector<SDDConditioning> _sdd_conditionings;
+};
+
+} // namespaces
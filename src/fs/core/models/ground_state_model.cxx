@@ -4,6 +4,9 @@
 #include <fs/core/problem.hxx>
 #include <fs/core/state.hxx>
 #include <fs/core/applicability/formula_interpreter.hxx>
+#include <fs/core/utils/thread_pool.hxx>
+#include <fs/core/actions/strips_table.hxx>
+#include <fs/core/search/cancellation.hxx>
 
 namespace fs0 {
 
@@ -22,16 +25,40 @@ bool GroundStateModel::goal(const State& state) const {
 	return _task.getGoalSatManager().satisfied(state);
 }
 
-State GroundStateModel::next(const State& state, const GroundAction::IdType& actionIdx) const {
-	return next(state, *(_task.getGroundActions()[actionIdx]));
+State GroundStateModel::next(const State& state, const GroundAction::IdType& actionIdx, ExpansionContext& context) const {
+	return next(state, *(_task.getGroundActions()[actionIdx]), context);
 }
 
-State GroundStateModel::next(const State& state, const GroundAction& a) const {
-	NaiveApplicabilityManager::computeEffects(state, a, _effects_cache);
-	return State(state, _effects_cache); // Copy everything into the new state and apply the changeset
+State GroundStateModel::next(const State& state, const GroundAction& a, ExpansionContext& context) const {
+	const StripsActionTable* strips = _task.getStripsActionTable();
+	// The table is indexed by the IDs of the ground actions of the problem, which 'a' might not be one of
+	if (strips && strips->covers(a.getId()) && _task.getGroundActions()[a.getId()] == &a) {
+		return strips->next(a.getId(), state, context.changeset());
+	}
+	NaiveApplicabilityManager::computeEffects(state, a, context.changeset());
+	return State(state, context.changeset()); // Copy everything into the new state and apply the changeset
 }
 
-GroundApplicableSet GroundStateModel::applicable_actions(const State& state, bool enforce_state_constraints) const {
+void GroundStateModel::expand(const State& state, std::vector<SuccessorT>& successors, bool enforce_state_constraints) const {
+	ExpansionContext& context = ExpansionContext::local();
+	Cancellation::check();
+	const auto& actions = _task.getGroundActions();
+	for (ActionId id:_manager->applicable(state, enforce_state_constraints)) {
+		successors.emplace_back(id, next(state, *actions[id], context));
+	}
+}
+
+void GroundStateModel::expand(const std::vector<const State*>& states, std::vector<std::vector<SuccessorT>>& successors, ThreadPool& pool, bool enforce_state_constraints) const {
+	successors.resize(states.size());
+	pool.parallel_for(states.size(), [&](std::size_t i, unsigned) {
+		successors[i].clear();
+		expand(*states[i], successors[i], enforce_state_constraints);
+	});
+}
+
+GroundApplicableSet GroundStateModel::applicable_actions(const State& state, bool enforce_state_constraints, ExpansionContext& context) const {
+	// The action managers already keep their scratch data per thread
+	Cancellation::check();
 	return _manager->applicable(state, enforce_state_constraints);
 }
 
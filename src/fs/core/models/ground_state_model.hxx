@@ -4,11 +4,14 @@
 #include <lapkt/search/interfaces/det_state_model.hxx>
 #include <fs/core/actions/actions.hxx>
 #include <fs/core/applicability/base.hxx>
+#include <fs/core/models/expansion_context.hxx>
+#include <fs/core/models/successor.hxx>
 
 namespace fs0 {
 
 class Problem;
 class State;
+class ThreadPool;
 
 class GroundStateModel { // : public aptk::DetStateModel<State, GroundAction> {
 public:
@@ -17,6 +20,7 @@ public:
 	//using ActionType = BaseT::ActionType;
 	using ActionType = GroundAction;
 	using ActionId = ActionType::IdType;
+	using SuccessorT = Successor<ActionId>;
 
 	explicit GroundStateModel(const Problem& problem);
 	~GroundStateModel() = default;
@@ -32,23 +36,32 @@ public:
 	//! Returns true if state is a goal state
 	bool goal(const State& state) const;
 
-	//! Returns applicable action set object
-	GroundApplicableSet applicable_actions(const State& state, bool enforce_state_constraints) const;
-	GroundApplicableSet applicable_actions(const State& state) const {
-		return applicable_actions(state,true);
+	//! Returns applicable action set object, using the given context (by default, that of the calling thread) as scratch space
+	GroundApplicableSet applicable_actions(const State& state, bool enforce_state_constraints, ExpansionContext& context = ExpansionContext::local()) const;
+	GroundApplicableSet applicable_actions(const State& state, ExpansionContext& context = ExpansionContext::local()) const {
+		return applicable_actions(state, true, context);
 	}
 
 
-	//! Returns the state resulting from applying the given action action on the given state
-	State next(const State& state, const GroundAction::IdType& id) const;
-	State next(const State& state, const GroundAction& a) const;
+	//! Append to 'successors' all the successors of the given state, i.e. one successor for each applicable action.
+	void expand(const State& state, std::vector<SuccessorT>& successors, bool enforce_state_constraints = true) const;
+
+	//! Expand all the given states in parallel with the given pool of threads.
+	//! 'successors[i]' will contain the successors of 'states[i]', in the same order than the sequential 'expand' gives them.
+	void expand(const std::vector<const State*>& states, std::vector<std::vector<SuccessorT>>& successors, ThreadPool& pool, bool enforce_state_constraints = true) const;
+
+	//! Returns the state resulting from applying the given action action on the given state,
+	//! using the given context (by default, that of the calling thread) as scratch space
+	State next(const State& state, const GroundAction::IdType& id, ExpansionContext& context = ExpansionContext::local()) const;
+	State next(const State& state, const GroundAction& a, ExpansionContext& context = ExpansionContext::local()) const;
 
 	const Problem& getTask() const { return _task; }
 
 	static ActionManagerI* build_action_manager(const Problem& problem);
 
-	const std::vector<Atom>& get_last_changeset() const {
-		return _effects_cache;
+	//! The atoms made true by the last action applied through the given context
+	const std::vector<Atom>& get_last_changeset(const ExpansionContext& context = ExpansionContext::local()) const {
+		return context.changeset();
 	}
 
 protected:
@@ -56,9 +69,6 @@ protected:
 	const Problem& _task;
 
 	std::unique_ptr<ActionManagerI> _manager;
-
-	//! A cache to hold the effects of the last-applied action and avoid memory allocations.
-	mutable std::vector<Atom> _effects_cache;
 };
 
 } // namespaces
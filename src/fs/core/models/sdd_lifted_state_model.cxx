@@ -9,6 +9,7 @@
 #include <fs/core/languages/fstrips/language.hxx>
 #include <utility>
 #include <fs/core/utils/config.hxx>
+#include <fs/core/search/cancellation.hxx>
 
 #include <lapkt/tools/logging.hxx>
 #include "utils.hxx"
@@ -28,27 +29,34 @@ namespace fs0 {
     }
 
 
-    State SDDLiftedStateModel::next(const State& state, const LiftedActionID& action) const {
+    State SDDLiftedStateModel::next(const State& state, const LiftedActionID& action, ExpansionContext& context) const {
+        unsigned schema = action.getActionData().getId();
+        if (_compiled[schema]) {
+            _programs[schema].run(state, action.get_binding(), context.changeset());
+            return State(state, context.changeset());
+        }
+
         auto ground_action = action.generate();
-        auto s1 = next(state, *ground_action);
+        auto s1 = next(state, *ground_action, context);
         delete ground_action;
         return s1;
     }
 
-    State SDDLiftedStateModel::next(const State& state, const GroundAction& action) const {
+    State SDDLiftedStateModel::next(const State& state, const GroundAction& action, ExpansionContext& context) const {
 //	NaiveApplicabilityManager manager(_task.getStateConstraints()); // UNUSED
-        NaiveApplicabilityManager::computeEffects(state, action, _effects_cache);
-        return State(state, _effects_cache); // Copy everything into the new state and apply the changeset
+        NaiveApplicabilityManager::computeEffects(state, action, context.changeset());
+        return State(state, context.changeset()); // Copy everything into the new state and apply the changeset
     }
 
 
-    SDDActionIterator SDDLiftedStateModel::applicable_actions(const State& state) const {
-        return {state, sdds_, _task.get_tuple_index()};
+    SDDActionIterator SDDLiftedStateModel::applicable_actions(const State& state, ExpansionContext& context) const {
+        Cancellation::check();
+        return {state, sdds_, _task.get_tuple_index(), context};
     }
 
-    SDDActionIterator SDDLiftedStateModel::applicable_actions(const State& state, bool enforce_state_constraints) const {
+    SDDActionIterator SDDLiftedStateModel::applicable_actions(const State& state, bool enforce_state_constraints, ExpansionContext& context) const {
         // We know (see constructor) that there are no state constraints
-        return applicable_actions(state);
+        return applicable_actions(state, context);
     }
 
 
@@ -65,14 +73,34 @@ namespace fs0 {
     SDDLiftedStateModel::build(const Problem& problem) {
         const ProblemInfo& info = ProblemInfo::getInstance();
         auto sdds = load_sdds_from_disk(problem.getPartiallyGroundedActions(), info.getDataDir() + "/sdd");
-        auto model = SDDLiftedStateModel(problem, sdds, obtain_goal_atoms(problem.getGoalConditions()));
+
+        // Compile the effects of each schema, if possible
+        std::vector<EffectProgram> programs;
+        std::vector<bool> compiled;
+        EffectProgram::TableStore tables;
+        for (const auto schema:problem.getPartiallyGroundedActions()) {
+            assert(schema->getActionData().getId() == programs.size());
+            try {
+                programs.emplace_back(compile_schema_to_simple_lifted_operator(*schema), info, tables);
+                compiled.push_back(true);
+            } catch (const std::runtime_error& e) {
+                LPT_INFO("cout", "Effects of action schema \"" << schema->getName() << "\" will be computed by grounding. Reason: " << e.what());
+                programs.emplace_back(SimpleLiftedOperator(), info, tables);
+                compiled.push_back(false);
+            }
+        }
+
+        auto model = SDDLiftedStateModel(problem, sdds, obtain_goal_atoms(problem.getGoalConditions()), std::move(programs), std::move(compiled));
         return model;
     }
 
-    SDDLiftedStateModel::SDDLiftedStateModel(const Problem& problem, std::vector<std::shared_ptr<ActionSchemaSDD>> sdds, std::vector<const fs::Formula*> subgoals) :
+    SDDLiftedStateModel::SDDLiftedStateModel(const Problem& problem, std::vector<std::shared_ptr<ActionSchemaSDD>> sdds, std::vector<const fs::Formula*> subgoals,
+                                             std::vector<EffectProgram>&& programs, std::vector<bool>&& compiled) :
             _task(problem),
             sdds_(std::move(sdds)),
-            _subgoals(std::move(subgoals))
+            _subgoals(std::move(subgoals)),
+            _programs(std::move(programs)),
+            _compiled(std::move(compiled))
     {
         // At the moment we just ignore the state constraints. TODO We should do better error handling,
         // but all of this state constraint code is bound to be refactored soon.
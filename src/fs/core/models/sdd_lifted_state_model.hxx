@@ -3,7 +3,9 @@
 
 #include <fs/core/atom.hxx>
 #include <fs/core/actions/action_id.hxx>
+#include <fs/core/actions/effect_program.hxx>
 #include <fs/core/actions/sdd_action_iterator.hxx>
+#include <fs/core/models/expansion_context.hxx>
 #include <fs/core/utils/sdd.hxx>
 
 
@@ -24,7 +26,8 @@ public:
 	using ActionType = LiftedActionID;
 
 protected:
-	SDDLiftedStateModel(const Problem& problem, std::vector<std::shared_ptr<ActionSchemaSDD>> sdds, std::vector<const fs::Formula*> subgoals);
+	SDDLiftedStateModel(const Problem& problem, std::vector<std::shared_ptr<ActionSchemaSDD>> sdds, std::vector<const fs::Formula*> subgoals,
+	                    std::vector<EffectProgram>&& programs, std::vector<bool>&& compiled);
 
 public:
 
@@ -44,14 +47,16 @@ public:
 	//! Returns true if state is a goal state
 	bool goal(const State& state) const;
 
-	//! Returns applicable action set object
-	SDDActionIterator applicable_actions(const State& state) const;
-    SDDActionIterator applicable_actions(const State& state, bool enforce_state_constraints) const;
+	//! Returns applicable action set object, using the given context (by default, that of the calling thread) to keep the
+	//! conditionings of the schema SDDs on the state. The context must outlive the iteration.
+	SDDActionIterator applicable_actions(const State& state, ExpansionContext& context = ExpansionContext::local()) const;
+    SDDActionIterator applicable_actions(const State& state, bool enforce_state_constraints, ExpansionContext& context = ExpansionContext::local()) const;
 
 
-	//! Returns the state resulting from applying the given action action on the given state
-	State next(const State& state, const ActionType& action) const;
-	State next(const State& state, const GroundAction& a) const;
+	//! Returns the state resulting from applying the given action action on the given state,
+	//! using the given context (by default, that of the calling thread) as scratch space
+	State next(const State& state, const ActionType& action, ExpansionContext& context = ExpansionContext::local()) const;
+	State next(const State& state, const GroundAction& a, ExpansionContext& context = ExpansionContext::local()) const;
 
 
 	const Problem& getTask() const { return _task; }
@@ -62,8 +67,9 @@ public:
 	//! Returns true iff the given state satisfies the i-th subgoal
 	bool goal(const StateT& s, unsigned i) const;
 
-	const std::vector<Atom>& get_last_changeset() const {
-		return _effects_cache;
+	//! The atoms made true by the last action applied through the given context
+	const std::vector<Atom>& get_last_changeset(const ExpansionContext& context = ExpansionContext::local()) const {
+		return context.changeset();
 	}
 
 protected:
@@ -74,8 +80,10 @@ protected:
 
 	const std::vector<const fs::Formula*> _subgoals;
 
-	//! A cache to hold the effects of the last-applied action and avoid memory allocations.
-	mutable std::vector<Atom> _effects_cache;
+	//! _programs[i] computes the effects of the i-th action schema, if _compiled[i] is true;
+	//! otherwise, the schema cannot be compiled and its actions need to be grounded in order to compute their effects
+	std::vector<EffectProgram> _programs;
+	std::vector<bool> _compiled;
 };
 
 } // namespaces
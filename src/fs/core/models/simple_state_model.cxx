@@ -3,8 +3,12 @@
 #include <fs/core/problem.hxx>
 #include <fs/core/state.hxx>
 #include <fs/core/utils/config.hxx>
+#include <fs/core/actions/strips_table.hxx>
 #include <fs/core/utils/system.hxx>
+#include <fs/core/utils/thread_pool.hxx>
+#include <fs/core/search/cancellation.hxx>
 #include <fs/core/applicability/match_tree.hxx>
+#include <fs/core/applicability/flat_match_tree.hxx>
 #include <lapkt/tools/logging.hxx>
 
 #include <fs/core/languages/fstrips/language.hxx>
@@ -80,14 +84,20 @@ SimpleStateModel::goal(const StateT& state) const {
 }
 
 SimpleStateModel::StateT
-SimpleStateModel::next(const StateT& state, const GroundAction::IdType& actionIdx) const {
-	return next(state, *(_task.getGroundActions()[actionIdx]));
+SimpleStateModel::next(const StateT& state, const GroundAction::IdType& actionIdx, ExpansionContext& context) const {
+	return next(state, *(_task.getGroundActions()[actionIdx]), context);
 }
 
 SimpleStateModel::StateT
-SimpleStateModel::next(const StateT& state, const GroundAction& a) const {
-	a.apply(state,_effects_cache);
-	StateT succ(state, _effects_cache); // Copy everything into the new state and apply the changeset
+SimpleStateModel::next(const StateT& state, const GroundAction& a, ExpansionContext& context) const {
+	const StripsActionTable* strips = _task.getStripsActionTable();
+	// The table is indexed by the IDs of the ground actions of the problem, which 'a' might not be one of
+	if (strips && strips->covers(a.getId()) && _task.getGroundActions()[a.getId()] == &a) {
+		return strips->next(a.getId(), state, context.changeset());
+	}
+
+	a.apply(state, context.changeset());
+	StateT succ(state, context.changeset()); // Copy everything into the new state and apply the changeset
 	LPT_EDEBUG("generated", "New state generated: " << succ);
 	return succ;
 }
@@ -102,13 +112,35 @@ SimpleStateModel::goal(const StateT& s, unsigned i) const {
 }
 
 
+void
+SimpleStateModel::expand(const StateT& state, std::vector<SuccessorT>& successors, bool enforce_state_constraints) const {
+	ExpansionContext& context = ExpansionContext::local();
+	Cancellation::check();
+	const auto& actions = _task.getGroundActions();
+	for (ActionId id:_manager->applicable(state, enforce_state_constraints)) {
+		successors.emplace_back(id, next(state, *actions[id], context));
+	}
+}
+
+void
+SimpleStateModel::expand(const std::vector<const StateT*>& states, std::vector<std::vector<SuccessorT>>& successors, ThreadPool& pool, bool enforce_state_constraints) const {
+	successors.resize(states.size());
+	pool.parallel_for(states.size(), [&](std::size_t i, unsigned) {
+		successors[i].clear();
+		expand(*states[i], successors[i], enforce_state_constraints);
+	});
+}
+
 GroundApplicableSet
-SimpleStateModel::applicable_actions(const StateT& state, bool enforce_state_constraints) const {
+SimpleStateModel::applicable_actions(const StateT& state, bool enforce_state_constraints, ExpansionContext& context) const {
+	// The action managers already keep their scratch data per thread
+	Cancellation::check();
 	return _manager->applicable(state, enforce_state_constraints);
 }
 
-ActionManagerI*
-SimpleStateModel::build_action_manager(const Problem& problem) {
+//! Build the action manager that corresponds to the configured successor generation strategy
+static NaiveActionManager*
+build_strategy_manager(const Problem& problem) {
 	using StrategyT = Config::SuccessorGenerationStrategy;
 	const Config& config = Config::instance();
 	const auto& actions = problem.getGroundActions();
@@ -119,11 +151,15 @@ SimpleStateModel::build_action_manager(const Problem& problem) {
 	LPT_INFO( "main", "Ground actions: " << actions.size());
 
 	if (strategy == StrategyT::adaptive) {
-		// Choose match-tree if number of actions is large enough, otherwise naive.
+		// Choose match-tree if number of actions is large enough and the states are fully binary, otherwise naive.
 		unsigned cutoff = config.getOption<unsigned>("mt_cutoff", 20000);
-		if (actions.size() > cutoff) {
-			strategy = StrategyT::match_tree;
-			LPT_INFO("cout", "Chose Match-Tree as Successor Generator (" << actions.size() << " > " << cutoff << ")");
+		if (actions.size() > cutoff && problem.getStateAtomIndexer().is_fully_binary()) {
+			strategy = StrategyT::flat_match_tree;
+			LPT_INFO("cout", "Chose Flat Match-Tree as Successor Generator (" << actions.size() << " > " << cutoff << ")");
+
+		} else if (actions.size() > cutoff) {
+			strategy = StrategyT::naive;
+			LPT_INFO("cout", "Chose Naive as Successor Generator (variable domains not binary)");
 
 		} else {
 			strategy = StrategyT::naive;
@@ -156,10 +192,30 @@ SimpleStateModel::build_action_manager(const Problem& problem) {
 		LPT_INFO("cout", "Match-tree built with " << mng->count() << " nodes.");
 		LPT_INFO("cout", "Mem. usage after match-tree construction: " << get_current_memory_in_kb() << "kB. / " << get_peak_memory_in_kb() << " kB.");
 		return mng;
+
+	} else if (strategy == StrategyT::flat_match_tree) {
+		const StateAtomIndexer& indexer = problem.getStateAtomIndexer();
+		if (!indexer.is_fully_binary()) {
+			throw std::runtime_error("Successor Generation Strategy: Flat Match Tree: Variable domains not binary.");
+		}
+		LPT_INFO("cout", "Successor Generator: Flat Match Tree");
+		LPT_INFO("cout", "Mem. usage before match-tree construction: " << get_current_memory_in_kb() << "kB. / " << get_peak_memory_in_kb() << " kB.");
+
+		auto mng = new FlatMatchTreeActionManager(actions, constraints, tuple_idx, indexer);
+		LPT_INFO("cout", "Match-tree built with " << mng->count() << " nodes.");
+		LPT_INFO("cout", "Mem. usage after match-tree construction: " << get_current_memory_in_kb() << "kB. / " << get_peak_memory_in_kb() << " kB.");
+		return mng;
 	}
 
 	throw std::runtime_error("Unknown successor generation strategy");
 }
 
 
+ActionManagerI*
+SimpleStateModel::build_action_manager(const Problem& problem) {
+	NaiveActionManager* manager = build_strategy_manager(problem);
+	manager->use_strips_table(problem.getStripsActionTable());
+	return manager;
+}
+
 } // namespaces
@@ -4,6 +4,8 @@
 #include <fs/core/actions/actions.hxx>
 #include <fs/core/applicability/base.hxx>
 #include <fs/core/atom.hxx>
+#include <fs/core/models/expansion_context.hxx>
+#include <fs/core/models/successor.hxx>
 
 // namespace lapkt { class MultivaluedState; }
 
@@ -15,6 +17,7 @@ namespace fs0 {
 
 class Problem;
 class State;
+class ThreadPool;
 
 class SimpleStateModel { // : public aptk::DetStateModel<State, GroundAction> {
 public:
@@ -24,6 +27,7 @@ public:
 	//using ActionType = BaseT::ActionType;
 	using ActionType = GroundAction;
 	using ActionId = ActionType::IdType;
+	using SuccessorT = Successor<ActionId>;
 
 	//! Factory method
 	static SimpleStateModel build(const Problem& problem);
@@ -45,15 +49,23 @@ public:
 	//! Returns true if state is a goal state
 	bool goal(const StateT& state) const;
 
-	//! Returns applicable action set object
-	GroundApplicableSet applicable_actions(const StateT& state, bool enforce_state_constraints) const;
-	GroundApplicableSet applicable_actions(const StateT& state) const {
-		return applicable_actions(state, true);
+	//! Returns applicable action set object, using the given context (by default, that of the calling thread) as scratch space
+	GroundApplicableSet applicable_actions(const StateT& state, bool enforce_state_constraints, ExpansionContext& context = ExpansionContext::local()) const;
+	GroundApplicableSet applicable_actions(const StateT& state, ExpansionContext& context = ExpansionContext::local()) const {
+		return applicable_actions(state, true, context);
 	}
 
-	//! Returns the state resulting from applying the given action action on the given state
-	StateT next(const StateT& state, const GroundAction::IdType& id) const;
-	StateT next(const StateT& state, const GroundAction& a) const;
+	//! Append to 'successors' all the successors of the given state, i.e. one successor for each applicable action.
+	void expand(const State& state, std::vector<SuccessorT>& successors, bool enforce_state_constraints = true) const;
+
+	//! Expand all the given states in parallel with the given pool of threads.
+	//! 'successors[i]' will contain the successors of 'states[i]', in the same order than the sequential 'expand' gives them.
+	void expand(const std::vector<const State*>& states, std::vector<std::vector<SuccessorT>>& successors, ThreadPool& pool, bool enforce_state_constraints = true) const;
+
+	//! Returns the state resulting from applying the given action action on the given state,
+	//! using the given context (by default, that of the calling thread) as scratch space
+	StateT next(const StateT& state, const GroundAction::IdType& id, ExpansionContext& context = ExpansionContext::local()) const;
+	StateT next(const StateT& state, const GroundAction& a, ExpansionContext& context = ExpansionContext::local()) const;
 
 	//! Returns the number of subgoals into which the goal can be decomposed
 	unsigned num_subgoals() const { return _subgoals.size(); }
@@ -65,8 +77,9 @@ public:
 
 	static ActionManagerI* build_action_manager(const Problem& problem);
 
-	const std::vector<Atom>& get_last_changeset() const {
-		return _effects_cache;
+	//! The atoms made true by the last action applied through the given context
+	const std::vector<Atom>& get_last_changeset(const ExpansionContext& context = ExpansionContext::local()) const {
+		return context.changeset();
 	}
 
 protected:
@@ -75,9 +88,6 @@ protected:
 
 	std::unique_ptr<ActionManagerI> _manager;
 
-	//! A cache to hold the effects of the last-applied action and avoid memory allocations.
-	mutable std::vector<Atom> _effects_cache;
-
 	const std::vector<const fs::Formula*> _subgoals;
 };
 
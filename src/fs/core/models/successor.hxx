@@ -0,0 +1,17 @@
+#pragma once
+
+#include <fs/core/state.hxx>
+
+namespace fs0 {
+
+//! A successor of some state: the action that generates it, plus the resulting state.
+//! Used by the batch expansion methods of the state models.
+template <typename ActionIdT>
+struct Successor {
+	ActionIdT action;
+	State state;
+
+	Successor(const ActionIdT& action_, State&& state_) : action(action_), state(std::move(state_)) {}
+};
+
+} // namespaces
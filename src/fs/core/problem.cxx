@@ -2,6 +2,7 @@
 #include <fs/core/problem.hxx>
 
 #include <fs/core/actions/actions.hxx>
+#include <fs/core/actions/strips_table.hxx>
 #include <fs/core/applicability/formula_interpreter.hxx>
 #include <fs/core/languages/fstrips/formulae.hxx>
 #include <fs/core/languages/fstrips/metrics.hxx>
@@ -30,11 +31,13 @@ Problem::Problem(
         AllTransitionGraphsT transitions
 ) :
 	_tuple_index(std::move(tuple_index)),
-	_init(init),
 	_state_indexer(state_indexer),
+	_init(init),
 	_action_data(std::move(action_data)),
 	_axioms(std::move(axioms)),
 	_ground(),
+	_ground_store(),
+	_strips_table(),
 	_partials(),
 	_state_constraints(std::move(state_constraints)),
 	_goal_formula(goal),
@@ -70,11 +73,13 @@ _clone_axioms(const std::unordered_map<std::string, const fs::Axiom*>& axioms) {
 
 Problem::Problem(const Problem& other) :
 	_tuple_index(other._tuple_index),
-	_init(new State(*other._init)),
 	_state_indexer(new StateAtomIndexer(*other._state_indexer)),
+	_init(new State(*other._init)),
 	_action_data(Utils::copy(other._action_data)),
 	_axioms(other._axioms),
 	_ground(Utils::copy(other._ground)),
+	_ground_store(other._ground_store),
+	_strips_table(other._strips_table),
 	_partials(Utils::copy(other._partials)),
     _state_constraints(other._state_constraints),
 	_goal_formula(other._goal_formula->clone()),
@@ -89,6 +94,8 @@ Problem::Problem(const Problem& other) :
 }
 const fs::Formula* Problem::getGoalConditions() const { return _goal_formula; }
 
+void Problem::setStripsActionTable(std::unique_ptr<StripsActionTable>&& table) { _strips_table = std::move(table); }
+
 std::ostream& Problem::print(std::ostream& os) const {
 	const fs0::ProblemInfo& info = ProblemInfo::getInstance();
 	os << "Planning Problem [domain: " << info.getDomainName() << ", instance: " << info.getInstanceName() <<  "]" << std::endl;
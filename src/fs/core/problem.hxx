@@ -3,6 +3,7 @@
 
 #include <fs/core/fs_types.hxx>
 #include <fs/core/utils/atom_index.hxx>
+#include <fs/core/actions/ground_action_store.hxx>
 
 namespace fs0::language::fstrips { class Formula; class Axiom; class Metric;}
 namespace fs = fs0::language::fstrips;
@@ -16,6 +17,7 @@ class ActionData;
 class ActionBase;
 class PartiallyGroundedAction;
 class GroundAction;
+class StripsActionTable;
 
 class Problem {
 public:
@@ -49,6 +51,14 @@ public:
 	void setGroundActions(std::vector<const GroundAction*>&& ground) { _ground = std::move(ground); }
     void addGroundAction( const GroundAction* a ) { _ground.push_back(a); }
 
+	//! Get the compact representation of the ground actions that are in STRIPS form
+	const GroundActionStore& getGroundActionStore() const { return _ground_store; }
+	void setGroundActionStore(GroundActionStore&& store) { _ground_store = std::move(store); }
+
+	//! Get the bit-level form of the STRIPS actions over predicative variables, or nullptr if there are none
+	const StripsActionTable* getStripsActionTable() const { return _strips_table.get(); }
+	void setStripsActionTable(std::unique_ptr<StripsActionTable>&& table);
+
 	const std::vector<const PartiallyGroundedAction*>& getPartiallyGroundedActions() const { return _partials; }
 	void setPartiallyGroundedActions(std::vector<const PartiallyGroundedAction*>&& actions) { _partials = std::move(actions); }
 
@@ -106,11 +116,13 @@ protected:
 	//! An index of tuples and atoms
 	AtomIndex _tuple_index;
 
+	//! The state indexer needs to be declared before (i.e. destroyed after) the initial state,
+	//! since the memory of the state is owned by the indexer arena
+	const std::unique_ptr<StateAtomIndexer> _state_indexer;
+
 	//! The initial state of the problem
 	std::unique_ptr<State> _init;
 
-	const std::unique_ptr<StateAtomIndexer> _state_indexer;
-
 	std::vector<const ActionData*> _action_data;
 
 	//! An index mapping symbol names to the axiomatic definition of the symbol, if it exists.
@@ -119,6 +131,12 @@ protected:
 	// The set of grounded actions of the problem
 	std::vector<const GroundAction*> _ground;
 
+	// The STRIPS form of the grounded actions of the problem
+	GroundActionStore _ground_store;
+
+	// The bit-level form of the STRIPS actions, which is immutable and hence shared among copies of the problem
+	std::shared_ptr<const StripsActionTable> _strips_table;
+
 	// The possible set of partially grounded actions of the problem
 	std::vector<const PartiallyGroundedAction*> _partials;
 
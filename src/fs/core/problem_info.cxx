@@ -136,6 +136,7 @@ void
 ProblemInfo::set_extension(unsigned symbol_id, std::unique_ptr<StaticExtension>&& extension) {
 	assert(_extensions.at(symbol_id) == nullptr); // Shouldn't be setting twice the same extension
 	setFunction(symbol_id, extension->get_function());
+	_functionData.at(symbol_id).setTable(&extension->table());
 	_extensions.at(symbol_id) = std::move(extension);
 }
 
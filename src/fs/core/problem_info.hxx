@@ -42,12 +42,23 @@ public:
 	//! Sets/Gets the actual implementation of the function
 	void setFunction(const Function& function) {
 		_function = function;
+		_table = nullptr; // The function no longer comes from a static extension
 	}
 	const Function& getFunction() const {
 		assert(_function);
 		return _function;
 	}
 
+	//! Sets/Gets the table of the static extension of the symbol, if its implementation is given by one,
+	//! which allows evaluating the symbol without going through the type-erased function
+	void setTable(const StaticTable* table) { _table = table; }
+	const StaticTable* getTable() const { return _table; }
+
+	//! Evaluate the symbol on the given point, through its static table if possible
+	object_id evaluate(const ValueTuple& point) const {
+		return _table ? _table->evaluate(point.data()) : getFunction()(point);
+	}
+
 protected:
 	Type _type;
 	Signature _signature;
@@ -58,6 +69,8 @@ protected:
 
 	//! The actual implementation of the function
 	Function _function;
+
+	const StaticTable* _table = nullptr;
 };
 
 /**
@@ -1,38 +1,42 @@
 
 #pragma once
 
+#include <deque>
+
 #include <fs/core/utils/system.hxx>
+#include <fs/core/search/state_registry.hxx>
+#include <fs/core/search/nodes/node_pool.hxx>
 
 #include <lapkt/algorithms/generic_search.hxx>
-#include <lapkt/search/components/open_lists.hxx>
-#include <lapkt/search/components/stl_unordered_map_closed_list.hxx>
 #include <lapkt/tools/resources_control.hxx>
 
 
 namespace lapkt {
 
 //! Partial specialization of the GenericSearch algorithm:
-//! A breadth-first search is a generic search with a FIFO open list and 
-//! a standard unsorted closed list. Type of node and state model are still generic.
+//! A breadth-first search is a generic search with a FIFO open list and
+//! a closed list given by a StateRegistry: since nodes are closed upon generation,
+//! a generated state is a duplicate iff it had already been registered.
+//! Type of node and state model are still generic, but nodes need to be constructible from
+//! a registry and a state ID, and to be allocated from a NodePool, as e.g. RegisteredBlindSearchNode.
 template <typename NodeT,
           typename StateModel,
           typename StatsT
 >
 class StlBreadthFirstSearch {
 public:
-    using OpenListT = lapkt::SimpleQueue<NodeT>;
-    using ClosedListT = aptk::StlUnorderedMapClosedList<NodeT>;
+    using NodePT = IntrusivePtr<NodeT>;
+    using OpenListT = std::deque<NodePT>;
     using StateT = typename StateModel::StateT;
     using ActionIdT = typename StateModel::ActionType::IdType;
     using PlanT =  std::vector<ActionIdT>;
-    using NodePT = std::shared_ptr<NodeT>;
 
 
 	//! The constructor requires the user of the algorithm to inject both
 	//! (1) the state model to be used in the search
 	//! (2) the particular open and closed list objects
 	StlBreadthFirstSearch(const StateModel& model, StatsT& stats, bool verbose) :
-            _model(model), _open(), _closed(), _generated(0), _stats(stats), _verbose(verbose)
+            _model(model), _pool(), _open(), _registry(), _generated(0), _stats(stats), _verbose(verbose)
 	{}
 	
 	virtual ~StlBreadthFirstSearch() = default;
@@ -47,8 +51,8 @@ public:
         return _stats.generated() * 1.0 / (aptk::time_used() - _stats.initial_search_time());
     }
 
-	void on_generation(const NodeT& node) {
-        _stats.generation(node.g);
+	void on_generation(unsigned g) {
+        _stats.generation(g);
 
         if (_verbose) {
             auto generated = _stats.generated();
@@ -65,31 +69,33 @@ public:
 	//! On a problem that has a solution at depth 'd', this avoids the worst-case expansion
 	//! of all the $b^d$ nodes of the last (deepest) layer (where b is the branching factor).
 	bool search(const StateT& s, PlanT& solution) {
-		NodePT n = std::make_shared<NodeT>(s, this->_generated++);
+		NodePT n = _pool.make(_registry, _registry.insert(s).first);
+		++this->_generated;
 
         LPT_INFO("cout", *n);
 		
 		if (this->check_goal(n, solution)) return true;
 		
-		this->_open.insert(n);
+		this->_open.push_back(std::move(n));
 		
 		while (!this->_open.empty()) {
-			NodePT current = this->_open.next( );
+			NodePT current = std::move(this->_open.front());
+			this->_open.pop_front();
 
 			for (const auto& a:this->_model.applicable_actions(current->state)) {
-				NodePT successor = std::make_shared<NodeT>(
-				        this->_model.next(current->state, a), a, current, this->_generated++);
-
-				on_generation(*successor);
+				auto registered = _registry.insert(this->_model.next(current->state, a));
+				++this->_generated;
+				on_generation(current->g + 1);
 
-                // The node has already been closed, either because it has been expanded, or because it is already
+                // The state has already been closed, either because it has been expanded, or because it is already
                 // in the open list waiting to be expanded
-				if (this->_closed.check(successor)) continue;
+				if (!registered.second) continue;
+
+				NodePT successor = _pool.make(_registry, registered.first, a, current);
 
 				if (this->check_goal(successor, solution)) return true;
 				
-				this->_open.insert(successor);
-                this->_closed.put(successor);
+				this->_open.push_back(std::move(successor));
 			}
 		}
 		return false;
@@ -123,11 +129,14 @@ protected:
     //! The search model
     const StateModel& _model;
 
+    //! The pool from which all search nodes are allocated
+    NodePool<NodeT> _pool;
+
     //! The open list
     OpenListT _open;
 
-    //! The closed list
-    ClosedListT _closed;
+    //! The registry of all generated states, which acts as the closed list
+    fs0::StateRegistry _registry;
 
     //! The number of generated nodes so far
     unsigned long _generated;
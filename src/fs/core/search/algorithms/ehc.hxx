@@ -1,13 +1,18 @@
 
 #pragma once
 
+#include <algorithm>
+#include <deque>
+#include <unordered_set>
+
 #include <fs/core/search/nodes/heuristic_search_node.hxx>
+#include <fs/core/search/nodes/node_pool.hxx>
 #include <fs/core/models/ground_state_model.hxx>
 #include <fs/core/state.hxx>
 #include <fs/core/problem.hxx>
 #include <fs/core/utils/printers/vector.hxx>
 
-#include <lapkt/algorithms/breadth_first_search.hxx>
+#include <lapkt/tools/events.hxx>
 #include <fs/core/search/events.hxx>
 #include <fs/core/search/stats.hxx>
 #include <fs/core/search/drivers/setups.hxx>
@@ -20,8 +25,10 @@ namespace fs0 { namespace drivers {
 //! we store in the node the set of atoms that are relevant to the first layer of the
 //! relaxed plan.
 template <typename StateT, typename ActionT>
-class EHCSearchNode {
+class EHCSearchNode : public lapkt::PooledNode<EHCSearchNode<StateT, ActionT>> {
 public:
+	using ptr_t = lapkt::IntrusivePtr<EHCSearchNode<StateT, ActionT>>;
+
 	~EHCSearchNode() = default;
 
 	EHCSearchNode(const EHCSearchNode&) = delete;
@@ -30,8 +37,8 @@ public:
 	EHCSearchNode& operator=(EHCSearchNode&&) = delete;
 
 
-	EHCSearchNode(StateT&& state_, typename ActionT::IdType action_, std::shared_ptr<EHCSearchNode<StateT, ActionT>> parent_, unsigned long gen_order = 0) :
-		state(std::move(state_)), action(action_), parent(parent_), h(0), g(0)
+	EHCSearchNode(StateT&& state_, typename ActionT::IdType action_, ptr_t parent_, unsigned long gen_order = 0) :
+		state(std::move(state_)), action(action_), parent(parent_), h(0), g(0), _helpful(false), _evaluated(false)
 	{}
 
 	EHCSearchNode(const StateT& state, unsigned long gen_order = 0) :
@@ -54,6 +61,7 @@ public:
 	template <typename Heuristic>
 	long evaluate_with(Heuristic& heuristic) {
 		h = heuristic.evaluate(state, _relevant);
+		_evaluated = true;
 		LPT_DEBUG("heuristic" , std::endl << "Computed heuristic value of " << h <<  " for state: " << std::endl << state << std::endl << "****************************************");
 
 		// If the heuristic is > 0, then we must have a relaxed plan and at least some atoms in the 1st layer of it.
@@ -61,11 +69,20 @@ public:
 		return h;
 	}
 
+	//! Take the parent's heuristic value as an estimate of the value of the node, whose evaluation is deferred
+	void inherit_heuristic_estimate() {
+		if (parent) h = parent->h;
+	}
+
+	bool is_evaluated() const { return _evaluated; }
+
+	bool dead_end() const { return h == -1; }
+
 	const typename ActionT::IdType& get_action() const { return action; }
 
 	const StateT& get_state() const { return state; }
 
-	std::shared_ptr<EHCSearchNode<StateT, ActionT>> get_parent() { return parent; }
+	ptr_t get_parent() { return parent; }
 
 	long get_h() const { return h; }
 
@@ -75,7 +92,7 @@ public:
 
 	typename ActionT::IdType action;
 
-	std::shared_ptr<EHCSearchNode<StateT, ActionT>> parent;
+	ptr_t parent;
 
 	long h;
 
@@ -89,22 +106,31 @@ protected:
 	std::vector<Atom> _relevant;
 
 	bool _helpful;
+
+	//! Whether the heuristic value of the node has been computed, or only inherited from the parent
+	bool _evaluated;
 };
 
 //! This is a specialized version of breadth-first search that incorporates two modifications:
 //!    (1) It aborts (and returns the node) as soon as a node is found with heuristic smaller than a given bound, and
 //!    (2) When expanding a node, it prunes those actions that do not satisfy a certain helpful-action criteria, namely
 //!        only those actions that add at least one of the supports of the actions in the first block of the relaxed plan.
+//! Nodes are allocated from a pool owned by the caller, since they need to survive across successive breadth-first searches.
+//! All successors of a node are generated before any of them is evaluated, so that the evaluations run back to back on
+//! very similar states. Depending on the evaluation type, the evaluation of (some of) the successors can be deferred until
+//! they are expanded, in which case they go into the open list with the heuristic value of their parent. If unhelpful
+//! successors are not pruned, they can still be ranked after all helpful ones, by keeping them in a second open list
+//! that is only used when the first one is empty.
 template <typename StateModel,
           typename HeuristicT,
           typename NodeType = EHCSearchNode<State, GroundAction>
 >
-class EHCBreadthFirstSearch : public lapkt::StlBreadthFirstSearch<NodeType, StateModel>
+class EHCBreadthFirstSearch : public lapkt::events::Subject
 {
 public:
-	using Base = lapkt::StlBreadthFirstSearch<NodeType, StateModel>;
-	using NodePtr = std::shared_ptr<NodeType>;
-	using PlanT = typename Base::PlanT;
+	using NodePtr = typename NodeType::ptr_t;
+	using NodePoolT = lapkt::NodePool<NodeType>;
+	using PlanT = std::vector<typename StateModel::ActionType::IdType>;
 
 	//! Relevant events
 	using NodeOpenEvent = lapkt::events::NodeOpenEvent<NodeType>;
@@ -112,20 +138,21 @@ public:
 	using NodeExpansionEvent = lapkt::events::NodeExpansionEvent<NodeType>;
 	using NodeCreationEvent = lapkt::events::NodeCreationEvent<NodeType>;
 
+	using EvaluationT = Config::EvaluationT;
+
 
-	//! For convenience, a constructor where the open list is default-constructed
-	EHCBreadthFirstSearch(const StateModel& model, HeuristicT& heuristic, bool prune_unhelpful) :
-		Base(model), _heuristic(heuristic), _prune_unhelpful(prune_unhelpful)
+	EHCBreadthFirstSearch(const StateModel& model, NodePoolT& pool, HeuristicT& heuristic, bool prune_unhelpful, EvaluationT evaluation, bool preferred_first, SearchStats& stats, HeuristicCache* cache = nullptr) :
+		_model(model), _pool(pool), _heuristic(heuristic), _prune_unhelpful(prune_unhelpful), _evaluation(evaluation), _preferred_first(preferred_first), _stats(stats), _cache(cache)
 	{}
 
 	~EHCBreadthFirstSearch() = default;
-	EHCBreadthFirstSearch(const EHCBreadthFirstSearch&) = default;
+	EHCBreadthFirstSearch(const EHCBreadthFirstSearch&) = delete;
 	EHCBreadthFirstSearch(EHCBreadthFirstSearch&&) = default;
-	EHCBreadthFirstSearch& operator=(const EHCBreadthFirstSearch&) = default;
-	EHCBreadthFirstSearch& operator=(EHCBreadthFirstSearch&&) = default;
+	EHCBreadthFirstSearch& operator=(const EHCBreadthFirstSearch&) = delete;
+	EHCBreadthFirstSearch& operator=(EHCBreadthFirstSearch&&) = delete;
 
 
-	bool search(const State& state, PlanT& solution) override {
+	bool search(const State& state, PlanT& solution) {
 		auto node = make_node(state);
 		auto end = bounded_search(node, node->get_h());
 		if (end) {
@@ -134,34 +161,48 @@ public:
 		return !!end;
 	}
 
-	static NodePtr make_node(const State& state, HeuristicT& heuristic) {
-		auto node = std::make_shared<NodeType>(state);
+	static NodePtr make_node(NodePoolT& pool, const State& state, HeuristicT& heuristic) {
+		auto node = pool.make(state);
 		node->evaluate_with(heuristic);
 		return node;
 	}
 
-	NodePtr make_node(const State& state) const { return make_node(state, _heuristic); }
+	NodePtr make_node(const State& state) const { return make_node(_pool, state, _heuristic); }
 
 	//! Returns the first node with heuristic h < h_bound
 	NodePtr bounded_search(NodePtr root, long h_bound) {
-		this->_open.insert(root);
+		_open.push_back(root);
 
 		NodePtr goal = nullptr;
 		unsigned pruned = 0;
-		while (!goal && !this->_open.empty()) {
+		while (!goal && (!_open.empty() || !_unpreferred.empty())) {
 
-			NodePtr current = this->_open.next();
+			auto& queue = _open.empty() ? _unpreferred : _open;
+			NodePtr current = std::move(queue.front());
+			queue.pop_front();
 			this->notify(NodeOpenEvent(*current));
-			this->_closed.put(current);
+
+			// A node whose evaluation was deferred gets evaluated right before its expansion
+			if (!current->is_evaluated()) {
+				evaluate(*current);
+				if (improves(*current, h_bound)) {
+					goal = current;
+					break;
+				}
+			}
+
+			_closed.insert(current);
+			if (current->dead_end()) continue;
 
 			this->notify(NodeExpansionEvent(*current));
 
-			// Expand children nodes
-			for (const auto& a : Base::_model.applicable_actions(current->get_state(), true)) {
-				State s_a = Base::_model.next( current->get_state(), a );
-				NodePtr successor = std::make_shared<NodeType>(std::move(s_a), a, current);
+			// Generate all children nodes first...
+			_successors.clear();
+			for (const auto& a : _model.applicable_actions(current->get_state(), true)) {
+				State s_a = _model.next( current->get_state(), a );
+				NodePtr successor = _pool.make(std::move(s_a), a, current);
 
-				if (this->_closed.check(successor)) continue;
+				if (_closed.find(successor) != _closed.end()) continue;
 
 				this->notify(NodeCreationEvent(*successor));
 
@@ -171,12 +212,24 @@ public:
 					continue;
 				}
 
-				if (successor->evaluate_with(_heuristic) < h_bound) {
-					goal = successor;
-					break;
+				_successors.push_back(std::move(successor));
+			}
+
+			// ...and then evaluate them in a single batch
+			for (auto& successor:_successors) {
+				if (defer_evaluation(*successor)) {
+					successor->inherit_heuristic_estimate();
+				} else {
+					evaluate(*successor);
+					if (improves(*successor, h_bound)) {
+						goal = successor;
+						break;
+					}
+					if (successor->dead_end()) continue;
 				}
 
-				this->_open.insert( successor );
+				bool preferred = !_preferred_first || successor->is_helpful();
+				(preferred ? _open : _unpreferred).push_back(std::move(successor));
 			}
 		}
 
@@ -184,11 +237,72 @@ public:
 		return goal;
 	}
 
+	//! Backward chaining procedure to recover a plan from a given node
+	void retrieve_solution(NodePtr node, PlanT& solution) const {
+		while (node->has_parent()) {
+			solution.push_back(node->action);
+			node = node->parent;
+		}
+		std::reverse(solution.begin(), solution.end());
+	}
+
 protected:
+	void evaluate(NodeType& node) {
+		CachedHeuristic<HeuristicT, SearchStats> heuristic(_heuristic, _cache, _stats);
+		node.evaluate_with(heuristic);
+	}
+
+	//! Whether the evaluation of a newly-generated node needs to be deferred until its expansion
+	bool defer_evaluation(const NodeType& node) const {
+		if (_evaluation == EvaluationT::eager) return false;
+		if (_evaluation == EvaluationT::delayed_for_unhelpful && node.is_helpful()) return false;
+		return true;
+	}
+
+	//! Whether the given (evaluated) node improves on the given heuristic bound. Dead ends never do.
+	static bool improves(const NodeType& node, long h_bound) {
+		return !node.dead_end() && node.h < h_bound;
+	}
+
+	//! Closed nodes are compared by the state they hold
+	struct node_hash {
+		std::size_t operator()(const NodePtr& node) const { return node->hash(); }
+	};
+
+	struct node_equal {
+		bool operator()(const NodePtr& n1, const NodePtr& n2) const { return *n1 == *n2; }
+	};
+
+	//! The search model
+	const StateModel& _model;
+
+	//! The pool from which search nodes are allocated
+	NodePoolT& _pool;
+
+	//! The (FIFO) open list, and that of the unhelpful nodes, if these are ranked after the helpful ones
+	std::deque<NodePtr> _open;
+	std::deque<NodePtr> _unpreferred;
+
+	//! The successors of the node being expanded
+	std::vector<NodePtr> _successors;
+
+	//! The closed list
+	std::unordered_set<NodePtr, node_hash, node_equal> _closed;
+
 	//!
 	HeuristicT& _heuristic;
 
 	bool _prune_unhelpful;
+
+	EvaluationT _evaluation;
+
+	//! Whether to expand all helpful nodes before any unhelpful one, when these are not pruned
+	bool _preferred_first;
+
+	SearchStats& _stats;
+
+	//! The cache of heuristic values shared by all breadth-first searches, if any
+	HeuristicCache* _cache;
 };
 
 
@@ -203,13 +317,15 @@ public:
 	using NodeT = EHCSearchNode<State, GroundAction>;
 
 	~EHCSearch() = default;
-	EHCSearch(const EHCSearch&) = default;
+	EHCSearch(const EHCSearch&) = delete;
 	EHCSearch(EHCSearch&&) = default;
-	EHCSearch& operator=(const EHCSearch&) = default;
+	EHCSearch& operator=(const EHCSearch&) = delete;
 	EHCSearch& operator=(EHCSearch&&) = default;
 
-	EHCSearch(const GroundStateModel& model, HeuristicT&& heuristic, bool prune_unhelpful, SearchStats& stats) :
-		_model(model), _heuristic(std::move(heuristic)), _prune_unhelpful(prune_unhelpful), _stats(stats)
+	using EvaluationT = Config::EvaluationT;
+
+	EHCSearch(const GroundStateModel& model, HeuristicT&& heuristic, bool prune_unhelpful, EvaluationT evaluation, bool preferred_first, SearchStats& stats, HeuristicCache* cache = nullptr) :
+		_model(model), _pool(), _heuristic(std::move(heuristic)), _prune_unhelpful(prune_unhelpful), _evaluation(evaluation), _preferred_first(preferred_first), _stats(stats), _cache(cache)
 	{
 		EventUtils::setup_stats_observer<NodeT>(_stats, _handlers);
 		EventUtils::setup_HA_observer<NodeT>(_handlers);
@@ -218,13 +334,14 @@ public:
 	bool search(const State& state, std::vector<unsigned>& solution) {
 		assert(solution.size()==0);
 
-		auto node = BreadthFirstAlgorithm::make_node(state, _heuristic);
+		auto node = BreadthFirstAlgorithm::make_node(_pool, state, _heuristic);
+		_stats.evaluation();
 		LPT_INFO("search", "Starting EHC search on node " << *node);
 
 		while(node->h > 0) {
 
 			// Perform breadth-first search until a state with smaller heuristic value is found
-			BreadthFirstAlgorithm bfs(_model, _heuristic, _prune_unhelpful);
+			BreadthFirstAlgorithm bfs(_model, _pool, _heuristic, _prune_unhelpful, _evaluation, _preferred_first, _stats, _cache);
 			lapkt::events::subscribe(bfs, _handlers);
 
 			if (! (node = bfs.bounded_search(node, node->h))) { // EHC fails
@@ -247,14 +364,24 @@ protected:
 	//!
 	const GroundStateModel& _model;
 
+	//! The pool from which the nodes of all the breadth-first searches are allocated
+	lapkt::NodePool<NodeT> _pool;
+
 	//!
 	HeuristicT _heuristic;
 
 	//! Whether to prune those actions that are not considered helpful or not
 	bool _prune_unhelpful;
 
+	//! When to evaluate the nodes of the breadth-first searches, and whether to rank unhelpful nodes last
+	EvaluationT _evaluation;
+	bool _preferred_first;
+
 	SearchStats& _stats;
 
+	//! The cache of heuristic values of the EHC heuristic, if any
+	HeuristicCache* _cache;
+
 	std::vector<std::unique_ptr<lapkt::events::EventHandler>> _handlers;
 };
 
@@ -11,7 +11,8 @@
 
 namespace lapkt {
 
-//! A generic search schema
+//! A generic search schema. Optionally, helpful nodes are kept in a second open list, and expansions alternate between
+//! both lists, so that helpful nodes are expanded earlier without the unhelpful ones being starved.
 template <typename NodeT,
 		typename StateModel,
         typename NodeCompareT = node_comparer<std::shared_ptr<NodeT>>,
@@ -35,10 +36,12 @@ public:
 	//! (1) the state model to be used in the search
 	//! (2) the open list object to be used in the search
 	//! (3) the closed list object to be used in the search
+	//! (4) whether to alternate between an open list of helpful nodes and one of the rest
 
-	MonotonicSearch(const StateModel& model, fs0::gecode::MonotonicityCSP* monot_manager) :
+	MonotonicSearch(const StateModel& model, fs0::gecode::MonotonicityCSP* monot_manager, bool alternate_helpful = false) :
 		_model(model), _goalcounter(model.getTask().getGoalConditions(), model.getTask().get_tuple_index()),
-		_open(), _closed(), _generated(0), _monotonicity_csp_manager(monot_manager), _num_pruned(0), _num_deadends(0)
+		_open(), _preferred(), _alternate_helpful(alternate_helpful), _preferred_turn(true),
+		_closed(), _generated(0), _monotonicity_csp_manager(monot_manager), _num_pruned(0), _num_deadends(0)
 	{}
 
 	virtual ~MonotonicSearch() = default;
@@ -68,8 +71,8 @@ public:
 
 
 		
-		while ( !_open.empty() ) {
-			NodePT current = _open.next( );
+		while ( !_open.empty() || !_preferred.empty() ) {
+			NodePT current = next();
 			
 			this->notify(NodeOpenEvent(*current));
 			
@@ -80,13 +83,16 @@ public:
 			_closed.put(current);
 			
 			this->notify(NodeExpansionEvent(*current));
-			
+			if (current->dead_end()) continue; // Possibly found out by a deferred evaluation upon expansion
+
+			// Generate all children nodes first...
+			_successors.clear();
 			for ( const auto& a : _model.applicable_actions( current->state ) ) {
 				StateT s_a = _model.next( current->state, a );
 				NodePT successor = std::make_shared<NodeT>(std::move(s_a), a, current, _generated++);
 				
 				if (_closed.check(successor)) continue; // The node has already been closed
-				if (_open.updatable(successor)) continue; // The node is currently on the open list, we update some of its attributes but there's no need to reinsert it.
+				if (updatable(successor)) continue; // The node is currently on the open list, we update some of its attributes but there's no need to reinsert it.
 				
                 if (_monotonicity_csp_manager) {
                     assert(!current->_domains.is_null());
@@ -111,13 +117,21 @@ public:
                     }
                 }
 
-                this->notify(NodeCreationEvent(*successor));
+				_successors.push_back(std::move(successor));
+			}
+
+			// ...and then create (i.e. evaluate, if that is not deferred) them in a single batch
+			for (NodePT& successor:_successors) {
+				if (updatable(successor)) continue; // A duplicate of some sibling
+
+				this->notify(NodeCreationEvent(*successor));
 
-                if (successor->dead_end()) ++_num_deadends;
+				if (successor->dead_end()) ++_num_deadends;
 
 				successor->unachieved_subgoals = _goalcounter.evaluate(successor->state);
 
-				_open.insert(successor);
+				if (_alternate_helpful && successor->is_helpful()) _preferred.insert(successor);
+				else _open.insert(successor);
 			}
 		}
 		return false;
@@ -146,6 +160,18 @@ public:
     }
 	
 protected:
+
+	//! The next node to expand: when alternating, the open lists take turns, unless one of them is empty
+	NodePT next() {
+		bool preferred = !_preferred.empty() && (_open.empty() || _preferred_turn);
+		_preferred_turn = !preferred;
+		return preferred ? _preferred.next() : _open.next();
+	}
+
+	//! Whether the node is already in some open list, in which case it gets updated there
+	bool updatable(const NodePT& node) {
+		return _open.updatable(node) || _preferred.updatable(node);
+	}
 	
 	virtual bool check_goal(const NodePT& node, PlanT& solution) {
 		if ( _model.goal(node->state)) { // Solution found, we're done
@@ -161,8 +187,11 @@ protected:
 
 	fs0::UnsatisfiedGoalAtomsCounter _goalcounter;
 	
-	//! The open list
+	//! The open list, and that of the helpful nodes, if expansions alternate between both
 	OpenList _open;
+	OpenList _preferred;
+	bool _alternate_helpful;
+	bool _preferred_turn;
 	
 	//! The closed list
 	ClosedList _closed;
@@ -170,6 +199,9 @@ protected:
 	//! The number of generated nodes so far
     uint32_t _generated;
 
+	//! The successors of the node being expanded
+	std::vector<NodePT> _successors;
+
     std::unique_ptr<fs0::gecode::MonotonicityCSP> _monotonicity_csp_manager;
 
     unsigned long _num_pruned;
@@ -177,10 +209,12 @@ protected:
 
 	//* Some methods mainly for debugging purposes
 	bool check_open_list_integrity() const {
-		OpenList copy(_open);
-		while (!copy.empty()) {
-			NodePT node = copy.next();
-			check_node_correctness(node);
+		for (const OpenList* list:{&_open, &_preferred}) {
+			OpenList copy(*list);
+			while (!copy.empty()) {
+				NodePT node = copy.next();
+				check_node_correctness(node);
+			}
 		}
 		return true;
 	}
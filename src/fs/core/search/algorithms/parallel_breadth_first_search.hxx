@@ -0,0 +1,177 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+#include <fs/core/utils/system.hxx>
+#include <fs/core/utils/thread_pool.hxx>
+#include <fs/core/search/concurrent_closed_list.hxx>
+#include <fs/core/search/nodes/blind_node.hxx>
+
+#include <lapkt/tools/logging.hxx>
+#include <lapkt/tools/resources_control.hxx>
+
+
+namespace lapkt {
+
+//! A layer-synchronous, multi-threaded breadth-first search.
+//! The nodes of each layer are expanded in blocks; each block is processed in two parallel phases:
+//! (1) all nodes of the block are expanded, through the (reentrant) batch 'expand' method of the state model, and
+//! (2) all generated states are inserted into a lock-free ConcurrentClosedList, and checked for goal-hood if new.
+//! The work of both phases is balanced among threads by the work-stealing loops of a ThreadPool.
+//! As in the sequential StlBreadthFirstSearch, the goal check is done upon generation. Since a layer
+//! is fully processed before the next one is started, the first goal found in the layer at depth 'd' yields
+//! a plan of optimal length 'd', although which one of the optimal plans is returned might vary from run to run.
+template <typename StateModel,
+          typename StatsT
+>
+class ParallelBreadthFirstSearch {
+public:
+	using StateT = typename StateModel::StateT;
+	using ActionT = typename StateModel::ActionType;
+	using ActionIdT = typename ActionT::IdType;
+	using SuccessorT = typename StateModel::SuccessorT;
+	using NodeT = ConcurrentBlindSearchNode<ActionT>;
+	using PlanT =  std::vector<ActionIdT>;
+
+	//! 'num_threads' is the total number of threads to be used (0 meaning as many as hardware threads),
+	//! 'block_size' the max. number of nodes expanded at once, which bounds the number of successors kept in memory.
+	ParallelBreadthFirstSearch(const StateModel& model, StatsT& stats, unsigned num_threads, std::size_t block_size, bool verbose) :
+		_model(model),
+		_pool(num_threads),
+		_closed(_pool.size()),
+		_next(_pool.size()),
+		_block_size(std::max<std::size_t>(block_size, 1)),
+		_stats(stats),
+		_verbose(verbose)
+	{}
+
+	virtual ~ParallelBreadthFirstSearch() = default;
+
+	ParallelBreadthFirstSearch(const ParallelBreadthFirstSearch&) = delete;
+	ParallelBreadthFirstSearch(ParallelBreadthFirstSearch&&) = delete;
+	ParallelBreadthFirstSearch& operator=(const ParallelBreadthFirstSearch&) = delete;
+	ParallelBreadthFirstSearch& operator=(ParallelBreadthFirstSearch&&) = delete;
+
+	bool search(const StateT& s, PlanT& solution) {
+		LPT_INFO("cout", "Parallel Breadth-First Search with " << _pool.size() << " threads");
+
+		const NodeT* root = _closed.insert(0, StateT(s)).first;
+		_stats.generation(0);
+
+		LPT_INFO("cout", *root);
+
+		if (check_goal(root, solution)) return true;
+
+		std::vector<const NodeT*> layer{root};
+		for (unsigned g = 0; !layer.empty(); ++g) {
+			if (_verbose) {
+				LPT_INFO("cout", "Expanding layer " << g << " with " << layer.size() << " nodes. Closed states: " << _closed.size()
+				                                    << ". Memory consumption: "<< fs0::get_current_memory_in_kb() << "kB. / " << fs0::get_peak_memory_in_kb() << " kB.");
+			}
+
+			for (auto& next:_next) next.clear();
+
+			for (std::size_t begin = 0; begin < layer.size(); begin += _block_size) {
+				const NodeT* goal = process_block(layer, begin, std::min(layer.size(), begin + _block_size), g + 1);
+				if (goal && check_goal(goal, solution)) return true;
+			}
+
+			// The nodes that will make up the next layer are spread among the buffers of the different threads
+			layer.clear();
+			for (const auto& next:_next) layer.insert(layer.end(), next.begin(), next.end());
+		}
+		return false;
+	}
+
+	//! Backward chaining procedure to recover a plan from a given node
+	virtual void retrieve_solution(const NodeT* node, PlanT& solution) {
+		while (node->has_parent()) {
+			solution.push_back(node->action);
+			node = node->parent;
+		}
+		std::reverse( solution.begin(), solution.end() );
+	}
+
+	//! Convenience method
+	bool solve_model(PlanT& solution) { return search( _model.init(), solution ); }
+
+protected:
+	//! Expand the nodes of the given layer in the range [begin, end), all of which have depth 'g-1', and
+	//! add the new successors to the next layer. Return a goal node among the successors, if any, or nullptr otherwise.
+	const NodeT* process_block(const std::vector<const NodeT*>& layer, std::size_t begin, std::size_t end, unsigned g) {
+		const std::size_t n = end - begin;
+
+		_states.clear();
+		for (std::size_t i = begin; i < end; ++i) _states.push_back(&layer[i]->state);
+
+		// Phase 1: parallel expansion
+		_model.expand(_states, _successors, _pool);
+
+		std::size_t generated = 0;
+		for (std::size_t i = 0; i < n; ++i) generated += _successors[i].size();
+		_stats.expansion(n);
+		if (generated > 0) _stats.generation(g, generated);
+
+		// The closed list cannot grow during the parallel insertion
+		_closed.reserve(generated);
+
+		// Phase 2: parallel duplicate elimination and goal check
+		std::atomic<const NodeT*> goal(nullptr);
+		_pool.parallel_for(n, [&](std::size_t i, unsigned worker) {
+			if (goal.load(std::memory_order_relaxed)) return; // Some other thread has already found a goal
+
+			const NodeT* parent = layer[begin + i];
+			for (SuccessorT& successor:_successors[i]) {
+				auto inserted = _closed.insert(worker, std::move(successor.state), successor.action, parent);
+
+				// The state has already been generated, either in a previous layer or by some other thread in this one
+				if (!inserted.second) continue;
+
+				if (_model.goal(inserted.first->state)) {
+					const NodeT* none = nullptr;
+					goal.compare_exchange_strong(none, inserted.first);
+					return;
+				}
+				_next[worker].push_back(inserted.first);
+			}
+		});
+
+		return goal.load();
+	}
+
+	bool check_goal(const NodeT* node, PlanT& solution) {
+		if (_model.goal(node->state)) { // Solution found, we're done
+			if (_verbose) {
+				LPT_INFO("search", "Goal found");
+			}
+			retrieve_solution(node, solution);
+			return true;
+		}
+		return false;
+	}
+
+	//! The search model
+	const StateModel& _model;
+
+	//! The threads that run the search
+	fs0::ThreadPool _pool;
+
+	//! The closed list, which owns all search nodes
+	fs0::ConcurrentClosedList<NodeT> _closed;
+
+	//! _next[w] contains the nodes of the next layer inserted by worker 'w'
+	std::vector<std::vector<const NodeT*>> _next;
+
+	//! Scratch buffers for the states of the block being expanded and their successors
+	std::vector<const StateT*> _states;
+	std::vector<std::vector<SuccessorT>> _successors;
+
+	const std::size_t _block_size;
+
+	StatsT& _stats;
+	bool _verbose;
+};
+
+}
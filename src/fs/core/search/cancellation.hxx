@@ -0,0 +1,42 @@
+#pragma once
+
+#include <atomic>
+#include <stdexcept>
+
+namespace fs0 {
+
+//! Thrown from within a search once the search has been cancelled
+class SearchCancelled : public std::runtime_error {
+public:
+	SearchCancelled() : std::runtime_error("Search cancelled") {}
+};
+
+//! Thrown by a search that ran out of memory, so that the caller can decide whether that ends the whole
+//! process (a single search) or only the engine that ran out of memory (a portfolio, see Runner::run_portfolio)
+class SearchOutOfMemory : public std::runtime_error {
+public:
+	SearchOutOfMemory() : std::runtime_error("Search ran out of memory") {}
+};
+
+//! A process-wide flag to cooperatively cancel all running searches, e.g. once some engine of a portfolio
+//! has already found a plan. The state models check the flag at each expansion (see 'check'), which unwinds
+//! the search of any engine through a SearchCancelled exception without the engines having to know about it.
+class Cancellation {
+public:
+	//! Request that all running searches stop as soon as possible
+	static void request() { _requested.store(true, std::memory_order_relaxed); }
+
+	static bool requested() { return _requested.load(std::memory_order_relaxed); }
+
+	//! Throw a SearchCancelled exception iff cancellation has been requested
+	static void check() {
+		if (requested()) throw SearchCancelled();
+	}
+
+	static void reset() { _requested.store(false, std::memory_order_relaxed); }
+
+protected:
+	static inline std::atomic<bool> _requested{false};
+};
+
+} // namespaces
@@ -0,0 +1,200 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+
+namespace fs0 {
+
+//! A closed list that can be extended concurrently from several threads, without locks.
+//! Entries (typically search nodes, which own their state) are constructed in a per-worker store,
+//! and published into an open-addressing (linear probing) hash table of atomic pointers by a CAS
+//! on the first empty slot of their probe sequence. Entries are never moved nor freed while the list
+//! lives, hence a pointer to an entry is valid for the whole search, e.g. as the parent pointer of other entries.
+//! The table cannot grow while it is concurrently extended: 'reserve' needs to be called in between,
+//! e.g. once per layer of a layer-synchronous search, to guarantee that there is room for the next insertions.
+//! EntryT needs to have a public 'state' member and a 'hash()' method returning the hash of that state.
+template <typename EntryT>
+class ConcurrentClosedList {
+public:
+	ConcurrentClosedList(unsigned num_workers, std::size_t initial_capacity = 1024) :
+		_stores(num_workers), _table(capacity_for(initial_capacity)), _size(0)
+	{}
+	~ConcurrentClosedList() = default;
+
+	ConcurrentClosedList(const ConcurrentClosedList&) = delete;
+	ConcurrentClosedList(ConcurrentClosedList&&) = delete;
+	ConcurrentClosedList& operator=(const ConcurrentClosedList&) = delete;
+	ConcurrentClosedList& operator=(ConcurrentClosedList&&) = delete;
+
+	//! Construct an entry from the given arguments in the store of the given worker, and insert it in the list
+	//! unless some entry with an equal state was already there. Return the entry that ends up in the list,
+	//! plus a flag indicating whether it is the new one.
+	//! Can be called concurrently, as long as no two threads use the same worker index at the same time.
+	template <typename... Args>
+	std::pair<const EntryT*, bool> insert(unsigned worker, Args&&... args) {
+		assert(worker < _stores.size());
+		auto& store = _stores[worker].entries;
+		store.emplace_back(std::forward<Args>(args)...);
+		const EntryT* entry = &store.back();
+
+		const std::size_t hash = entry->hash();
+		const std::size_t mask = _table.size() - 1;
+		assert(_size.load(std::memory_order_relaxed) < _table.size()); // Otherwise 'reserve' has not been called as it should
+
+		for (std::size_t i = hash & mask; ; i = (i + 1) & mask) {
+			const EntryT* current = _table[i].load(std::memory_order_acquire);
+			if (!current) {
+				if (_table[i].compare_exchange_strong(current, entry, std::memory_order_acq_rel, std::memory_order_acquire)) {
+					_size.fetch_add(1, std::memory_order_relaxed);
+					return std::make_pair(entry, true);
+				}
+				// Some other thread has just published its entry into the slot, which is now in 'current'
+			}
+
+			if (current->hash() == hash && current->state == entry->state) {
+				store.pop_back(); // The entry has not been published, hence nobody else can be referring to it
+				return std::make_pair(current, false);
+			}
+		}
+	}
+
+	//! Make sure that the list has room for 'n' more entries. Not thread-safe.
+	void reserve(std::size_t n) {
+		const std::size_t capacity = capacity_for(size() + n);
+		if (capacity <= _table.size()) return;
+
+		std::vector<std::atomic<const EntryT*>> table(capacity);
+		const std::size_t mask = capacity - 1;
+		for (const auto& slot:_table) {
+			const EntryT* entry = slot.load(std::memory_order_relaxed);
+			if (!entry) continue;
+			std::size_t i = entry->hash() & mask;
+			while (table[i].load(std::memory_order_relaxed)) i = (i + 1) & mask;
+			table[i].store(entry, std::memory_order_relaxed);
+		}
+		_table.swap(table);
+	}
+
+	//! The number of entries in the list
+	std::size_t size() const { return _size.load(std::memory_order_relaxed); }
+
+protected:
+	//! The entries created by some worker. Aligned to a cache line, so that workers do not interfere.
+	//! A deque guarantees that addresses are not invalidated upon insertion.
+	struct alignas(64) StoreT {
+		std::deque<EntryT> entries;
+	};
+
+	std::vector<StoreT> _stores;
+
+	//! The hash table, whose size is always a power of two
+	std::vector<std::atomic<const EntryT*>> _table;
+
+	std::atomic<std::size_t> _size;
+
+	//! The size of a table that can hold 'n' entries with a load factor of at most 1/2
+	static std::size_t capacity_for(std::size_t n) {
+		std::size_t capacity = 16;
+		while (capacity < 2 * n) capacity <<= 1;
+		return capacity;
+	}
+};
+
+
+
+//! A closed list that can be extended concurrently from several threads and which, unlike ConcurrentClosedList,
+//! grows as needed, and hence does not require the search to synchronize its threads periodically.
+//! The hash table is split into a number of independent stripes, chosen by the high bits of the hash of each entry,
+//! and each protected by its own lock, which is held only while probing (and possibly growing) the stripe.
+//! With a number of stripes much larger than the number of threads, threads rarely contend for the same one.
+//! As in ConcurrentClosedList, entries are constructed in per-worker stores and are never moved nor freed.
+template <typename EntryT>
+class StripedClosedList {
+public:
+	StripedClosedList(unsigned num_workers, unsigned stripe_bits = 8) :
+		_stores(num_workers), _stripes(std::size_t(1) << stripe_bits), _stripe_bits(stripe_bits), _size(0)
+	{
+		assert(stripe_bits > 0 && stripe_bits < 32);
+		for (auto& stripe:_stripes) stripe.table.resize(16, nullptr);
+	}
+	~StripedClosedList() = default;
+
+	StripedClosedList(const StripedClosedList&) = delete;
+	StripedClosedList(StripedClosedList&&) = delete;
+	StripedClosedList& operator=(const StripedClosedList&) = delete;
+	StripedClosedList& operator=(StripedClosedList&&) = delete;
+
+	//! Construct an entry from the given arguments in the store of the given worker, and insert it in the list
+	//! unless some entry with an equal state was already there. Return the entry that ends up in the list,
+	//! plus a flag indicating whether it is the new one.
+	//! Can be called concurrently, as long as no two threads use the same worker index at the same time.
+	template <typename... Args>
+	std::pair<const EntryT*, bool> insert(unsigned worker, Args&&... args) {
+		assert(worker < _stores.size());
+		auto& store = _stores[worker].entries;
+		store.emplace_back(std::forward<Args>(args)...);
+		const EntryT* entry = &store.back();
+
+		const std::size_t hash = entry->hash();
+		StripeT& stripe = _stripes[(uint64_t(hash) >> (64 - _stripe_bits))];
+
+		std::lock_guard<std::mutex> lock(stripe.mutex);
+		const std::size_t mask = stripe.table.size() - 1;
+		std::size_t i = hash & mask;
+		for (; stripe.table[i]; i = (i + 1) & mask) {
+			const EntryT* current = stripe.table[i];
+			if (current->hash() == hash && current->state == entry->state) {
+				store.pop_back(); // The entry has not been published, hence nobody else can be referring to it
+				return std::make_pair(current, false);
+			}
+		}
+
+		stripe.table[i] = entry;
+		_size.fetch_add(1, std::memory_order_relaxed);
+
+		// Keep the load factor of the stripe below 1/2
+		if (2 * ++stripe.size > stripe.table.size()) grow(stripe);
+		return std::make_pair(entry, true);
+	}
+
+	//! The number of entries in the list
+	std::size_t size() const { return _size.load(std::memory_order_relaxed); }
+
+protected:
+	struct alignas(64) StoreT {
+		std::deque<EntryT> entries;
+	};
+
+	struct alignas(64) StripeT {
+		std::mutex mutex;
+		std::vector<const EntryT*> table; // Its size is always a power of two
+		std::size_t size = 0;
+	};
+
+	std::vector<StoreT> _stores;
+	std::vector<StripeT> _stripes;
+	const unsigned _stripe_bits;
+
+	std::atomic<std::size_t> _size;
+
+	//! Double the size of the given (locked) stripe
+	static void grow(StripeT& stripe) {
+		std::vector<const EntryT*> table(2 * stripe.table.size(), nullptr);
+		const std::size_t mask = table.size() - 1;
+		for (const EntryT* entry:stripe.table) {
+			if (!entry) continue;
+			std::size_t i = entry->hash() & mask;
+			while (table[i]) i = (i + 1) & mask;
+			table[i] = entry;
+		}
+		stripe.table.swap(table);
+	}
+};
+
+} // namespaces
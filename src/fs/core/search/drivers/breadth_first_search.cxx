@@ -31,9 +31,9 @@ BreadthFirstSearchDriver<SDDLiftedStateModel>::setup(Problem& problem) const {
 template <typename StateModelT>
 ExitCode
 BreadthFirstSearchDriver<StateModelT>::search(Problem& problem, const Config& config, const EngineOptions& options, float start_time) {
-	//! The Breadth-First Search engine uses a simple blind-search node
+	//! The Breadth-First Search engine uses a simple blind-search node, with states interned in a registry
 	using ActionT = typename StateModelT::ActionType;
-	using NodeT = lapkt::BlindSearchNode<State, ActionT>;
+	using NodeT = lapkt::RegisteredBlindSearchNode<ActionT>;
 	using EngineT = lapkt::StlBreadthFirstSearch<NodeT, StateModelT, SearchStats>;
 
     auto model = setup(problem);
@@ -45,8 +45,10 @@ NativeActionDriver<HeuristicT>::create(const Config& config, const GroundStateMo
 
 	_heuristic = std::unique_ptr<HeuristicT>(configure_heuristic(problem, config));
 
+	_cache = HeuristicCache::create(config);
+
 	EventUtils::setup_stats_observer<NodeT>(stats, _handlers, config.getOption<bool>("verbose_stats", false));
-	EventUtils::setup_evaluation_observer<NodeT, HeuristicT>(config, *_heuristic, stats, _handlers);
+	EventUtils::setup_evaluation_observer<NodeT, HeuristicT>(config, *_heuristic, stats, _handlers, _cache.get());
 
 	auto engine = new EngineT(model, gecode::build_monotonicity_csp(problem, config));
 	lapkt::events::subscribe(*engine, _handlers);
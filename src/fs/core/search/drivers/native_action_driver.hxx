@@ -35,6 +35,7 @@ public:
 
 protected:
 	std::unique_ptr<HeuristicT> _heuristic;
+	std::unique_ptr<HeuristicCache> _cache;
 	std::vector<std::unique_ptr<lapkt::events::EventHandler>> _handlers;
 	
 public:
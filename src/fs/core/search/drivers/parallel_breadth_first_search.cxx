@@ -0,0 +1,32 @@
+
+#include <fs/core/search/drivers/parallel_breadth_first_search.hxx>
+
+#include <fs/core/state.hxx>
+#include <fs/core/search/algorithms/parallel_breadth_first_search.hxx>
+#include <fs/core/search/utils.hxx>
+#include <fs/core/search/drivers/setups.hxx>
+
+
+namespace fs0::drivers {
+
+GroundStateModel
+ParallelBreadthFirstSearchDriver::setup(Problem& problem) const {
+	return GroundingSetup::fully_ground_model(problem);
+}
+
+ExitCode
+ParallelBreadthFirstSearchDriver::search(Problem& problem, const Config& config, const EngineOptions& options, float start_time) {
+	using EngineT = lapkt::ParallelBreadthFirstSearch<GroundStateModel, SearchStats>;
+
+	int block_size = config.getOption<int>("bfs.block_size", 65536);
+	if (block_size <= 0) throw std::runtime_error("The block size given by option 'bfs.block_size' must be positive");
+
+	auto model = setup(problem);
+	auto engine = std::make_unique<EngineT>(model, _stats,
+	                                        ThreadPool::num_workers(config, "threads"),
+	                                        (std::size_t) block_size,
+	                                        config.getOption<bool>("verbose_stats", false));
+	return Utils::SearchExecution<GroundStateModel>(model).do_search(*engine, options, start_time, _stats);
+}
+
+} // namespaces
@@ -0,0 +1,27 @@
+
+#pragma once
+
+#include <fs/core/search/drivers/registry.hxx>
+#include <fs/core/search/stats.hxx>
+
+
+namespace fs0 { class Config; class GroundStateModel; }
+
+namespace fs0::drivers {
+
+
+//! A creator for a multi-threaded Breadth-First Search engine. Only ground models are supported,
+//! since the engine relies on the reentrant batch expansion of GroundStateModel.
+//! The number of threads is given by the "threads" option (0 meaning as many as hardware threads).
+class ParallelBreadthFirstSearchDriver : public Driver {
+public:
+
+	GroundStateModel setup(Problem& problem) const;
+
+	ExitCode search(Problem& problem, const Config& config, const EngineOptions& options, float start_time) override;
+
+protected:
+	SearchStats _stats;
+};
+
+} // namespaces
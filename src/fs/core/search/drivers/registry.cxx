@@ -4,7 +4,9 @@
 // #include <fs/core/search/drivers/gbfs_constrained.hxx>
 #include <fs/core/search/drivers/iterated_width.hxx>
 #include <fs/core/search/drivers/breadth_first_search.hxx>
+#include <fs/core/search/drivers/parallel_breadth_first_search.hxx>
 #include <fs/core/search/drivers/sbfws/sbfws.hxx>
+#include <fs/core/search/drivers/sbfws/parallel_sbfws.hxx>
 // #include <fs/core/search/drivers/unreached_atom_driver.hxx>
 // #include <fs/core/search/drivers/native_driver.hxx>
 #include <fs/core/heuristics/unsat_goal_atoms.hxx>
@@ -46,10 +48,12 @@ EngineRegistry::EngineRegistry() {
 	add("bfws",  new bfws::SBFWSDriver<SimpleStateModel>());
 	add("bfws-csp",  new bfws::SBFWSDriver<CSPLiftedStateModel>());
     add("bfws-sdd",  new bfws::SBFWSDriver<SDDLiftedStateModel>());
+	add("bfws-par",  new bfws::ParallelSBFWSDriver());
 	
 	add("bfs",  new BreadthFirstSearchDriver<GroundStateModel>());
 	add("bfs-csp",  new BreadthFirstSearchDriver<CSPLiftedStateModel>());
     add("bfs-sdd",  new BreadthFirstSearchDriver<SDDLiftedStateModel>());
+	add("bfs-par",  new ParallelBreadthFirstSearchDriver());
 	
 	add("smart",  new SmartEffectDriver());
 	add("lsmart",  new SmartLiftedDriver());
@@ -3,9 +3,39 @@
 #include <fs/core/search/drivers/sbfws/base.hxx>
 #include <fs/core/utils/config.hxx>
 #include <fs/core/problem_info.hxx>
+#include <fs/core/utils/atom_index.hxx>
 
 namespace fs0::bfws {
 
+unsigned setup_novelty_levels(const Problem& problem, unsigned num_subgoals, const Config& global_config) {
+    const AtomIndex& atomidx = problem.get_tuple_index();
+
+    // Allow the user to override the automatic configuration of the levels of novelty
+    int user_option = global_config.getOption<int>("novelty_levels", -1);
+    if (user_option != -1) {
+        if (user_option != 2 && user_option != 3) {
+            throw std::runtime_error("Unsupported novelty levels: " + std::to_string(user_option));
+        }
+
+        LPT_INFO("search", "(User-specified) Novelty levels of the search:  " << user_option);
+        return user_option;
+    }
+
+    unsigned expected_R_size = 10; // TODO ???? What value expected for |R|??
+    const unsigned num_atoms = atomidx.size();
+
+    float size_novelty2_table = ((float) num_atoms*(num_atoms-1)+num_atoms) / (1024*1024*8.);
+    float size_novelty2_tables = num_subgoals * expected_R_size * size_novelty2_table;
+
+    unsigned levels = (size_novelty2_tables > 2048) ? 2 : 3;
+
+    LPT_INFO("search", "Size of a single specialized novelty-2 table estimated at (MB): " << size_novelty2_table);
+    LPT_INFO("search", "Expected overall size of all novelty-two tables (MB): " << size_novelty2_tables);
+    LPT_INFO("search", "Novelty levels of the search:  " << levels);
+
+    return levels;
+}
+
 template <typename FeatureValueT>
 NoveltyFactory<FeatureValueT>::
 NoveltyFactory(const Problem& problem, SBFWSConfig::NoveltyEvaluatorType desired_evaluator_t, bool use_extra_features, unsigned max_expected_width) :
@@ -4,7 +4,7 @@
 #include <fs/core/search/drivers/sbfws/config.hxx>
 #include <fs/core/search/novelty/fs_novelty.hxx>
 
-namespace fs0 { class Problem; }
+namespace fs0 { class Problem; class Config; }
 
 namespace fs0::bfws {
 
@@ -14,6 +14,11 @@ inline unsigned _index(unsigned unachieved, unsigned relaxed_achieved) {
     return (unachieved<<16) | relaxed_achieved;
 }
 
+//! Decide how many levels of novelty w_{#g,#r} the search will distinguish (2 or 3),
+//! based on the expected memory footprint of the width-2 novelty tables, unless the user
+//! chooses explicitly through the "novelty_levels" option.
+unsigned setup_novelty_levels(const Problem& problem, unsigned num_subgoals, const Config& global_config);
+
 // Index the novelty tables by <#g, #r>
 struct SBFWSNoveltyIndexer {
     unsigned operator()(unsigned unachieved, unsigned relaxed_achieved) const {
@@ -1,12 +1,15 @@
 
 #pragma once
 
+#include <deque>
 #include <unordered_set>
 
 #include <lapkt/tools/resources_control.hxx>
 #include <lapkt/tools/logging.hxx>
 
 #include <fs/core/problem.hxx>
+#include <fs/core/search/state_registry.hxx>
+#include <fs/core/search/nodes/node_pool.hxx>
 
 #include <fs/core/search/drivers/sbfws/base.hxx>
 #include <fs/core/search/drivers/sbfws/iw_run_config.hxx>
@@ -17,20 +20,22 @@
 #include <utility>
 #include <fs/core/utils/printers/vector.hxx>
 #include <fs/core/utils/printers/actions.hxx>
-#include <lapkt/search/components/open_lists.hxx>
 #include <fs/core/utils/config.hxx>
 
 
 namespace fs0::bfws {
 
 template <typename StateT, typename ActionType>
-class IWRunNode {
+class IWRunNode : public lapkt::PooledNode<IWRunNode<StateT, ActionType>> {
 public:
     using ActionT = ActionType;
-    using PT = std::shared_ptr<IWRunNode<StateT, ActionT>>;
+    using PT = lapkt::IntrusivePtr<IWRunNode<StateT, ActionT>>;
 
-    //! The state in this node
-    StateT state;
+    //! The ID of the state in this node
+    StateID state_id;
+
+    //! The state in this node, interned in the registry of the IW run
+    const StateT& state;
 
     //! The action that led to this node
     typename ActionT::IdType action;
@@ -63,19 +68,18 @@ public:
     uint32_t _gen_order;
 
 
-    IWRunNode() = default;
     ~IWRunNode() = default;
     IWRunNode(const IWRunNode&) = default;
     IWRunNode(IWRunNode&&) = delete;
     IWRunNode& operator=(const IWRunNode&) = delete;
     IWRunNode& operator=(IWRunNode&&) = delete;
 
-    //! Constructor with full copying of the state (expensive)
-    IWRunNode(const StateT& s, unsigned long gen_order) : IWRunNode(StateT(s), ActionT::invalid_action_id, nullptr, gen_order) {}
+    //! Constructor for the root node
+    IWRunNode(const StateRegistry& registry, StateID id, unsigned long gen_order) : IWRunNode(registry, id, ActionT::invalid_action_id, nullptr, gen_order) {}
 
-    //! Constructor with move of the state (cheaper)
-    IWRunNode(StateT&& _state, typename ActionT::IdType _action, PT _parent, uint32_t gen_order) :
-        state(std::move(_state)),
+    IWRunNode(const StateRegistry& registry, StateID id, typename ActionT::IdType _action, PT _parent, uint32_t gen_order) :
+        state_id(id),
+        state(registry.get(id)),
 //		feature_valuation(0),
         action(_action),
         parent(_parent),
@@ -114,7 +118,7 @@ public:
         return os;
     }
 
-    bool operator==( const IWRunNode<StateT, ActionT>& o ) const { return state == o.state; }
+    bool operator==( const IWRunNode<StateT, ActionT>& o ) const { return state_id == o.state_id; }
 
     std::size_t hash() const { return state.hash(); }
 };
@@ -139,11 +143,11 @@ public:
     using StateT = typename StateModel::StateT;
 
     using ActionIdT = typename StateModel::ActionType::IdType;
-    using NodePT = std::shared_ptr<NodeT>;
+    using NodePT = typename NodeT::PT;
 
     using FeatureValueT = typename NoveltyEvaluatorT::FeatureValueT;
 
-    using OpenListT = lapkt::SimpleQueue<NodeT>;
+    using OpenListT = std::deque<NodePT>;
 
 
 protected:
@@ -153,6 +157,9 @@ protected:
     //! The simulation configuration
     IWRunConfig _config;
 
+    //! The pool from which all the nodes of the run are allocated
+    lapkt::NodePool<NodeT> _pool;
+
     //!
     std::vector<NodePT> _optimal_paths;
 
@@ -165,6 +172,9 @@ protected:
     //! A single novelty evaluator will be in charge of evaluating all nodes
     std::unique_ptr<SimulationEvaluatorI<NodeT>> _evaluator;
 
+    //! The registry where the states generated during the run are interned
+    StateRegistry _registry;
+
     //! Some node counts
     uint32_t _generated;
     uint32_t _w1_nodes_expanded;
@@ -185,10 +195,12 @@ public:
     IWRun(const StateModel& model, const FeatureSetT& featureset, NoveltyEvaluatorT* evaluator, IWRunConfig config, BFWSStats& stats, bool verbose) :
         _model(model),
         _config(std::move(config)),
+        _pool(),
         _optimal_paths(model.num_subgoals()),
         _unreached(),
         _in_seed(),
         _evaluator(),
+        _registry(),
         _generated(1),
         _w1_nodes_expanded(0),
         _w2_nodes_expanded(0),
@@ -228,6 +240,7 @@ public:
         _w2_nodes_generated = 0;
         _w_gt2_nodes_generated = 0;
         _evaluator->reset();
+        _registry.clear();
     }
 
     ~IWRun() = default;
@@ -543,7 +556,7 @@ public:
     bool run(const StateT& seed, unsigned max_width) {
         if (_verbose) LPT_INFO("cout", "Simulation - Starting IW(" << max_width << ") Simulation");
 
-        NodePT root = std::make_shared<NodeT>(seed, _generated++);
+        NodePT root = _pool.make(_registry, _registry.insert(seed).first, _generated++);
         mark_seed_subgoals(root);
 
         auto nov =_evaluator->evaluate(*root);
@@ -553,21 +566,34 @@ public:
 // 		LPT_DEBUG("cout", "Simulation - Seed node: " << *root);
         OpenListT open;
 
-        open.insert(root);
+        open.push_back(root);
         auto simt0 = aptk::time_used();
 
 //        std::cout << "Novelty of root node: " << _evaluator->evaluate(*root) << std::endl;
 
-        // Note that we don't used any closed list / duplicate detection of any kind, but let the novelty engine take care of that
+        // There is no closed list, but states are interned in the registry, so that a duplicate of a state already seen
+        // in this run is detected on generation, and (with the standard evaluator) skipped without evaluating its novelty.
+        // The states of pruned nodes that reach no new subgoal are released from the registry.
         while (!open.empty()) {
-            NodePT current = open.next();
+            NodePT current = std::move(open.front());
+            open.pop_front();
 
             // Expand the node
             update_novelty_counters_on_expansion(current->_w);
 
             for (const auto& a : _model.applicable_actions(current->state)) {
-                StateT s_a = _model.next(current->state, a);
-                NodePT successor = std::make_shared<NodeT>(std::move(s_a), a, current, _generated++);
+                auto registered = _registry.insert(_model.next(current->state, a));
+
+                // A state that has already been seen in this run cannot be novel wrt the standard simulation
+                // evaluator, nor can it reach any new subgoal, so we can skip its evaluation altogether.
+                // This is not the case of the achiever evaluator, where novelty depends also on the action.
+                if (!registered.second && !_config._use_achiever_evaluator) {
+                    ++_generated;
+                    update_novelty_counters_on_generation(std::numeric_limits<unsigned char>::max());
+                    continue;
+                }
+
+                NodePT successor = _pool.make(_registry, registered.first, a, current, _generated++);
 
                 successor->_w = _evaluator->evaluate(*successor);
                 update_novelty_counters_on_generation(successor->_w);
@@ -576,6 +602,7 @@ public:
 
                 if (_model.goal(successor->state)) LPT_INFO("cout", "Simulation - Goal state reached during simulation");
 
+                std::size_t num_unreached = _unreached.size();
                 if (process_node(successor)) {  // i.e. all subgoals have been reached before reaching the bound
                     report("All subgoals reached", max_width);
 //                    _evaluator->info();
@@ -583,7 +610,10 @@ public:
                 }
 
                 if (successor->_w <= max_width) {
-                    open.insert(successor);
+                    open.push_back(successor);
+                } else if (registered.second && _unreached.size() == num_unreached) {
+                    // The node is pruned and reaches no new subgoal, hence no one will ever refer to its state again
+                    _registry.release(successor->state_id);
                 }
 
                 if (_generated % 1000 == 0) {
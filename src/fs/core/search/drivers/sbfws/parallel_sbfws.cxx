@@ -0,0 +1,29 @@
+#include <lapkt/tools/logging.hxx>
+
+#include <fs/core/search/drivers/sbfws/parallel_sbfws.hxx>
+#include <fs/core/search/drivers/setups.hxx>
+#include <fs/core/search/utils.hxx>
+#include <fs/core/utils/config.hxx>
+
+namespace fs0::bfws {
+
+ExitCode
+ParallelSBFWSDriver::search(Problem& problem, const Config& config, const drivers::EngineOptions& options, float start_time) {
+    using EngineT = ParallelSBFWS<SimpleStateModel>;
+
+    SBFWSConfig bfws_config(config);
+    if (bfws_config.relevant_set_type != SBFWSConfig::RelevantSetType::None) {
+        throw std::runtime_error("The parallel SBFWS search only supports the option \"bfws.rs=none\"");
+    }
+
+    auto model = drivers::GroundingSetup::fully_ground_simple_model(problem);
+
+    bool actionless = model.getTask().getPartiallyGroundedActions().empty() &&
+            model.getTask().getGroundActions().empty();
+
+    auto engine = std::make_unique<EngineT>(model, _stats, bfws_config, ThreadPool::num_workers(config, "threads"));
+
+    return drivers::Utils::SearchExecution<SimpleStateModel>(model).do_search(*engine, options, start_time, _stats, actionless);
+}
+
+} // namespaces
@@ -0,0 +1,403 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <queue>
+#include <thread>
+
+#include <fs/core/search/drivers/registry.hxx>
+#include <fs/core/search/drivers/sbfws/base.hxx>
+#include <fs/core/search/drivers/sbfws/stats.hxx>
+#include <fs/core/search/drivers/sbfws/sbfws.hxx>
+#include <fs/core/search/novelty/concurrent_novelty.hxx>
+#include <fs/core/search/concurrent_closed_list.hxx>
+#include <fs/core/heuristics/unsat_goal_atoms.hxx>
+#include <fs/core/utils/atom_index.hxx>
+#include <fs/core/utils/thread_pool.hxx>
+#include <fs/core/utils/system.hxx>
+
+#include <lapkt/tools/resources_control.hxx>
+
+
+namespace fs0::bfws {
+
+//! The node type of the parallel BFWS search. Nodes are owned by a StripedClosedList, which never moves
+//! nor frees them during the search, hence they own their state and refer to their parent through a raw pointer.
+template <typename ActionT>
+class ParallelSBFWSNode {
+public:
+    using action_t = typename ActionT::IdType;
+
+    State state;
+
+    action_t action;
+
+    const ParallelSBFWSNode<ActionT>* parent;
+
+    unsigned g;
+
+    //! The number of unachieved goals (#g)
+    uint32_t unachieved_subgoals;
+
+    //! The generation order, uniquely identifies the node
+    uint32_t _gen_order;
+
+    //! The numeric value of the novelty w_{#g}
+    unsigned short w_g_r;
+
+    //! Constructor for the root node
+    ParallelSBFWSNode(State&& state_, uint32_t gen_order) : ParallelSBFWSNode(std::move(state_), ActionT::invalid_action_id, nullptr, gen_order) {}
+
+    ParallelSBFWSNode(State&& state_, action_t action_, const ParallelSBFWSNode<ActionT>* parent_, uint32_t gen_order) :
+        state(std::move(state_)), action(action_), parent(parent_), g(parent ? parent->g+1 : 0),
+        unachieved_subgoals(std::numeric_limits<unsigned>::max()),
+        _gen_order(gen_order),
+        w_g_r(999)
+    {
+        assert(_gen_order > 0);
+    }
+
+    ~ParallelSBFWSNode() = default;
+    ParallelSBFWSNode(const ParallelSBFWSNode&) = delete;
+    ParallelSBFWSNode(ParallelSBFWSNode&&) = delete;
+    ParallelSBFWSNode& operator=(const ParallelSBFWSNode&) = delete;
+    ParallelSBFWSNode& operator=(ParallelSBFWSNode&&) = delete;
+
+    bool has_parent() const { return parent != nullptr; }
+
+    bool operator==( const ParallelSBFWSNode<ActionT>& o ) const { return state == o.state; }
+
+    std::size_t hash() const { return state.hash(); }
+
+    //! Print the node into the given stream
+    friend std::ostream& operator<<(std::ostream &os, const ParallelSBFWSNode<ActionT>& object) { return object.print(os); }
+    std::ostream& print(std::ostream& os) const {
+        os << "#" << _gen_order << " (" << this << "), " << state;
+        os << ", g = " << g <<  ", w_g=" << w_g_r << ", #g=" << unachieved_subgoals;
+        os << ", parent = " << (parent ? "#" + std::to_string(parent->_gen_order) : "None");
+        if (action != ActionT::invalid_action_id) os << ", a = " << action;
+        else os << ", a = None";
+        return os << "}";
+    }
+
+    bool decreases_unachieved_subgoals() const {
+        return (!has_parent() || unachieved_subgoals < parent->unachieved_subgoals);
+    }
+};
+
+
+//! A multi-threaded version of the SBFWS search, restricted to the novelty measure w_{#g}, i.e. to the
+//! configuration with no set R of relevant atoms (bfws.rs=none), since simulations are not thread-safe.
+//! All threads run the same loop: pop the best node from the open list, expand it through the (reentrant)
+//! 'expand' method of the state model, evaluate the novelty of the new successors and push them into the open list.
+//! - The open list is sharded: there is one priority queue ordered by 'novelty_comparer' per thread, each with
+//!   its own lock. Successors are distributed among the shards by hash, so that all of them hold similarly good nodes;
+//!   a thread pops from its own shard, and steals from the rest when its own shard is empty.
+//! - The closed list is a StripedClosedList.
+//! - Novelty tables are ConcurrentNoveltyTables, created lazily for each value of #g, so that novelty checks are lock-free.
+//! Nodes are thus not expanded in exactly the same order as in the sequential search, but the search is still complete.
+template <typename StateModelT>
+class ParallelSBFWS {
+public:
+    using StateT = typename StateModelT::StateT;
+    using ActionT = typename StateModelT::ActionType;
+    using ActionIdT = typename ActionT::IdType;
+    using SuccessorT = typename StateModelT::SuccessorT;
+    using NodeT = ParallelSBFWSNode<ActionT>;
+    using PlanT =  std::vector<ActionIdT>;
+
+protected:
+    using NoveltyComparerT = novelty_comparer<const NodeT*>;
+
+    //! A shard of the open list
+    struct alignas(64) ShardT {
+        std::mutex mutex;
+        std::priority_queue<const NodeT*, std::vector<const NodeT*>, NoveltyComparerT> queue;
+    };
+
+    //! The search model
+    const StateModelT& _model;
+
+    const AtomIndex& _atom_index;
+
+    //! The threads that run the search
+    ThreadPool _pool;
+
+    StripedClosedList<NodeT> _closed;
+
+    std::vector<ShardT> _open;
+
+    //! The number of nodes that are either in the open list or being expanded.
+    //! When it goes down to zero, the search space has been exhausted.
+    std::atomic<std::size_t> _pending;
+
+    std::atomic<const NodeT*> _solution;
+
+    //! _tables[k][#g] is the width-k novelty table for nodes with #g unachieved subgoals, or nullptr if not created yet
+    std::vector<std::vector<std::atomic<ConcurrentNoveltyTable*>>> _tables;
+
+    //! A counter to count the number of unsatisfied goals
+    UnsatisfiedGoalAtomsCounter _unsat_goal_atoms_heuristic;
+
+    BFWSStats& _stats;
+
+    //! The stats of each of the threads, which are added up into '_stats' at the end of the search
+    std::vector<BFWSStats> _thread_stats;
+
+    //! The number of generated nodes so far
+    std::atomic<uint32_t> _generated;
+
+    //! The minimum number of subgoals-to-reach that we have achieved at any moment of the search
+    std::atomic<unsigned> _min_subgoals_to_reach;
+
+    //! How many novelty levels we want to use in the search.
+    unsigned _novelty_levels;
+
+public:
+    ParallelSBFWS(const StateModelT& model, BFWSStats& stats, const SBFWSConfig& config, unsigned num_threads) :
+        _model(model),
+        _atom_index(model.getTask().get_tuple_index()),
+        _pool(num_threads),
+        _closed(_pool.size()),
+        _open(_pool.size()),
+        _pending(0),
+        _solution(nullptr),
+        _tables(3),
+        _unsat_goal_atoms_heuristic(model.getTask().getGoalConditions(), _atom_index),
+        _stats(stats),
+        _thread_stats(_pool.size()),
+        _generated(0),
+        _min_subgoals_to_reach(std::numeric_limits<unsigned>::max()),
+        _novelty_levels(setup_novelty_levels(model.getTask(), model.num_subgoals(), config._global_config))
+    {
+        // #g can take any value between 0 and the number of goal atoms
+        for (unsigned k = 1; k < _tables.size(); ++k) {
+            _tables[k] = std::vector<std::atomic<ConcurrentNoveltyTable*>>(_unsat_goal_atoms_heuristic.num_atoms() + 1);
+            for (auto& table:_tables[k]) table.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    ~ParallelSBFWS() {
+        for (auto& tables:_tables) for (auto& table:tables) delete table.load();
+    }
+
+    ParallelSBFWS(const ParallelSBFWS&) = delete;
+    ParallelSBFWS(ParallelSBFWS&&) = delete;
+    ParallelSBFWS& operator=(const ParallelSBFWS&) = delete;
+    ParallelSBFWS& operator=(ParallelSBFWS&&) = delete;
+
+    //! Convenience method
+    bool solve_model(PlanT& solution) { return search(_model.init(), solution); }
+
+    bool search(const StateT& s, PlanT& plan) {
+        LPT_INFO("cout", "Parallel SBFWS search with " << _pool.size() << " threads");
+        LPT_INFO("cout", "Mem. usage on start of SBFWS search: " << get_current_memory_in_kb() << "kB. / " << get_peak_memory_in_kb() << " kB.");
+
+        const NodeT* root = _closed.insert(0, StateT(s), ++_generated).first;
+        std::vector<AtomIdx> atoms, novel;
+        create_node(root, 0, atoms, novel);
+
+        // Each thread runs the search loop until a solution is found or the search space is exhausted
+        _pool.parallel_for(_pool.size(), [this](std::size_t, unsigned worker) { work(worker); });
+
+        for (const auto& stats:_thread_stats) _stats.add_search_counters(stats);
+
+        return extract_plan(_solution.load(), plan);
+    }
+
+protected:
+    //! The search loop of a single thread
+    void work(unsigned worker) {
+        std::vector<SuccessorT> successors;
+        std::vector<AtomIdx> atoms, novel;
+
+        while (!_solution.load(std::memory_order_acquire)) {
+            const NodeT* node = pop(worker);
+            if (!node) {
+                if (_pending.load(std::memory_order_acquire) == 0) break; // The search space has been exhausted
+                std::this_thread::yield(); // Some other thread is expanding a node, which might generate new ones
+                continue;
+            }
+
+            expand_node(node, worker, successors, atoms, novel);
+            _pending.fetch_sub(1, std::memory_order_acq_rel);
+        }
+    }
+
+    void expand_node(const NodeT* node, unsigned worker, std::vector<SuccessorT>& successors, std::vector<AtomIdx>& atoms, std::vector<AtomIdx>& novel) {
+        LPT_DEBUG("cout", *node);
+        BFWSStats& stats = _thread_stats[worker];
+        stats.expansion();
+        if (node->decreases_unachieved_subgoals()) stats.expansion_g_decrease();
+
+        successors.clear();
+        _model.expand(node->state, successors);
+
+        for (SuccessorT& successor:successors) {
+            uint32_t gen_order = ++_generated;
+            stats.generation();
+            if (gen_order % 50000 == 0) {
+                LPT_INFO("cout", "Node generation rate after " << gen_order / 1000 << "K generations (nodes/sec.): " << node_generation_rate(gen_order)
+                        << ". Memory consumption: "<< get_current_memory_in_kb() << "kB. / " << get_peak_memory_in_kb() << " kB.");
+            }
+
+            // Skip the node if it has already been closed, or is currently on the open list
+            auto inserted = _closed.insert(worker, std::move(successor.state), successor.action, node, gen_order);
+            if (!inserted.second) continue;
+
+            if (create_node(inserted.first, worker, atoms, novel)) break;
+        }
+    }
+
+    //! Compute #g and w_{#g} for the given, newly-created node, and push it into the open list.
+    //! Returns true iff the newly-created node is a solution
+    bool create_node(const NodeT* node, unsigned worker, std::vector<AtomIdx>& atoms, std::vector<AtomIdx>& novel) {
+        if (_model.goal(node->state)) {
+            const NodeT* none = nullptr;
+            if (_solution.compare_exchange_strong(none, node, std::memory_order_acq_rel)) {
+                LPT_INFO("search", "Goal node was found");
+            }
+            return true;
+        }
+
+        // The node is not visible to other threads until it is pushed into the open list
+        NodeT& n = const_cast<NodeT&>(*node);
+        BFWSStats& stats = _thread_stats[worker];
+
+        // Compute #g upfront
+        n.unachieved_subgoals = _unsat_goal_atoms_heuristic.evaluate(n.state);
+
+        // Print some stats if a new low in number of unreached subgoals has been reached
+        unsigned current_min = _min_subgoals_to_reach.load(std::memory_order_relaxed);
+        while (n.unachieved_subgoals < current_min) {
+            if (_min_subgoals_to_reach.compare_exchange_weak(current_min, n.unachieved_subgoals, std::memory_order_relaxed)) {
+                LPT_INFO("search", "Min. # unreached subgoals: " << n.unachieved_subgoals << "/" << _model.num_subgoals());
+                break;
+            }
+        }
+
+        compute_atoms(n, atoms, novel);
+
+        n.w_g_r = 999;
+        if (evaluate(n, 1, atoms, novel, stats) == 1) {
+            n.w_g_r = 1;
+
+        } else if (_novelty_levels == 3) {
+            // The pairs of the parent are recorded in the width-2 table only if the parent was evaluated against it
+            bool parent_recorded = n.has_parent() && n.parent->w_g_r != 1;
+            if (evaluate(n, 2, atoms, parent_recorded ? novel : atoms, stats) == 2) {
+                n.w_g_r = 2;
+            }
+        }
+
+        if (n.w_g_r == 1) stats.wgr1_node();
+        else if (n.w_g_r == 2) stats.wgr2_node();
+        else stats.wgr_gt2_node();
+
+        if (n.decreases_unachieved_subgoals()) stats.generation_g_decrease();
+
+        push(node);
+        return false;
+    }
+
+    //! Compute the atoms that hold in the state of the given node, and those among them that are novel wrt
+    //! the parent of the node, or all of them if the parent goes against different novelty tables.
+    void compute_atoms(const NodeT& node, std::vector<AtomIdx>& atoms, std::vector<AtomIdx>& novel) const {
+        atoms.clear();
+        novel.clear();
+        const State& state = node.state;
+        for (VariableIdx var = 0; var < state.numAtoms(); ++var) {
+            object_id value = state.getValue(var);
+            if (o_type(value) == type_id::invalid_t) continue;
+            if (o_type(value) == type_id::bool_t && !bool(value)) continue; // We ignore negative literals
+            atoms.push_back(_atom_index.to_index(var, value));
+        }
+
+        if (!node.has_parent() || node.parent->unachieved_subgoals != node.unachieved_subgoals) {
+            novel = atoms;
+            return;
+        }
+
+        // All tuples of the parent have already been recorded in the very same tables
+        thread_local std::vector<VariableIdx> changed;
+        changed.clear();
+        state.indexer().diff(node.parent->state, state, changed);
+        for (VariableIdx var:changed) {
+            object_id value = state.getValue(var);
+            if (o_type(value) == type_id::invalid_t) continue;
+            if (o_type(value) == type_id::bool_t && !bool(value)) continue;
+            novel.push_back(_atom_index.to_index(var, value));
+        }
+    }
+
+    unsigned evaluate(const NodeT& node, unsigned k, const std::vector<AtomIdx>& atoms, const std::vector<AtomIdx>& novel, BFWSStats& stats) {
+        return fetch_table(k, node.unachieved_subgoals, stats).evaluate(atoms, novel);
+    }
+
+    //! Return the width-k novelty table for the given #g, creating it if necessary
+    ConcurrentNoveltyTable& fetch_table(unsigned k, unsigned type, BFWSStats& stats) {
+        std::atomic<ConcurrentNoveltyTable*>& slot = _tables[k].at(type);
+        ConcurrentNoveltyTable* table = slot.load(std::memory_order_acquire);
+        if (table) return *table;
+
+        auto created = new ConcurrentNoveltyTable(_atom_index.size(), k);
+        if (slot.compare_exchange_strong(table, created, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            stats.search_table_created(k);
+            return *created;
+        }
+        delete created; // Some other thread won the race, and 'table' now points to its table
+        return *table;
+    }
+
+    void push(const NodeT* node) {
+        _pending.fetch_add(1, std::memory_order_acq_rel);
+        ShardT& shard = _open[node->hash() % _open.size()];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.queue.push(node);
+    }
+
+    //! Pop the best node of the shard of the given worker, or of some other shard if that one is empty
+    const NodeT* pop(unsigned worker) {
+        for (std::size_t k = 0; k < _open.size(); ++k) {
+            ShardT& shard = _open[(worker + k) % _open.size()];
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            if (shard.queue.empty()) continue;
+            const NodeT* node = shard.queue.top();
+            shard.queue.pop();
+            return node;
+        }
+        return nullptr;
+    }
+
+    float node_generation_rate(uint32_t generated) {
+        return generated * 1.0 / (aptk::time_used() - _stats.initial_search_time());
+    }
+
+    //! Returns true iff there is an actual plan (i.e. because the given solution node is non-null)
+    bool extract_plan(const NodeT* node, PlanT& plan) const {
+        if (!node) return false;
+        assert(plan.empty());
+
+        while (node->parent) {
+            plan.push_back(node->action);
+            node = node->parent;
+        }
+
+        std::reverse(plan.begin(), plan.end());
+        return true;
+    }
+};
+
+
+//! The driver of the parallel SBFWS search. Only ground models are supported, since the search relies
+//! on the reentrant 'expand' method of SimpleStateModel. The number of threads is given by the "threads" option.
+class ParallelSBFWSDriver : public drivers::Driver {
+public:
+    ExitCode search(Problem& problem, const Config& config, const drivers::EngineOptions& options, float start_time) override;
+
+protected:
+    //! The stats of the search
+    BFWSStats _stats;
+};
+
+} // namespaces
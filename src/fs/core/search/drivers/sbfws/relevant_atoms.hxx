@@ -89,8 +89,8 @@ public:
         if (computation_of_R_necessary(node)) {
             bool verbose = !node.has_parent(); // Print info only on the s0 simulation
             auto R = throw_simulation(node.state, stats, verbose);
-            node._helper = new AtomsetHelper(_problem.get_tuple_index(), R);
-            node._relevant_atoms = new RelevantAtomSet(*node._helper);
+            node._helper.reset(new AtomsetHelper(_problem.get_tuple_index(), R));
+            node._relevant_atoms.reset(new RelevantAtomSet(*node._helper));
 
             //! MRJ: over states
              node._relevant_atoms->init(node.state);
@@ -105,7 +105,7 @@ public:
 
         else {
             // Copy the set R from the parent and update the set of relevant nodes with those that have been reached.
-            node._relevant_atoms = new RelevantAtomSet(compute_R(*node.parent, stats)); // This might trigger a recursive computation
+            node._relevant_atoms.reset(new RelevantAtomSet(compute_R(*node.parent, stats))); // This might trigger a recursive computation
 
             if (node.decreases_unachieved_subgoals()) {
                 //! MRJ:
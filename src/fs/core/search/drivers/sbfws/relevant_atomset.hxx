@@ -1,6 +1,10 @@
 
 #pragma once
 
+#include <memory>
+
+#include <boost/dynamic_bitset.hpp>
+
 #include <lapkt/tools/logging.hxx>
 #include <fs/core/utils/atom_index.hxx>
 #include <fs/core/state.hxx>
@@ -8,11 +12,13 @@
 
 namespace fs0::bfws {
 
- //! A helper object to reduce the memory footprint of RelevantAtomSets
+//! A helper object to reduce the memory footprint of RelevantAtomSets
 class AtomsetHelper {
 public:
+    using BitsetT = boost::dynamic_bitset<>;
+
     //! '_relevant[i]' iff the atom with index 'i' is relevant
-    const std::vector<bool> _relevant;
+    const BitsetT _relevant;
 
 
     //! The number of relevant atoms, i.e. of 'true' values in _relevant
@@ -22,19 +28,32 @@ public:
     const AtomIndex& _atomidx;
 
     AtomsetHelper(const AtomIndex& atomidx, const std::vector<bool>& relevant) :
-        _relevant(relevant), _num_relevant(std::count(relevant.begin(), relevant.end(), true)), _atomidx(atomidx)
+        _relevant(to_bitset(relevant)), _num_relevant(_relevant.count()), _atomidx(atomidx)
     {}
 
     unsigned size() const { return _atomidx.size(); }
+
+protected:
+    static BitsetT to_bitset(const std::vector<bool>& values) {
+        BitsetT bitset(values.size());
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            if (values[i]) bitset.set(i);
+        }
+        return bitset;
+    }
 };
 
 //! A RelevantAtomSet contains information about which of the atoms of a problem are relevant for a certain
 //! goal, and, among those, which have already been reached and which others have not.
+//! The set of reached atoms is a bitset that is shared (copy-on-write) between the set of a node
+//! and those of its descendants, until some descendant reaches some new relevant atom.
 class RelevantAtomSet {
 public:
+    using BitsetT = AtomsetHelper::BitsetT;
+
     //! A RelevantAtomSet is always constructed with all atoms being marked as IRRELEVANT
     explicit RelevantAtomSet(const AtomsetHelper& helper) :
-        _helper(helper), _num_reached(0), _bool_reached(helper.size(), false) //, _updated(false)
+        _helper(helper), _num_reached(0), _reached(std::make_shared<BitsetT>(helper.size()))
     {}
 
     ~RelevantAtomSet() = default;
@@ -47,30 +66,30 @@ public:
     unsigned num_reached() const { return _num_reached; }
 
     void init(const State& state) {
-        _bool_reached = std::vector<bool>(_helper.size(), false);
+        _reached = std::make_shared<BitsetT>(_helper.size());
         _num_reached = 0;
         update(state);
-        assert(_num_reached == std::count(_bool_reached.begin(), _bool_reached.end(), true));
+        assert(_num_reached == _reached->count());
         _num_reached = 0;
     }
 
-    //! Update those atoms that have been reached in the given state
+    //! Update those atoms that have been reached in the given state.
+    //! If a parent state is provided, only the atoms that are new wrt the parent are considered.
     void update(const State& state, const State* parent = nullptr) {
-        unsigned n = state.numAtoms();
-        for (VariableIdx var = 0; var < n; ++var) {
-            const auto& val = state.getValue(var);
-            if (parent && (val == parent->getValue(var))) continue; // If a parent was provided, we check that the value is new wrt the parent
-
-            if (!_helper._atomidx.is_indexed(var, val)) continue;
-
-            AtomIdx atom = _helper._atomidx.to_index(var, val);
-            if (!_helper._relevant[atom]) continue; // we're not concerned about this atom
-
-            std::vector<bool>::reference ref = _bool_reached[atom];
-            if (!ref) {
-                ++_num_reached;
-                ref = true;
+        if (!parent) {
+            unsigned n = state.numAtoms();
+            for (VariableIdx var = 0; var < n; ++var) {
+                mark(var, state.getValue(var));
             }
+            return;
+        }
+
+        // Only those variables that are packed differently in the parent state can give rise to new atoms
+        thread_local std::vector<VariableIdx> changed;
+        changed.clear();
+        state.indexer().diff(*parent, state, changed);
+        for (VariableIdx var:changed) {
+            mark(var, state.getValue(var));
         }
     }
 
@@ -83,11 +102,9 @@ public:
         const AtomIndex& atomidx = _helper._atomidx;
 
         os << "{";
-        for (unsigned i = 0; i < _bool_reached.size(); ++i) {
+        for (auto i = _helper._relevant.find_first(); i != BitsetT::npos; i = _helper._relevant.find_next(i)) {
             const Atom& atom = atomidx.to_atom(i);
-            if (!_helper._relevant[i]) continue;
-
-            std::string mark = (_bool_reached[i]) ? "*" : "";
+            std::string mark = (_reached->test(i)) ? "*" : "";
             os << atom << mark << ", ";
         }
         os << "}";
@@ -104,9 +121,22 @@ protected:
     //! The total number of reached / unreached atoms
     unsigned _num_reached;
 
-    //! _bool_reached[i] iff atom with index 'i' has been reached at some point
+    //! (*_reached)[i] iff atom with index 'i' has been reached at some point
     //! since the count of reached subgoals was last increased.
-    std::vector<bool> _bool_reached;
+    //! The bitset might be shared with other sets, and is copied only before being modified.
+    std::shared_ptr<BitsetT> _reached;
+
+    //! Mark the given atom as reached, if relevant
+    void mark(VariableIdx var, const object_id& val) {
+        if (!_helper._atomidx.is_indexed(var, val)) return;
+
+        AtomIdx atom = _helper._atomidx.to_index(var, val);
+        if (!_helper._relevant[atom] || _reached->test(atom)) return; // we're not concerned about this atom
+
+        if (_reached.use_count() > 1) _reached = std::make_shared<BitsetT>(*_reached);
+        _reached->set(atom);
+        ++_num_reached;
+    }
 };
 
 
@@ -8,10 +8,11 @@
 #include <fs/core/search/drivers/sbfws/stats.hxx>
 #include <fs/core/search/drivers/sbfws/relevant_atoms.hxx>
 #include <fs/core/constraints/gecode/handlers/monotonicity_csp.hxx>
+#include <fs/core/search/state_registry.hxx>
+#include <fs/core/search/nodes/node_pool.hxx>
 
 #include <lapkt/tools/resources_control.hxx>
 #include <lapkt/search/components/open_lists.hxx>
-#include <lapkt/search/components/stl_unordered_map_closed_list.hxx>
 
 
 namespace fs0::bfws {
@@ -36,13 +37,16 @@ struct novelty_comparer {
 
 //! The node type we'll use for the Simulated BFWS search, parametrized by type of state and action action
 template <typename StateT, typename ActionT>
-class SBFWSNode {
+class SBFWSNode : public lapkt::PooledNode<SBFWSNode<StateT, ActionT>> {
 public:
-    using ptr_t = std::shared_ptr<SBFWSNode<StateT, ActionT>>;
+    using ptr_t = lapkt::IntrusivePtr<SBFWSNode<StateT, ActionT>>;
     using action_t = typename ActionT::IdType;
 
-    //! The state corresponding to the search node
-    StateT state;
+    //! The ID of the state corresponding to the search node
+    StateID state_id;
+
+    //! The state corresponding to the search node, interned in the search state registry
+    const StateT& state;
 
     //! The action that led to the state in this search node
     action_t action;
@@ -64,23 +68,21 @@ public:
     unsigned short w_g_r;
 
     //! A reference atomset helper wrt which the sets R of descendent nodes with same #g are computed
-    //! Use a raw pointer to optimize performance, as the number of generated nodes will typically be huge
-    AtomsetHelper* _helper;
+    std::unique_ptr<AtomsetHelper> _helper;
 
     //! The number of atoms in the last relaxed plan computed in the way to the current state that have been
     //! made true along the path (#r)
-    //! Use a raw pointer to optimize performance, as the number of generated nodes will typically be huge
-    RelevantAtomSet* _relevant_atoms;
+    //! Declared after '_helper', so that it is destroyed first, since it might refer to it
+    std::unique_ptr<RelevantAtomSet> _relevant_atoms;
 
     //! The sets D^G_X of goal-reachable domains for every state variable X
     DomainTracker _domains;
 
-    //! Constructor with full copying of the state (expensive)
-    SBFWSNode(const StateT& s, unsigned long gen_order) : SBFWSNode(StateT(s), ActionT::invalid_action_id, nullptr, gen_order) {}
+    //! Constructor for the root node
+    SBFWSNode(const StateRegistry& registry, StateID id, unsigned long gen_order) : SBFWSNode(registry, id, ActionT::invalid_action_id, nullptr, gen_order) {}
 
-    //! Constructor with move of the state (cheaper)
-    SBFWSNode(StateT&& _state, action_t action_, ptr_t parent_, uint32_t gen_order) :
-        state(std::move(_state)), action(action_), parent(parent_), g(parent ? parent->g+1 : 0),
+    SBFWSNode(const StateRegistry& registry, StateID id, action_t action_, ptr_t parent_, uint32_t gen_order) :
+        state_id(id), state(registry.get(id)), action(action_), parent(parent_), g(parent ? parent->g+1 : 0),
         unachieved_subgoals(std::numeric_limits<unsigned>::max()),
         _gen_order(gen_order),
         _helper(nullptr),
@@ -90,7 +92,7 @@ public:
         assert(_gen_order > 0); // Very silly way to detect overflow, in case we ever generate > 4 billion nodes :-)
     }
 
-    ~SBFWSNode() { delete _helper; delete _relevant_atoms; }
+    ~SBFWSNode() = default;
     SBFWSNode(const SBFWSNode&) = delete;
     SBFWSNode(SBFWSNode&&) = delete;
     SBFWSNode& operator=(const SBFWSNode&) = delete;
@@ -99,7 +101,7 @@ public:
 
     bool has_parent() const { return parent != nullptr; }
 
-    bool operator==( const SBFWSNode<StateT, ActionT>& o ) const { return state == o.state; }
+    bool operator==( const SBFWSNode<StateT, ActionT>& o ) const { return state_id == o.state_id; }
 
     bool dead_end() const { return false; }
 
@@ -268,8 +270,7 @@ public:
     using ActionIdT = typename ActionT::IdType;
     using NodeT = SBFWSNode<fs0::State, ActionT>;
     using PlanT =  std::vector<ActionIdT>;
-    using NodePT = std::shared_ptr<NodeT>;
-    using ClosedListT = aptk::StlUnorderedMapClosedList<NodeT>;
+    using NodePT = typename NodeT::ptr_t;
     using HeuristicT = SBFWSHeuristic<StateModelT, SBFWSNoveltyIndexer, FeatureSetT, NoveltyEvaluatorT, NodeT>;
 
 
@@ -285,14 +286,21 @@ protected:
     //! The search model
     const StateModelT& _model;
 
+    //! The pool from which all search nodes are allocated
+    lapkt::NodePool<NodeT> _pool;
+
     //! The solution node, if any. This will be set during the search process
     NodePT _solution;
 
     StandardOpenList _open;
 
 
-    //! The closed list
-    ClosedListT _closed;
+    //! The registry where all the states generated during the search are interned
+    StateRegistry _registry;
+
+    //! The IDs of the states that are currently in the open list, and of those already expanded (i.e. the closed list)
+    StateIDSet _in_open;
+    StateIDSet _closed;
 
     //! The novelty feature evaluator.
     //! We hold the object here so that we can reuse the same featureset for search and simulations
@@ -326,6 +334,7 @@ public:
           SBFWSConfig& config) :
 
         _model(model),
+        _pool(),
         _solution(nullptr),
         _featureset(std::move(featureset)),
         _heuristic(config, model, _featureset, stats),
@@ -333,7 +342,7 @@ public:
         _pruning(config._global_config.getOption<bool>("bfws.prune", false)),
         _generated(0),
         _min_subgoals_to_reach(std::numeric_limits<unsigned>::max()),
-        _novelty_levels(setup_novelty_levels(model, config._global_config)),
+        _novelty_levels(setup_novelty_levels(model.getTask(), model.num_subgoals(), config._global_config)),
         _monotonicity_csp_manager(gecode::build_monotonicity_csp(_model.getTask(), config._global_config))
     {
     }
@@ -344,37 +353,6 @@ public:
     SBFWS& operator=(const SBFWS&) = delete;
     SBFWS& operator=(SBFWS&&) = default;
 
-    unsigned setup_novelty_levels(const StateModelT& model, const Config& global_config) const {
-        const AtomIndex& atomidx = model.getTask().get_tuple_index();
-
-        // Allow the user to override the automatic configuration of the levels of novelty
-        int user_option = global_config.getOption<int>("novelty_levels", -1);
-        if (user_option != -1) {
-            if (user_option != 2 && user_option != 3) {
-                throw std::runtime_error("Unsupported novelty levels: " + std::to_string(user_option));
-            }
-
-            LPT_INFO("search", "(User-specified) Novelty levels of the search:  " << user_option);
-            return user_option;
-        }
-
-        const unsigned num_subgoals = model.num_subgoals();
-        unsigned expected_R_size = 10; // TODO ???? What value expected for |R|??
-        const unsigned num_atoms = atomidx.size();
-
-        float size_novelty2_table = ((float) num_atoms*(num_atoms-1)+num_atoms) / (1024*1024*8.);
-        float size_novelty2_tables = num_subgoals * expected_R_size * size_novelty2_table;
-
-        unsigned levels = (size_novelty2_tables > 2048) ? 2 : 3;
-
-        LPT_INFO("search", "Size of a single specialized novelty-2 table estimated at (MB): " << size_novelty2_table);
-        LPT_INFO("search", "Expected overall size of all novelty-two tables (MB): " << size_novelty2_tables);
-        LPT_INFO("search", "Novelty levels of the search:  " << levels);
-
-        return levels;
-    }
-
-
     //! Convenience method
     bool solve_model(PlanT& solution) { return search(_model.init(), solution); }
 
@@ -382,7 +360,7 @@ public:
 
         LPT_INFO("cout", "Mem. usage on start of SBFWS search: " << get_current_memory_in_kb() << "kB. / " << get_peak_memory_in_kb() << " kB.");
 
-        NodePT root = std::make_shared<NodeT>(s, ++_generated);
+        NodePT root = _pool.make(_registry, _registry.insert(s).first, ++_generated);
 
         if (_monotonicity_csp_manager) {
             root->_domains = _monotonicity_csp_manager->create_root(s);
@@ -459,6 +437,7 @@ protected:
 
 
         _open.insert(node);
+        _in_open.insert(node->state_id);
 
 
         if (node->decreases_unachieved_subgoals()) _stats.generation_g_decrease();
@@ -468,7 +447,8 @@ protected:
 
     //! Process the node.
     void process_node(const NodePT& node) {
-        _closed.put(node);
+        _in_open.erase(node->state_id);
+        _closed.insert(node->state_id);
         expand_node(node);
     }
 
@@ -484,8 +464,8 @@ protected:
 
         for (const auto& action:_model.applicable_actions(node->state, true)) {
             // std::cout << *(Problem::getInstance().getGroundActions()[action]) << std::endl;
-            StateT s_a = _model.next(node->state, action);
-            NodePT successor = std::make_shared<NodeT>(std::move(s_a), action, node, ++_generated);
+            StateID id = _registry.insert(_model.next(node->state, action)).first;
+            ++_generated;
 
             _stats.generation();
             auto generated = _stats.generated();
@@ -495,8 +475,10 @@ protected:
                         << ". Memory consumption: "<< get_current_memory_in_kb() << "kB. / " << get_peak_memory_in_kb() << " kB.");
             }
 
-            if (_closed.check(successor)) continue; // The node has already been closed
-            if (is_open(successor)) continue; // The node is currently on (some) open list, so we ignore it
+            if (_closed.contains(id)) continue; // The node has already been closed
+            if (_in_open.contains(id)) continue; // The node is currently on (some) open list, so we ignore it
+
+            NodePT successor = _pool.make(_registry, id, action, node, _generated);
 
             // std::cout << "Generating node: " << *successor << std::endl;
             // If the node we're expanding has a monotonicity CSP, we update it
@@ -516,6 +498,7 @@ protected:
                     successor->_domains.release();
                     _stats.monot_pruned();
 //                    _closed.put(successor);
+                    _registry.release(id); // Neither open nor closed, so no other node refers to the state
                     continue;
                 }
             }
@@ -531,10 +514,6 @@ protected:
         node->_domains.release();
     }
 
-    bool is_open(const NodePT& node) const {
-        return _open.contains(node);
-    }
-
     inline bool is_goal(const NodePT& node) const {
         return _model.goal(node->state);
     }
@@ -7,16 +7,40 @@
 
 namespace fs0::bfws {
 
-BFWSStats::BFWSStats() : _expanded(0), _generated(0), _evaluated(0),
+BFWSStats::BFWSStats() : _expanded(0), _generated(0), _evaluated(0), _simulations(0),
     _initial_reachable_subgoals(std::numeric_limits<unsigned>::max()),
     _max_reachable_subgoals(0),
     _sum_reachable_subgoals(0),
     _initial_relevant_atoms(std::numeric_limits<unsigned>::max()),
     _max_relevant_atoms(0),
     _sum_relevant_atoms(0),
+    _r_type(0),
+    _num_wg1_nodes(0), _num_wgr1_nodes(0), _num_wg1_5_nodes(0), _num_wgr2_nodes(0), _num_wgr_gt2_nodes(0),
+    _num_expanded_g_decrease(0), _num_generated_g_decrease(0),
+    _monot_pruned(0),
+    _reused_simulation_nodes(0),
+    _sim_expanded_nodes(0), _sim_generated_nodes(0), _sim_time(0),
     _initial_search_time(-1)
 {}
 
+void
+BFWSStats::add_search_counters(const BFWSStats& other) {
+    _expanded += other._expanded;
+    _generated += other._generated;
+    _evaluated += other._evaluated;
+    _num_wg1_nodes += other._num_wg1_nodes;
+    _num_wgr1_nodes += other._num_wgr1_nodes;
+    _num_wg1_5_nodes += other._num_wg1_5_nodes;
+    _num_wgr2_nodes += other._num_wgr2_nodes;
+    _num_wgr_gt2_nodes += other._num_wgr_gt2_nodes;
+    _num_expanded_g_decrease += other._num_expanded_g_decrease;
+    _num_generated_g_decrease += other._num_generated_g_decrease;
+    _monot_pruned += other._monot_pruned;
+
+    if (other._search_wtables.size() > _search_wtables.size()) _search_wtables.resize(other._search_wtables.size());
+    for (unsigned k = 0; k < other._search_wtables.size(); ++k) _search_wtables[k] += other._search_wtables[k];
+}
+
 std::string
 BFWSStats::_if_computed(unsigned val) {
     return val < std::numeric_limits<unsigned>::max() ?  std::to_string(val) : "N/A";
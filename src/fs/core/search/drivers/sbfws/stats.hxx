@@ -78,6 +78,10 @@ public:
         _r_type = type;
     }
 
+    //! Add to this object the counters of the search (not of the simulations) from the given stats object,
+    //! e.g. one that has been used by a single thread of a parallel search
+    void add_search_counters(const BFWSStats& other);
+
     using DataPointT = std::tuple<std::string, std::string, std::string>;
     std::vector<DataPointT> dump() const;
 
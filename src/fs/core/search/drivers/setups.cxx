@@ -1,15 +1,48 @@
+#include <mutex>
 
 #include <fs/core/problem.hxx>
 #include <fs/core/problem_info.hxx>
 #include <fs/core/actions/grounding.hxx>
+#include <fs/core/actions/strips_table.hxx>
+#include <fs/core/utils/config.hxx>
 #include <fs/core/search/drivers/setups.hxx>
 
+#include <lapkt/tools/logging.hxx>
+
 namespace fs0::drivers {
 
+//! Serializes the modifications of the set of actions of the problem
+static std::mutex grounding_mutex;
+
+void
+GroundingSetup::ensure_ground(Problem& problem) {
+	std::lock_guard<std::mutex> lock(grounding_mutex);
+	if (!problem.getGroundActions().empty()) return;
+	GroundActionStore store;
+	problem.setGroundActions(ActionGrounder::fully_ground(problem.getActionData(), ProblemInfo::getInstance(), &store));
+	problem.setGroundActionStore(std::move(store));
+
+	if (Config::instance().getOption<bool>("strips_table", true)) {
+		const auto& actions = problem.getGroundActions();
+		auto table = StripsActionTable::create(problem.getGroundActionStore(), problem.getStateAtomIndexer());
+		if (table) {
+			LPT_INFO("cout", "STRIPS action table covers " << table->num_covered() << " out of " << actions.size() << " ground actions");
+		}
+		problem.setStripsActionTable(std::move(table));
+	}
+}
+
+void
+GroundingSetup::ensure_lifted(Problem& problem) {
+	std::lock_guard<std::mutex> lock(grounding_mutex);
+	if (!problem.getPartiallyGroundedActions().empty()) return;
+	problem.setPartiallyGroundedActions(ActionGrounder::fully_lifted(problem.getActionData(), ProblemInfo::getInstance()));
+}
+
 CSPLiftedStateModel
 GroundingSetup::csp_lifted_model(Problem& problem) {
 	// We don't ground any action
-	problem.setPartiallyGroundedActions(ActionGrounder::fully_lifted(problem.getActionData(), ProblemInfo::getInstance()));
+	ensure_lifted(problem);
 	return CSPLiftedStateModel::build(problem, ProblemInfo::getInstance(), problem.get_tuple_index());
 }
 
@@ -17,29 +50,29 @@ GroundingSetup::csp_lifted_model(Problem& problem) {
 SDDLiftedStateModel
 GroundingSetup::sdd_lifted_model(Problem& problem) {
     // We don't ground any action
-    problem.setPartiallyGroundedActions(ActionGrounder::fully_lifted(problem.getActionData(), ProblemInfo::getInstance()));
+    ensure_lifted(problem);
     return SDDLiftedStateModel::build(problem);
 }
 
 
 GroundStateModel
 GroundingSetup::fully_ground_model(Problem& problem) {
-	problem.setGroundActions(ActionGrounder::fully_ground(problem.getActionData(), ProblemInfo::getInstance()));
+	ensure_ground(problem);
 	//! Determine if computing successor states requires to handle continuous change
 	return GroundStateModel(problem);
 }
 
 SimpleStateModel
 GroundingSetup::fully_ground_simple_model(Problem& problem) {
-	problem.setGroundActions(ActionGrounder::fully_ground(problem.getActionData(), ProblemInfo::getInstance()));
+	ensure_ground(problem);
 	//! Determine if computing successor states requires to handle continuous change
 	return SimpleStateModel::build(problem);
 }
 
 GroundStateModel
 GroundingSetup::ground_search_lifted_heuristic(Problem& problem) {
-	problem.setGroundActions(ActionGrounder::fully_ground(problem.getActionData(), ProblemInfo::getInstance()));
-	problem.setPartiallyGroundedActions(ActionGrounder::fully_lifted(problem.getActionData(), ProblemInfo::getInstance()));
+	ensure_ground(problem);
+	ensure_lifted(problem);
 	//! Determine if computing successor states requires to handle continuous change
 	return GroundStateModel(problem);
 }
@@ -14,6 +14,8 @@ namespace fs0 { class Problem; }
 namespace fs0 { namespace drivers {
 
 //! A catalog of common setups for grounding actions for both search and heuristic computations.
+//! The actions are grounded only once per problem, and under a lock, so that different engines
+//! running concurrently on the same problem (see the portfolio mode of the Runner) share the same grounding.
 class GroundingSetup {
 public:
 	static CSPLiftedStateModel csp_lifted_model(Problem& problem);
@@ -28,6 +30,10 @@ public:
 	//! We'll use all the ground actions for the search plus the partially ground actions for the heuristic computations
 	static GroundStateModel ground_search_lifted_heuristic(Problem& problem);
 
+protected:
+	//! Fully ground / fully lift the actions of the problem, unless that has already been done
+	static void ensure_ground(Problem& problem);
+	static void ensure_lifted(Problem& problem);
 };
 
 class EventUtils {
@@ -35,9 +41,9 @@ public:
 	using HandlerPtr = std::unique_ptr<lapkt::events::EventHandler>;
 	
 	template <typename NodeT, typename HeuristicT, typename StatsT>
-	static void setup_evaluation_observer(const Config& config, HeuristicT& heuristic, StatsT& stats, std::vector<HandlerPtr>& handlers) {
+	static void setup_evaluation_observer(const Config& config, HeuristicT& heuristic, StatsT& stats, std::vector<HandlerPtr>& handlers, HeuristicCache* cache = nullptr) {
 		using EvaluatorT = EvaluationObserver<NodeT, HeuristicT, StatsT>;
-		handlers.push_back(std::unique_ptr<EvaluatorT>(new EvaluatorT(heuristic, config.getNodeEvaluationType(), stats)));
+		handlers.push_back(std::unique_ptr<EvaluatorT>(new EvaluatorT(heuristic, config.getNodeEvaluationType(), stats, cache)));
 	}
 	
 	template <typename NodeT, typename StatsT>
@@ -59,6 +59,8 @@ SmartEffectDriver::create(const Config& config, const GroundStateModel& model, S
 		LiftedEffectCSP::prune_unreachable(_heuristic->get_managers(), graph);
 	}
 
+	_cache = HeuristicCache::create(config);
+
 	EHCSearch<HeuristicT>* ehc = nullptr;
 	if (config.getOption("ehc")) {
 		// TODO Apply reachability analysis for the EHC heuristic as well
@@ -66,16 +68,19 @@ SmartEffectDriver::create(const Config& config, const GroundStateModel& model, S
 		const auto managed = support::compute_managed_symbols(std::vector<const ActionBase*>(actions.begin(), actions.end()), problem.getGoalConditions(), problem.getStateConstraints());
 		ExtensionHandler extension_handler(problem.get_tuple_index(), managed);
 		HeuristicT ehc_heuristic(problem, problem.getGoalConditions(), problem.getStateConstraints(), std::move(ehc_managers), extension_handler);
-		ehc = new EHCSearch<HeuristicT>(model, std::move(ehc_heuristic), config.getOption("helpful_actions"), stats);
+		// Its state constraints and managers differ from those of the GBFS heuristic, so that their values cannot be shared
+		_ehc_cache = HeuristicCache::create(config);
+		ehc = new EHCSearch<HeuristicT>(model, std::move(ehc_heuristic), config.getOption("helpful_actions"), config.getNodeEvaluationType(), config.getOption("ehc.preferred_first", false), stats, _ehc_cache.get());
 	}
 
 	EventUtils::setup_stats_observer<NodeT>(stats, _handlers, config.getOption<bool>("verbose_stats", false));
-	EventUtils::setup_evaluation_observer<NodeT, HeuristicT>(config, *_heuristic, stats, _handlers);
-	if (config.requiresHelpfulnessAssessment()) {
+	EventUtils::setup_evaluation_observer<NodeT, HeuristicT>(config, *_heuristic, stats, _handlers, _cache.get());
+	bool alternate_helpful = config.getOption<bool>("gbfs.alternate_helpful", false);
+	if (config.requiresHelpfulnessAssessment() || alternate_helpful) {
 		EventUtils::setup_HA_observer<NodeT>(_handlers);
 	}
 
-	auto engine = new GBFST(model, gecode::build_monotonicity_csp(problem, config));
+	auto engine = new GBFST(model, gecode::build_monotonicity_csp(problem, config), alternate_helpful);
 	lapkt::events::subscribe(*engine, _handlers);
 
 	return EnginePT(new EngineT(problem, engine, ehc));
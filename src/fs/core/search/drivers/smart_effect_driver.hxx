@@ -31,6 +31,9 @@ public:
 	
 protected:
 	std::unique_ptr<HeuristicT> _heuristic;
+	std::unique_ptr<HeuristicCache> _cache;
+	//! The EHC heuristic is configured differently than the GBFS one, hence gets its own cache
+	std::unique_ptr<HeuristicCache> _ehc_cache;
 	std::vector<std::unique_ptr<lapkt::events::EventHandler>> _handlers;
 	
 public:
@@ -40,9 +40,10 @@ SmartLiftedDriver::create(const Config& config, CSPLiftedStateModel& model, Sear
 	}
 	
 	auto engine = EnginePT(new EngineT(model));
+	_cache = HeuristicCache::create(config);
 	
 	EventUtils::setup_stats_observer<NodeT>(stats, _handlers, config.getOption<bool>("verbose_stats", false));
-	EventUtils::setup_evaluation_observer<NodeT, HeuristicT>(config, *_heuristic, stats, _handlers);
+	EventUtils::setup_evaluation_observer<NodeT, HeuristicT>(config, *_heuristic, stats, _handlers, _cache.get());
 	lapkt::events::subscribe(*engine, _handlers);
 	
 	return engine;
@@ -9,6 +9,7 @@
 #include <lapkt/algorithms/best_first_search.hxx>
 #include <fs/core/utils/config.hxx>
 #include <fs/core/heuristics/relaxed_plan/smart_rpg.hxx>
+#include <fs/core/heuristics/heuristic_cache.hxx>
 
 namespace fs0 { class Problem; class SearchStats; }
 
@@ -29,6 +30,7 @@ public:
 
 protected:
 	std::unique_ptr<HeuristicT> _heuristic;
+	std::unique_ptr<HeuristicCache> _cache;
 	std::vector<std::unique_ptr<lapkt::events::EventHandler>> _handlers;
 };
 
@@ -3,6 +3,7 @@
 
 #include <fs/core/utils/config.hxx>
 #include <fs/core/utils/system.hxx>
+#include <fs/core/heuristics/heuristic_cache.hxx>
 
 #include <lapkt/tools/events.hxx>
 #include <lapkt/tools/logging.hxx>
@@ -135,7 +136,7 @@ protected:
 };
 
 //! An observer that decides when to evaluate the heuristic value of a node, when
-//! to inherit it from the parent's value, etc.
+//! to inherit it from the parent's value, etc. Evaluations are served from the given cache, if any.
 template <typename NodeT, typename HeuristicT, typename StatsT>
 class EvaluationObserver: public lapkt::events::EventHandler {
 public:
@@ -143,7 +144,9 @@ public:
 	using ExpansionEvent = lapkt::events::NodeExpansionEvent<NodeT>;
 	using CreationEvent  = lapkt::events::NodeCreationEvent<NodeT>;
 
-	EvaluationObserver(HeuristicT& heuristic, EvaluationT evaluation, StatsT& stats) : _heuristic(heuristic), _evaluation(evaluation), _stats(stats) {
+	EvaluationObserver(HeuristicT& heuristic, EvaluationT evaluation, StatsT& stats, HeuristicCache* cache = nullptr) :
+		_heuristic(heuristic), _evaluation(evaluation), _stats(stats), _cache(cache)
+	{
 		registerEventHandler<ExpansionEvent>(std::bind(&EvaluationObserver::expansion, this, std::placeholders::_1, std::placeholders::_2));
 		registerEventHandler<CreationEvent>(std::bind(&EvaluationObserver::creation, this, std::placeholders::_1, std::placeholders::_2));
 	}
@@ -152,6 +155,7 @@ protected:
 	HeuristicT& _heuristic;
 	EvaluationT _evaluation;
 	StatsT& _stats;
+	HeuristicCache* _cache;
 
 	//! Returns true if the evaluation type is such that the node should be evaluated eagerly, i.e. upon creation
 	bool do_early_evaluation(NodeT& node) const {
@@ -181,8 +185,8 @@ protected:
 	}
 
 	void evaluate(NodeT& node) {
-		node.evaluate_with(_heuristic);
-		_stats.evaluation();
+		CachedHeuristic<HeuristicT, StatsT> heuristic(_heuristic, _cache, _stats);
+		node.evaluate_with(heuristic);
 	}
 };
 
@@ -29,13 +29,15 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <lapkt/tools/logging.hxx>
 
+#include <fs/core/search/nodes/node_pool.hxx>
+
 namespace fs0 { namespace drivers {
 
 
 template <typename StateT, typename ActionT>
-class BFWSNode {
+class BFWSNode : public lapkt::PooledNode<BFWSNode<StateT, ActionT>> {
 public:
-	using ptr_t = std::shared_ptr<BFWSNode<StateT, ActionT>>;
+	using ptr_t = lapkt::IntrusivePtr<BFWSNode<StateT, ActionT>>;
 	
 	StateT state;
 	typename ActionT::IdType action;
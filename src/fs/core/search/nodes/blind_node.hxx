@@ -27,6 +27,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <lapkt/tools/logging.hxx>
 
+#include <fs/core/search/state_registry.hxx>
+#include <fs/core/search/nodes/node_pool.hxx>
+
 namespace lapkt {
 
 template <typename StateT, typename ActionT>
@@ -74,4 +77,106 @@ public:
 	std::size_t hash() const { return state.hash(); }
 };
 
+
+//! A blind search node that does not own its state, but refers to a state interned in some
+//! StateRegistry. Two such nodes are equal iff they refer to the same (registered) state.
+//! Nodes are meant to be allocated from a NodePool.
+template <typename ActionT>
+class RegisteredBlindSearchNode : public PooledNode<RegisteredBlindSearchNode<ActionT>> {
+public:
+	using ActionIdT = typename ActionT::IdType;
+	using ptr_t = IntrusivePtr<RegisteredBlindSearchNode<ActionT>>;
+
+	//! The ID of the state in the registry
+	fs0::StateID state_id;
+
+	//! The state itself, owned by the registry
+	const fs0::State& state;
+
+	ActionIdT action;
+
+	ptr_t parent;
+
+	unsigned g;
+
+public:
+	RegisteredBlindSearchNode() = delete;
+	~RegisteredBlindSearchNode() = default;
+
+	RegisteredBlindSearchNode(const RegisteredBlindSearchNode&) = delete;
+	RegisteredBlindSearchNode(RegisteredBlindSearchNode&&) = delete;
+	RegisteredBlindSearchNode& operator=(const RegisteredBlindSearchNode&) = delete;
+	RegisteredBlindSearchNode& operator=(RegisteredBlindSearchNode&&) = delete;
+
+	//! Constructor for the root node
+	RegisteredBlindSearchNode(const fs0::StateRegistry& registry, fs0::StateID id)
+		: state_id(id), state(registry.get(id)), action(ActionT::invalid_action_id), parent(nullptr), g(0)
+	{}
+
+	RegisteredBlindSearchNode(const fs0::StateRegistry& registry, fs0::StateID id, ActionIdT action_, ptr_t parent_) :
+		state_id(id), state(registry.get(id)), action(action_), parent(std::move(parent_)), g(parent->g+1)
+	{}
+
+	bool has_parent() const { return parent != nullptr; }
+
+	//! Print the node into the given stream
+	friend std::ostream& operator<<(std::ostream &os, const RegisteredBlindSearchNode<ActionT>& object) { return object.print(os); }
+	std::ostream& print(std::ostream& os) const {
+		os << "{@ = " << this << ", #s = " << state_id << ", s = " << state << ", parent = " << parent << "}";
+		return os;
+	}
+
+	bool operator==( const RegisteredBlindSearchNode<ActionT>& o ) const { return state_id == o.state_id; }
+
+	std::size_t hash() const { return state.hash(); }
+};
+
+
+//! A blind search node stored in a ConcurrentClosedList, which owns the node and never moves or frees it
+//! while the search runs. The node thus owns its state, and can refer to its parent through a raw pointer.
+template <typename ActionT>
+class ConcurrentBlindSearchNode {
+public:
+	using ActionIdT = typename ActionT::IdType;
+
+	fs0::State state;
+
+	ActionIdT action;
+
+	const ConcurrentBlindSearchNode<ActionT>* parent;
+
+	unsigned g;
+
+public:
+	ConcurrentBlindSearchNode() = delete;
+	~ConcurrentBlindSearchNode() = default;
+
+	ConcurrentBlindSearchNode(const ConcurrentBlindSearchNode&) = delete;
+	ConcurrentBlindSearchNode(ConcurrentBlindSearchNode&&) = delete;
+	ConcurrentBlindSearchNode& operator=(const ConcurrentBlindSearchNode&) = delete;
+	ConcurrentBlindSearchNode& operator=(ConcurrentBlindSearchNode&&) = delete;
+
+	//! Constructor for the root node
+	explicit ConcurrentBlindSearchNode(fs0::State&& state_)
+		: state(std::move(state_)), action(ActionT::invalid_action_id), parent(nullptr), g(0)
+	{}
+
+	ConcurrentBlindSearchNode(fs0::State&& state_, ActionIdT action_, const ConcurrentBlindSearchNode<ActionT>* parent_) :
+		state(std::move(state_)), action(action_), parent(parent_), g(parent->g+1)
+	{}
+
+	bool has_parent() const { return parent != nullptr; }
+
+	//! Print the node into the given stream
+	friend std::ostream& operator<<(std::ostream &os, const ConcurrentBlindSearchNode<ActionT>& object) { return object.print(os); }
+	std::ostream& print(std::ostream& os) const {
+		os << "{@ = " << this << ", s = " << state << ", parent = " << parent << "}";
+		return os;
+	}
+
+	bool operator==( const ConcurrentBlindSearchNode<ActionT>& o ) const { return state == o.state; }
+
+	std::size_t hash() const { return state.hash(); }
+};
+
 }  // namespaces
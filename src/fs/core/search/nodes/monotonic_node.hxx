@@ -13,8 +13,6 @@
 
 namespace fs0 { namespace drivers {
 
-const std::vector<Atom> NIL_VECTOR = {};
-
 template <typename StateT, typename ActionT>
 class MonotonicNode {
 protected:
@@ -34,11 +32,11 @@ public:
 	
 	
 	MonotonicNode(const StateT& state_, uint32_t gen_order)
-		: state(state_), action(ActionT::invalid_action_id), parent(nullptr), g(0), h(std::numeric_limits<long>::max()), _gen_order(gen_order)
+		: state(state_), action(ActionT::invalid_action_id), parent(nullptr), g(0), h(std::numeric_limits<long>::max()), _gen_order(gen_order), _helpful(false)
 	{}
 	
 	MonotonicNode(StateT&& state_, ActionIdT action_, ptr_t parent_, uint32_t gen_order) :
-		state(std::move(state_)), action(action_), parent(parent_), g(parent_->g + 1), h(std::numeric_limits<long>::max()), _gen_order(gen_order)
+		state(std::move(state_)), action(action_), parent(parent_), g(parent_->g + 1), h(std::numeric_limits<long>::max()), _gen_order(gen_order), _helpful(false)
 	{}
 
 	bool has_parent() const { return parent != nullptr; }
@@ -62,7 +60,7 @@ public:
 	// MRJ: This is part of the required interface of the Heuristic
 	template <typename Heuristic>
 	long evaluate_with(Heuristic& heuristic) {
-		h = heuristic.evaluate(state);
+		h = heuristic.evaluate(state, _relevant);
 		LPT_DEBUG("heuristic" , std::endl << "Computed heuristic value of " << h <<  " for state: " << std::endl << state << std::endl << "****************************************");
 		
 		// If the heuristic is > 0, then we must have a relaxed plan and at least some atoms in the 1st layer of it.
@@ -117,14 +115,20 @@ public:
 	
 	long h;
 	
-	bool is_helpful() const { return false; }
-	void mark_as_helpful() { }
+	bool is_helpful() const { return _helpful; }
+	void mark_as_helpful() { _helpful = true; }
 	
-	const std::vector<Atom>& get_relevant() const { return NIL_VECTOR; }
+	const std::vector<Atom>& get_relevant() const { return _relevant; }
 
     DomainTracker _domains;
 
 	uint32_t _gen_order;
+
+protected:
+	//! The atoms of the first layer of the relaxed plan computed by the heuristic, if any
+	std::vector<Atom> _relevant;
+
+	bool _helpful;
 };
 
 } }  // namespaces
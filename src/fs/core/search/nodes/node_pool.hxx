@@ -0,0 +1,219 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace lapkt {
+
+template <typename NodeT> class NodePool;
+template <typename NodeT> class NodeStore;
+template <typename NodeT> class IntrusivePtr;
+
+//! Base class for all search nodes that are allocated from a NodePool, to be used through CRTP, e.g.
+//!     class MyNode : public PooledNode<MyNode> { ... }
+//! Holds the (non-atomic) reference counter of the node and the store the node must be given back to.
+//! Nodes are expected to be created, shared and released by a single thread at a time.
+template <typename NodeT>
+class PooledNode {
+	friend class IntrusivePtr<NodeT>;
+	friend class NodeStore<NodeT>;
+
+	unsigned _refs = 0;
+	NodeStore<NodeT>* _store = nullptr;
+
+protected:
+	PooledNode() = default;
+	~PooledNode() = default;
+
+	//! A copy of a node is a brand new node, which does not share the reference count of the original one
+	PooledNode(const PooledNode&) : PooledNode() {}
+	PooledNode& operator=(const PooledNode&) { return *this; }
+};
+
+
+//! A smart pointer to a pooled search node, with an intrusive, non-atomic reference count.
+//! Unlike std::shared_ptr, it has the size of a raw pointer and needs no separate control block;
+//! the node is returned to its pool when the last pointer to it goes away.
+template <typename NodeT>
+class IntrusivePtr {
+public:
+	IntrusivePtr() noexcept : _node(nullptr) {}
+	IntrusivePtr(std::nullptr_t) noexcept : _node(nullptr) {}
+	explicit IntrusivePtr(NodeT* node) noexcept : _node(node) { acquire(); }
+
+	IntrusivePtr(const IntrusivePtr& other) noexcept : _node(other._node) { acquire(); }
+	IntrusivePtr(IntrusivePtr&& other) noexcept : _node(other._node) { other._node = nullptr; }
+
+	IntrusivePtr& operator=(const IntrusivePtr& other) noexcept {
+		IntrusivePtr(other).swap(*this);
+		return *this;
+	}
+
+	IntrusivePtr& operator=(IntrusivePtr&& other) noexcept {
+		IntrusivePtr(std::move(other)).swap(*this);
+		return *this;
+	}
+
+	IntrusivePtr& operator=(std::nullptr_t) noexcept {
+		reset();
+		return *this;
+	}
+
+	~IntrusivePtr() { release(); }
+
+	void reset() noexcept { IntrusivePtr().swap(*this); }
+	void swap(IntrusivePtr& other) noexcept { std::swap(_node, other._node); }
+
+	NodeT* get() const noexcept { return _node; }
+	NodeT& operator*() const noexcept { assert(_node); return *_node; }
+	NodeT* operator->() const noexcept { assert(_node); return _node; }
+	explicit operator bool() const noexcept { return _node != nullptr; }
+
+	//! The number of pointers currently sharing the node (mostly for debugging purposes)
+	unsigned use_count() const noexcept { return _node ? base(_node)->_refs : 0; }
+
+	bool operator==(const IntrusivePtr& rhs) const noexcept { return _node == rhs._node; }
+	bool operator!=(const IntrusivePtr& rhs) const noexcept { return _node != rhs._node; }
+	bool operator==(std::nullptr_t) const noexcept { return _node == nullptr; }
+	bool operator!=(std::nullptr_t) const noexcept { return _node != nullptr; }
+	friend bool operator==(std::nullptr_t, const IntrusivePtr& rhs) noexcept { return rhs._node == nullptr; }
+	friend bool operator!=(std::nullptr_t, const IntrusivePtr& rhs) noexcept { return rhs._node != nullptr; }
+
+	friend std::ostream& operator<<(std::ostream& os, const IntrusivePtr& ptr) { return os << static_cast<const void*>(ptr._node); }
+
+protected:
+	NodeT* _node;
+
+	static PooledNode<NodeT>* base(NodeT* node) { return static_cast<PooledNode<NodeT>*>(node); }
+
+	void acquire() noexcept {
+		if (_node) ++base(_node)->_refs;
+	}
+
+	void release() noexcept {
+		if (_node && --base(_node)->_refs == 0) base(_node)->_store->destroy(_node);
+	}
+};
+
+
+//! The actual storage of a NodePool. Nodes are carved out of large slabs and recycled through an
+//! intrusive free list, so that creating a node costs (amortized) no call to the general-purpose allocator.
+//! The store is kept alive until both the owning pool has been destroyed and all its nodes have been released,
+//! so that pointers to nodes can safely outlive the search algorithm that created them.
+template <typename NodeT>
+class NodeStore {
+	friend class NodePool<NodeT>;
+	friend class IntrusivePtr<NodeT>;
+
+	using SlotT = typename std::aligned_storage<sizeof(NodeT), alignof(NodeT)>::type;
+	static_assert(sizeof(SlotT) >= sizeof(void*), "Node slots must be able to hold a free-list pointer");
+
+	explicit NodeStore(std::size_t nodes_per_slab) : _nodes_per_slab(nodes_per_slab) {}
+
+	~NodeStore() { assert(_live == 0); }
+
+	template <typename... Args>
+	NodeT* create(Args&&... args) {
+		if (!_free) refill();
+		void* slot = _free;
+		_free = *static_cast<void**>(slot);
+
+		NodeT* node;
+		try {
+			node = new (slot) NodeT(std::forward<Args>(args)...);
+		} catch (...) {
+			*static_cast<void**>(slot) = _free;
+			_free = slot;
+			throw;
+		}
+
+		static_cast<PooledNode<NodeT>*>(node)->_store = this;
+		++_live;
+		return node;
+	}
+
+	//! Destroy the given node and put its slot back into the free list.
+	void destroy(NodeT* node) noexcept {
+		// Note that destroying the node might release (recursively) its parent, which will end up here as well
+		node->~NodeT();
+		void* slot = node;
+		*static_cast<void**>(slot) = _free;
+		_free = slot;
+		--_live;
+		if (_detached && _live == 0) delete this;
+	}
+
+	//! The pool that owns the store is gone; free the store as soon as no node is alive.
+	void detach() {
+		_detached = true;
+		if (_live == 0) delete this;
+	}
+
+	void refill() {
+		_slabs.emplace_back(new SlotT[_nodes_per_slab]);
+		SlotT* slab = _slabs.back().get();
+		for (std::size_t i = _nodes_per_slab; i-- > 0;) {
+			void* slot = &slab[i];
+			*static_cast<void**>(slot) = _free;
+			_free = slot;
+		}
+	}
+
+	const std::size_t _nodes_per_slab;
+	std::vector<std::unique_ptr<SlotT[]>> _slabs;
+	void* _free = nullptr;
+	std::size_t _live = 0;
+	bool _detached = false;
+};
+
+
+//! A pool of search nodes of a given type, to be owned by a search algorithm. Creating a node through the pool
+//! returns an IntrusivePtr, which should be used instead of std::shared_ptr by the algorithm and its open lists.
+template <typename NodeT>
+class NodePool {
+public:
+	static_assert(std::is_base_of<PooledNode<NodeT>, NodeT>::value, "Pooled nodes must derive from PooledNode");
+
+	using ptr_t = IntrusivePtr<NodeT>;
+
+	explicit NodePool(std::size_t nodes_per_slab = 4096) : _store(new NodeStore<NodeT>(nodes_per_slab)) {}
+
+	~NodePool() { if (_store) _store->detach(); }
+
+	NodePool(const NodePool&) = delete;
+	NodePool& operator=(const NodePool&) = delete;
+
+	NodePool(NodePool&& other) noexcept : _store(other._store) { other._store = nullptr; }
+	NodePool& operator=(NodePool&& other) noexcept {
+		std::swap(_store, other._store);
+		return *this;
+	}
+
+	//! Create a new node, forwarding the given arguments to its constructor
+	template <typename... Args>
+	ptr_t make(Args&&... args) { return ptr_t(_store->create(std::forward<Args>(args)...)); }
+
+	//! The number of nodes created from this pool that are still alive
+	std::size_t live() const { return _store->_live; }
+
+protected:
+	NodeStore<NodeT>* _store;
+};
+
+} // namespaces
+
+
+namespace std {
+
+template <typename NodeT>
+struct hash<lapkt::IntrusivePtr<NodeT>> {
+	std::size_t operator()(const lapkt::IntrusivePtr<NodeT>& ptr) const { return std::hash<NodeT*>()(ptr.get()); }
+};
+
+} // namespaces
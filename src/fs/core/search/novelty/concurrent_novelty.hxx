@@ -0,0 +1,104 @@
+
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <fs/core/fs_types.hxx>
+
+
+namespace fs0::bfws {
+
+//! A fixed-size bitmap whose bits can be set concurrently from several threads, without locks.
+class AtomicBitmap {
+public:
+	explicit AtomicBitmap(std::size_t size) :
+		_words(new std::atomic<uint64_t>[(size + 63) / 64]), _size(size)
+	{
+		for (std::size_t i = 0, n = (size + 63) / 64; i < n; ++i) _words[i].store(0, std::memory_order_relaxed);
+	}
+
+	//! Set the given bit, and return true iff it was not set before, i.e. iff this call is the one that set it
+	bool set(std::size_t i) {
+		assert(i < _size);
+		const uint64_t mask = uint64_t(1) << (i % 64);
+		auto& word = _words[i / 64];
+		if (word.load(std::memory_order_relaxed) & mask) return false; // Spare the RMW on bits that are already set
+		return !(word.fetch_or(mask, std::memory_order_relaxed) & mask);
+	}
+
+	bool test(std::size_t i) const {
+		assert(i < _size);
+		return _words[i / 64].load(std::memory_order_relaxed) & (uint64_t(1) << (i % 64));
+	}
+
+	std::size_t size() const { return _size; }
+
+protected:
+	std::unique_ptr<std::atomic<uint64_t>[]> _words;
+	std::size_t _size;
+};
+
+
+//! A novelty table over tuples of exactly 1 or 2 atoms, where the tuples that have been seen are recorded
+//! in an atomic bitmap. As a consequence, several threads can evaluate (and update) the novelty of different
+//! states on the same table concurrently and without locks: each tuple is "claimed" by exactly one thread,
+//! the one whose state is thus considered to have made it true for the first time.
+//! A table of width 2 does not record single atoms: states are expected to be evaluated against it only
+//! once their width-1 novelty is known to be greater than 1, i.e. once they are known to have no new atom.
+class ConcurrentNoveltyTable {
+public:
+	//! A table for tuples of 'width' atoms out of the given number of atoms.
+	ConcurrentNoveltyTable(unsigned num_atoms, unsigned width) :
+		_width(width),
+		_tuples(width == 1 ? num_atoms : std::size_t(num_atoms) * (num_atoms - 1) / 2)
+	{
+		assert(width == 1 || width == 2);
+	}
+
+	unsigned width() const { return _width; }
+
+	//! Evaluate the novelty of a state made up of the given atoms, and record all its tuples as seen.
+	//! Only tuples with at least one atom in 'novel' are considered; all of the remaining tuples are assumed
+	//! to have been already recorded (e.g. because they were true in the parent state, evaluated against the same table).
+	//! Return 'width()' if some tuple had not been seen before, or 'width() + 1' otherwise.
+	unsigned evaluate(const std::vector<AtomIdx>& atoms, const std::vector<AtomIdx>& novel) {
+		bool is_novel = false;
+
+		if (_width == 1) {
+			for (AtomIdx atom:novel) {
+				if (_tuples.set(atom)) is_novel = true;
+			}
+
+		} else {
+			for (AtomIdx atom:novel) {
+				for (AtomIdx other:atoms) {
+					if (other == atom) continue;
+					if (_tuples.set(pair_index(atom, other))) is_novel = true;
+				}
+			}
+		}
+		return is_novel ? _width : _width + 1;
+	}
+
+	//! Evaluate the novelty of a state made up of the given atoms, considering all of its tuples
+	unsigned evaluate(const std::vector<AtomIdx>& atoms) { return evaluate(atoms, atoms); }
+
+protected:
+	const unsigned _width;
+
+	//! The atoms, or (unordered) pairs of atoms, that have been seen so far
+	AtomicBitmap _tuples;
+
+	//! The index of an unordered pair of distinct atoms in the lower-triangular layout of '_tuples'
+	static std::size_t pair_index(AtomIdx a, AtomIdx b) {
+		if (a < b) std::swap(a, b);
+		return std::size_t(a) * (a - 1) / 2 + b;
+	}
+};
+
+} // namespaces
@@ -1,6 +1,14 @@
 
 #include <iostream>
+#include <mutex>
+#include <new>
+#include <thread>
 #include <type_traits> //for std::underlying_type
+#include <unordered_set>
+
+#include <boost/algorithm/string/classification.hpp>
+#include <boost/algorithm/string/split.hpp>
+#include <boost/filesystem.hpp>
 
 #include <lapkt/tools/resources_control.hxx>
 #include <lapkt/tools/logging.hxx>
@@ -9,12 +17,14 @@
 #include <fs/core/utils/loader.hxx>
 #include <fs/core/search/runner.hxx>
 #include <fs/core/search/drivers/registry.hxx>
+#include <fs/core/search/cancellation.hxx>
 #include <fs/core/utils/config.hxx>
 #include <fs/core/problem_info.hxx>
 #include <fs/core/languages/fstrips/language.hxx>
 #include <fs/core/languages/fstrips/operations.hxx>
 
 
+namespace fsys = boost::filesystem;
 
 namespace fs0::drivers {
 
@@ -39,13 +49,109 @@ int Runner::run() {
 	LPT_INFO("main", "Planner configuration: " << std::endl << config);
 	LPT_INFO("cout", "Deriving control to search engine...");
 
-	auto driver = EngineRegistry::instance().get(_options.getDriver());
-	ExitCode code = driver->search(*problem, config, _options, _start_time);
+	ExitCode code;
+	if (_options.getDriver() == "portfolio") {
+		code = run_portfolio(*problem, config);
+	} else {
+		auto driver = EngineRegistry::instance().get(_options.getDriver());
+		try {
+			code = driver->search(*problem, config, _options, _start_time);
+		} catch (const SearchOutOfMemory&) {
+			exit_with(ExitCode::SEARCH_OUT_OF_MEMORY);
+		}
+	}
 	report_stats(*problem, _options.getOutputDir()); // Report stats here again so that the number of ground actions, etc. is correctly reported.
 
     return static_cast<std::underlying_type<ExitCode>::type>(code);
 }
 
+ExitCode Runner::run_portfolio(Problem& problem, const Config& config) const {
+	std::vector<std::string> engines;
+	const auto spec = config.getOption<std::string>("portfolio.engines");
+	boost::split(engines, spec, boost::is_any_of(":"));
+
+	// Each engine is a single driver object from the registry, which might keep state of its own (e.g. its stats),
+	// hence the same engine cannot be run twice at the same time.
+	std::unordered_set<std::string> seen;
+	for (const auto& engine:engines) {
+		if (engine.empty() || !seen.insert(engine).second) throw std::runtime_error("Invalid portfolio specification: \"" + spec + "\"");
+		EngineRegistry::instance().get(engine); // Fail before starting any search if some engine does not exist
+	}
+
+	LPT_INFO("cout", "Running a portfolio of " << engines.size() << " engines: " << spec);
+	Cancellation::reset();
+
+	std::mutex mutex;
+	std::string winner;
+	ExitCode code = ExitCode::SEARCH_UNSOLVABLE;
+
+	// The engines that finished without a plan but also without errors, and those that ran out of memory
+	unsigned num_unsolved = 0, num_out_of_memory = 0;
+
+	// An engine running out of memory must not kill the rest, so allocation failures throw instead of exiting
+	// the process right away; the search of that engine reports them as a SearchOutOfMemory exception.
+	std::new_handler new_handler = std::set_new_handler(nullptr);
+
+	std::vector<std::thread> threads;
+	for (const auto& engine:engines) {
+		// Each engine writes its results into a subdirectory of its own
+		EngineOptions options(_options);
+		options.setDriver(engine);
+		options.setOutputDir(_options.getOutputDir() + "/" + engine);
+		options.setPlanfile("");
+		fsys::create_directories(options.getOutputDir());
+
+		threads.emplace_back([&, engine, options] {
+			try {
+				ExitCode result = EngineRegistry::instance().get(engine)->search(problem, config, options, _start_time);
+				std::lock_guard<std::mutex> lock(mutex);
+				if (result != ExitCode::SUCCESS) {
+					LPT_INFO("cout", "Portfolio: engine \"" << engine << "\" finished without a plan");
+					if (winner.empty()) code = result;
+					++num_unsolved;
+					return;
+				}
+
+				if (winner.empty()) {
+					winner = engine;
+					code = result;
+					Cancellation::request();
+				}
+			} catch (const SearchCancelled&) {
+				LPT_INFO("cout", "Portfolio: engine \"" << engine << "\" cancelled");
+			} catch (const SearchOutOfMemory&) {
+				LPT_INFO("cout", "Portfolio: engine \"" << engine << "\" ran out of memory");
+				std::lock_guard<std::mutex> lock(mutex);
+				++num_out_of_memory;
+			} catch (const std::bad_alloc&) {
+				LPT_INFO("cout", "Portfolio: engine \"" << engine << "\" ran out of memory");
+				std::lock_guard<std::mutex> lock(mutex);
+				++num_out_of_memory;
+			} catch (const std::exception& ex) {
+				LPT_INFO("cout", "Portfolio: engine \"" << engine << "\" failed: " << ex.what());
+			}
+		});
+	}
+	for (auto& thread:threads) thread.join();
+	std::set_new_handler(new_handler);
+
+	if (winner.empty()) {
+		LPT_INFO("cout", "Portfolio: no engine found a plan");
+		// The problem is only reported as unsolved if some engine did actually finish its search
+		if (num_unsolved > 0) return code;
+		if (num_out_of_memory > 0) return ExitCode::SEARCH_OUT_OF_MEMORY;
+		return ExitCode::SEARCH_CRITICAL_ERROR;
+	}
+
+	// Make the results of the winning engine available where they would be if it had run alone
+	LPT_INFO("cout", "Portfolio: plan found by engine \"" << winner << "\"");
+	const std::string winner_dir = _options.getOutputDir() + "/" + winner;
+	const std::string planfile = _options.getPlanfile().empty() ? _options.getOutputDir() + "/first.plan" : _options.getPlanfile();
+	fsys::copy_file(winner_dir + "/first.plan", planfile, fsys::copy_options::overwrite_existing);
+	fsys::copy_file(winner_dir + "/results.json", _options.getOutputDir() + "/results.json", fsys::copy_options::overwrite_existing);
+	return code;
+}
+
 void Runner::report_stats(const Problem& problem, const std::string& out_dir) {
 	const ProblemInfo& info = ProblemInfo::getInstance();
 	const AtomIndex& tuple_index = problem.get_tuple_index();
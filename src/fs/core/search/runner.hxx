@@ -2,9 +2,10 @@
 #pragma once
 
 #include <fs/core/search/options.hxx>
+#include <fs/core/utils/system.hxx>
 #include <rapidjson/document.h>
 
-namespace fs0 { class Problem; }
+namespace fs0 { class Problem; class Config; }
 
 namespace fs0 { namespace drivers {
 	
@@ -30,6 +31,9 @@ protected:
 	//! The runner starting time
 	float _start_time;
 	
+	//! Run concurrently, on the same problem, each of the engines in the option 'portfolio.engines', until one of them finds a plan
+	ExitCode run_portfolio(Problem& problem, const Config& config) const;
+
 	//! Print out some information about the characteristics of the problem
 	static void report_stats(const Problem& problem, const std::string& out_dir);
 };
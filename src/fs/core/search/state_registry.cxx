@@ -0,0 +1,95 @@
+
+#include <fs/core/search/state_registry.hxx>
+
+
+namespace fs0 {
+
+//! Return the smallest power of two that is not smaller than n
+std::size_t _next_power_of_two(std::size_t n) {
+	std::size_t p = 1;
+	while (p < n) p <<= 1;
+	return p;
+}
+
+StateRegistry::StateRegistry(std::size_t initial_capacity) :
+	_states(),
+	_table(_next_power_of_two(std::max<std::size_t>(2 * initial_capacity, 16)), SlotT{INVALID_STATE_ID, 0})
+{}
+
+std::size_t
+StateRegistry::probe(const State& state, std::size_t hash) const {
+	const std::size_t mask = _table.size() - 1;
+	const auto fragment = static_cast<uint32_t>(hash);
+
+	for (std::size_t i = hash & mask; ; i = (i + 1) & mask) {
+		const SlotT& slot = _table[i];
+		if (slot.id == INVALID_STATE_ID) return i; // Empty slot, the state is not registered
+		if (slot.hash == fragment && _states[slot.id] == state) return i;
+	}
+}
+
+std::pair<StateID, bool>
+StateRegistry::insert(State&& state) {
+	const std::size_t hash = state.hash();
+	std::size_t i = probe(state, hash);
+	if (_table[i].id != INVALID_STATE_ID) return std::make_pair(_table[i].id, false);
+
+	assert(_states.size() < INVALID_STATE_ID);
+	const auto id = static_cast<StateID>(_states.size());
+	_states.emplace_back(std::move(state));
+	_table[i] = SlotT{id, static_cast<uint32_t>(hash)};
+
+	// Keep the load factor of the table below 1/2
+	if (2 * _states.size() > _table.size()) grow();
+
+	return std::make_pair(id, true);
+}
+
+StateID
+StateRegistry::find(const State& state) const {
+	return _table[probe(state, state.hash())].id;
+}
+
+void
+StateRegistry::grow() {
+	std::vector<SlotT> table(2 * _table.size(), SlotT{INVALID_STATE_ID, 0});
+	const std::size_t mask = table.size() - 1;
+
+	for (const SlotT& slot:_table) {
+		if (slot.id == INVALID_STATE_ID) continue;
+		std::size_t i = _states[slot.id].hash() & mask;
+		while (table[i].id != INVALID_STATE_ID) i = (i + 1) & mask;
+		table[i] = slot;
+	}
+	_table.swap(table);
+}
+
+void
+StateRegistry::release(StateID id) {
+	assert(id < _states.size() && _states[id].words() != nullptr); // Otherwise the state was already released
+	const std::size_t mask = _table.size() - 1;
+	std::size_t i = probe(_states[id], _states[id].hash());
+	assert(_table[i].id == id);
+
+	// Backward-shift deletion: move back every entry of the cluster that follows the removed one and
+	// whose home slot is not between both, so that probing never needs tombstones.
+	for (std::size_t j = (i + 1) & mask; _table[j].id != INVALID_STATE_ID; j = (j + 1) & mask) {
+		std::size_t home = _states[_table[j].id].hash() & mask;
+		if (((j - home) & mask) >= ((j - i) & mask)) {
+			_table[i] = _table[j];
+			i = j;
+		}
+	}
+	_table[i] = SlotT{INVALID_STATE_ID, 0};
+
+	// Moving the state out leaves an empty shell in the deque, and returns its buffer to the arena
+	State released(std::move(_states[id]));
+}
+
+void
+StateRegistry::clear() {
+	_states.clear();
+	std::fill(_table.begin(), _table.end(), SlotT{INVALID_STATE_ID, 0});
+}
+
+} // namespaces
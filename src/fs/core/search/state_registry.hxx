@@ -0,0 +1,108 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <fs/core/state.hxx>
+
+
+namespace fs0 {
+
+//! A dense identifier of a state interned in a StateRegistry.
+//! NOTE We're assuming we won't register more than 2^32 ~ 4.2 billion different states.
+using StateID = uint32_t;
+const StateID INVALID_STATE_ID = std::numeric_limits<uint32_t>::max();
+
+//! A StateRegistry interns (packed) states, so that each distinct state is stored exactly once and
+//! is identified by a dense StateID. Duplicate detection thus boils down to probing an open-addressing
+//! hash table of 32-bit IDs, and search nodes can refer to their state through a fixed-size ID,
+//! instead of owning a full copy of the state.
+//! Interned states have a stable address for the whole lifetime of the registry, or until they are released.
+//! Releasing a state frees its buffer and forgets it, but its ID is never reused, so that search
+//! engines can drop the states of nodes they prune without invalidating the IDs of the rest.
+class StateRegistry {
+public:
+	explicit StateRegistry(std::size_t initial_capacity = 1024);
+	~StateRegistry() = default;
+
+	StateRegistry(const StateRegistry&) = delete;
+	StateRegistry(StateRegistry&&) = default;
+	StateRegistry& operator=(const StateRegistry&) = delete;
+	StateRegistry& operator=(StateRegistry&&) = delete;
+
+	//! Intern the given state and return its ID, plus a flag indicating whether the state
+	//! was new, i.e. had not been registered before.
+	std::pair<StateID, bool> insert(State&& state);
+	std::pair<StateID, bool> insert(const State& state) { return insert(State(state)); }
+
+	//! Return the ID of the given state, or INVALID_STATE_ID if the state has not been registered.
+	StateID find(const State& state) const;
+
+	bool contains(const State& state) const { return find(state) != INVALID_STATE_ID; }
+
+	//! Return the state with the given ID
+	const State& get(StateID id) const {
+		assert(id < _states.size());
+		return _states[id];
+	}
+
+	//! The number of IDs given out so far, including those of released states
+	std::size_t size() const { return _states.size(); }
+
+	//! Free the state with the given ID, which must no longer be referenced by anyone. If the same
+	//! state is inserted again later on, it will be considered new and given a fresh ID.
+	void release(StateID id);
+
+	//! Forget all registered states
+	void clear();
+
+protected:
+	//! A slot of the hash table: the ID of the state plus the (truncated) hash of the state,
+	//! which allows us to skip most non-matching entries without touching the state itself.
+	struct SlotT {
+		StateID id;
+		uint32_t hash;
+	};
+
+	//! The interned states. A deque guarantees that addresses are not invalidated upon insertion.
+	std::deque<State> _states;
+
+	//! The open-addressing (linear probing) hash table. Its size is always a power of two.
+	std::vector<SlotT> _table;
+
+	//! Return the index of the slot where the state with the given hash is (or would be) stored
+	std::size_t probe(const State& state, std::size_t hash) const;
+
+	//! Double the size of the hash table and rehash all registered states
+	void grow();
+};
+
+
+//! A set of state IDs, implemented as a bitmap over the (dense) ID space.
+//! Typically used as a closed list keyed on the IDs given by some StateRegistry.
+class StateIDSet {
+public:
+	StateIDSet() = default;
+
+	bool contains(StateID id) const { return id < _bits.size() && _bits[id]; }
+
+	void insert(StateID id) {
+		if (id >= _bits.size()) _bits.resize(std::max<std::size_t>(id + 1, 2 * _bits.size()), false);
+		_bits[id] = true;
+	}
+
+	void erase(StateID id) {
+		if (id < _bits.size()) _bits[id] = false;
+	}
+
+	void clear() { _bits.clear(); }
+
+protected:
+	std::vector<bool> _bits;
+};
+
+} // namespaces
@@ -10,21 +10,29 @@ namespace fs0 {
 
 class SearchStats {
 public:
-	SearchStats() : _expanded(0), _generated(0), _evaluated(0), _initial_search_time(-1) {}
+	SearchStats() : _expanded(0), _generated(0), _evaluated(0), _cache_hits(0), _cache_misses(0), _initial_search_time(-1) {}
 	
 	void expansion() { ++_expanded; }
-	void generation(std::size_t distance) {
+	void generation(std::size_t distance) { generation(distance, 1); }
+	
+	//! Account for a number of expansions / generations at once, e.g. those made in parallel by different threads
+	void expansion(unsigned long count) { _expanded += count; }
+	void generation(std::size_t distance, unsigned long count) {
 	    if (distance >= _generated_at_distance.size()) {
             _generated_at_distance.resize(distance+1, 0);
 	    }
-	    ++_generated_at_distance[distance];
-	    ++_generated;
+	    _generated_at_distance[distance] += count;
+	    _generated += count;
 	}
 	void evaluation() { ++_evaluated; }
+	void cache_hit() { ++_cache_hits; }
+	void cache_miss() { ++_cache_misses; }
 
 	unsigned long expanded() const { return _expanded; }
 	unsigned long generated() const { return _generated; }
 	unsigned long evaluated() const { return _evaluated; }
+	unsigned long cache_hits() const { return _cache_hits; }
+	unsigned long cache_misses() const { return _cache_misses; }
 
 	unsigned long generated_until_last_layer() const {
         auto size = _generated_at_distance.size();
@@ -41,7 +49,9 @@ public:
 			std::make_tuple("expanded", "Expansions", std::to_string(expanded())),
 			std::make_tuple("generated", "Generations", std::to_string(generated())),
             std::make_tuple("generated_until_last_layer", "Generations until last layer", std::to_string(generated_until_last_layer())),
-			std::make_tuple("evaluated", "Evaluations", std::to_string(evaluated()))
+			std::make_tuple("evaluated", "Evaluations", std::to_string(evaluated())),
+			std::make_tuple("heuristic_cache_hits", "Heuristic cache hits", std::to_string(cache_hits())),
+			std::make_tuple("heuristic_cache_misses", "Heuristic cache misses", std::to_string(cache_misses()))
 		};
 	}
 
@@ -62,6 +72,8 @@ protected:
 	unsigned long _generated;
     std::vector<unsigned long> _generated_at_distance;
 	unsigned long _evaluated;
+	unsigned long _cache_hits;
+	unsigned long _cache_misses;
 	double _initial_search_time;
 };
 
@@ -8,6 +8,7 @@
 #include <fs/core/state.hxx>
 #include <fs/core/search/stats.hxx>
 #include <fs/core/search/options.hxx>
+#include <fs/core/search/cancellation.hxx>
 #include <fs/core/utils/printers/printers.hxx>
 #include <fs/core/utils/system.hxx>
 
@@ -85,15 +86,16 @@ static void dump_stats(std::ofstream& out, const StatsT& stats) {
                     solved = false;
                 }
             } else {
+                // Running out of memory is reported to the caller, which exits once it is safe to do so
                 try {
                     solved = engine.solve_model(plan);
                 }
                 catch (const std::bad_alloc &ex) {
-                    out_of_memory_handler();
-                    exit_with(ExitCode::SEARCH_OUT_OF_MEMORY);
+                    LPT_INFO("cout", "Failed to allocate memory");
+                    throw SearchOutOfMemory();
                 } catch (const Gecode::MemoryExhausted& ex) {
-                    out_of_memory_handler();
-                    exit_with(ExitCode::SEARCH_OUT_OF_MEMORY);
+                    LPT_INFO("cout", "Gecode memory exhausted");
+                    throw SearchOutOfMemory();
                 }
             }
 
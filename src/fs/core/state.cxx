@@ -1,5 +1,7 @@
 
-#include <boost/functional/hash.hpp>
+#include <algorithm>
+#include <limits>
+#include <random>
 
 #include <fs/core/state.hxx>
 #include <fs/core/problem_info.hxx>
@@ -9,61 +11,137 @@
 namespace fs0 {
 
 
+namespace {
+
+//! A helper to compute the number of bits required to encode 'n' distinct codes
+unsigned bits_for(uint64_t n) {
+	unsigned bits = 1;
+	while (bits < 64 && (uint64_t(1) << bits) < n) ++bits;
+	return bits;
+}
+
+} // namespace
+
 StateAtomIndexer*
-StateAtomIndexer::create(const ProblemInfo& info)
-{
-	unsigned n_vars = info.getNumVariables(), n_bool = 0, n_int = 0;
-	IndexT index;
-	index.reserve(n_vars);
+StateAtomIndexer::create(const ProblemInfo& info) {
+	std::vector<VariableT> variables;
+	for (unsigned var = 0; var < info.getNumVariables(); ++var) {
+		VariableT variable{info.isPredicativeVariable(var), info.sv_type(var), 0, 0};
+		if (!variable.predicative && (variable.type == type_id::object_t || variable.type == type_id::bool_t)) {
+			const auto& objects = info.getVariableObjects(var);
+			if (!objects.empty()) {
+				variable.min = variable.max = objects.front().value();
+				for (const object_id& o:objects) {
+					variable.min = std::min(variable.min, o.value());
+					variable.max = std::max(variable.max, o.value());
+				}
+			}
+		}
+		variables.push_back(variable);
+	}
+	return create(variables);
+}
+
+StateAtomIndexer*
+StateAtomIndexer::create(const std::vector<VariableT>& variables) {
+	unsigned n_vars = variables.size(), n_bool = 0, n_int = 0;
+	for (const VariableT& variable:variables) {
+		if (variable.predicative) ++n_bool;
+	}
+	n_int = n_vars - n_bool;
+
+	IndexT index(n_vars);
+
+	// Predicative variables are packed first, one bit each
+	unsigned bit = 0;
+	for (unsigned var = 0; var < n_vars; ++var) {
+		if (!variables[var].predicative) continue;
+		index[var] = FieldT{bit / WORD_BITS, bit % WORD_BITS, 1, 0, type_id::bool_t, true, true, 0};
+		++bit;
+	}
+
+	// Multivalued variables come next, each in a field of minimal width
 	for (unsigned var = 0; var < n_vars; ++var) {
-		if (info.isPredicativeVariable(var)) {
-			index.push_back(std::make_pair(true, n_bool++)); // Important to post-increment
-		} else {
-			index.push_back(std::make_pair(false, n_int++)); // Important to post-increment
+		const VariableT& variable = variables[var];
+		if (variable.predicative) continue;
+		type_id type = variable.type;
+
+		// Numeric variables are not coded, as some transitions (e.g. those later discarded by state constraints)
+		// might temporarily take them out of the bounds of their type.
+		bool coded = (type == type_id::object_t || type == type_id::bool_t);
+		object_id::value_t base = 0;
+		unsigned width = 33;
+
+		if (coded) {
+			base = variable.min;
+			width = bits_for(uint64_t(variable.max - variable.min) + 2); // Account for the value 'invalid'
+		}
+
+		if (bit % WORD_BITS + width > WORD_BITS) { // Do not let the field straddle two words
+			bit += WORD_BITS - bit % WORD_BITS;
 		}
+		WordT mask = (width == WORD_BITS) ? ~WordT(0) : ((WordT(1) << width) - 1);
+		index[var] = FieldT{bit / WORD_BITS, bit % WORD_BITS, mask, base, type, coded, false, 0};
+		bit += width;
 	}
-	assert(index.size() == n_vars && n_vars == n_bool + n_int);
 
-	return new StateAtomIndexer(std::move(index), n_bool, n_int);
+	// Draw one random Zobrist key for each possible code of each coded field, i.e. for each atom of the problem.
+	// We use a fixed seed so that runs are reproducible.
+	std::vector<WordT> zobrist;
+	std::mt19937_64 rng(1);
+	for (FieldT& field:index) {
+		if (!field.coded) continue;
+		field.keys = zobrist.size();
+		zobrist.push_back(0);
+		for (WordT code = 1; code <= field.mask; ++code) zobrist.push_back(rng());
+	}
+
+	std::size_t n_words = (bit + WORD_BITS - 1) / WORD_BITS;
+	return new StateAtomIndexer(std::move(index), n_bool, n_int, n_words, std::move(zobrist));
 }
 
-StateAtomIndexer::StateAtomIndexer(IndexT&& index, unsigned n_bool, unsigned n_int) :
-	_index(std::move(index)), _n_bool(n_bool), _n_int(n_int)
+StateAtomIndexer::StateAtomIndexer(IndexT&& index, unsigned n_bool, unsigned n_int, std::size_t n_words, std::vector<WordT>&& zobrist) :
+	_index(std::move(index)), _n_bool(n_bool), _n_int(n_int), _n_words(n_words),
+	_zobrist(std::move(zobrist)),
+	_owners(n_words * WORD_BITS, std::numeric_limits<VariableIdx>::max()),
+	_arena(std::make_shared<StateArena>(n_words))
 {
+	for (VariableIdx variable = 0; variable < _index.size(); ++variable) {
+		const FieldT& f = _index[variable];
+		for (unsigned b = 0; b < WORD_BITS && (f.mask >> b); ++b) {
+			_owners[f.word * WORD_BITS + f.shift + b] = variable;
+		}
+	}
 }
 
-object_id
-StateAtomIndexer::get(const State& state, VariableIdx variable) const {
-	std::size_t n_vars = _index.size();
-	assert(variable < n_vars);
-
-	// If the state is fully boolean or fully multivalued, we can optimize the operation,
-	// since the variable index will be exactly `variable`
-	if (n_vars == _n_bool) return make_object(state._bool_values[variable]);
-	if (n_vars == _n_int) return state._int_values[variable];
+void
+StateAtomIndexer::set(State& state, const Atom& atom) const { set(state, atom.getVariable(), atom.getValue()); }
 
-	// Otherwise we need to deindex the variable
-	const IndexElemT& ind = _index[variable];
-	if (ind.first) return make_object(state._bool_values[ind.second]);
-	else return state._int_values[ind.second];
+StateAtomIndexer::WordT
+StateAtomIndexer::hash(const State& state) const {
+	WordT hash = 0;
+	for (VariableIdx variable = 0; variable < _index.size(); ++variable) {
+		const FieldT& f = _index[variable];
+		hash ^= key(f, variable, (state._words[f.word] >> f.shift) & f.mask);
+	}
+	return hash;
 }
 
 void
-StateAtomIndexer::set(State& state, const Atom& atom) const { set(state, atom.getVariable(), atom.getValue()); }
+StateAtomIndexer::diff(const State& s1, const State& s2, std::vector<VariableIdx>& changed) const {
+	diff(s1._words, s2._words, changed);
+}
 
 void
-StateAtomIndexer::set(State& state, VariableIdx variable, const object_id& value) const {
-	std::size_t n_vars = _index.size();
-	assert(variable < n_vars);
-
-	// If the state is fully boolean or fully multivalued, we can optimize the operation,
-	// since the variable index will be exactly `variable`
-	if (n_vars == _n_bool) state._bool_values[variable] = bool(value);
-	else if (n_vars == _n_int) state._int_values[variable] = value;
-	else {
-		const IndexElemT& ind = _index[variable];
-		if (ind.first) state._bool_values[ind.second] = bool(value);
-		else state._int_values[ind.second] = value;
+StateAtomIndexer::diff(const WordT* w1, const WordT* w2, std::vector<VariableIdx>& changed) const {
+	for (std::size_t w = 0; w < _n_words; ++w) {
+		WordT delta = w1[w] ^ w2[w];
+		while (delta) {
+			VariableIdx variable = _owners[w * WORD_BITS + __builtin_ctzll(delta)];
+			const FieldT& f = _index[variable];
+			changed.push_back(variable);
+			delta &= ~(f.mask << f.shift); // Skip the rest of bits of the same field
+		}
 	}
 }
 
@@ -74,22 +152,48 @@ State* State::create(const StateAtomIndexer& index, unsigned numAtoms, const std
 
 State::State(const StateAtomIndexer& index, const std::vector<Atom>& atoms) :
 	_indexer(index),
-	_bool_values(index.num_bool(), false),
-	_int_values(index.num_int(), object_id::INVALID),
-    _hash(0)
+	_words(index.arena().allocate()),
+	_hash(0)
 {
-	// Note that those facts not explicitly set in the initial state will be initialized to 0, i.e. "false", which is convenient to us.
+	// All variables start with a zero code, i.e. as "false" for predicative variables and
+	// as invalid for multivalued ones. Those facts not explicitly set in the initial state will
+	// thus be initialized to "false", which is convenient to us.
+	std::fill(_words, _words + _indexer.num_words(), WordT(0));
 	for (const Atom& atom:atoms) { // Insert all the elements of the vector
 		set(atom);
 	}
 	updateHash();
 }
 
+State::State(const State& other) :
+	_indexer(other._indexer),
+	_words(other._indexer.arena().allocate()),
+	_hash(other._hash)
+{
+	std::copy(other._words, other._words + _indexer.num_words(), _words);
+}
+
+State::State(State&& other) noexcept :
+	_indexer(other._indexer),
+	_words(other._words),
+	_hash(other._hash)
+{
+	other._words = nullptr;
+}
+
 State::State(const State& state, const std::vector<Atom>& atoms) :
 	State(state) {
     update(atoms);
 }
 
+State::~State() {
+	if (_words) _indexer.arena().release(_words);
+}
+
+bool State::operator==(const State &rhs) const {
+	return _hash == rhs._hash && std::equal(_words, _words + _indexer.num_words(), rhs._words);
+}
+
 void State::set(const Atom& atom) {
 // 	_bool_values.at(atom.getVariable()) = value;
 #ifdef DEBUG
@@ -103,17 +207,17 @@ bool State::contains(const Atom& atom) const {
 	return getValue(atom.getVariable()) == atom.getValue();
 }
 
-object_id
-State::getValue(const VariableIdx& variable) const {
-	return _indexer.get(*this, variable);
-}
-
 //! Applies the given changeset into the current state.
 void State::update(const std::vector<Atom>& atoms) {
+	// Atoms are applied in order, so that repeated or contradictory atoms are correctly accounted for in the hash
 	for (const Atom& fact:atoms) {
-		set(fact);
+#ifdef DEBUG
+		const ProblemInfo& info = ProblemInfo::getInstance();
+		assert( info.sv_type(fact.getVariable()) == o_type(fact.getValue()) );
+#endif
+		_hash ^= _indexer.update(*this, fact.getVariable(), fact.getValue());
 	}
-	updateHash(); // Important to update the hash value after all the changes have been applied!
+	assert(_hash == computeHash());
 }
 
 std::ostream& State::print(std::ostream& os) const {
@@ -143,30 +247,7 @@ std::ostream& State::print(std::ostream& os) const {
 
 
 std::size_t State::computeHash() const {
-	//return std::hash<BitsetT>{}(_bool_values);
-//     auto a = boost::hash_value( _bool_values);
-//     auto b = boost::hash_value( _int_values);
-// 	return boost::hash_value(_bool_values);
-	std::size_t seed = 0;
-	boost::hash_combine(seed, std::hash<BitsetT>{}(_bool_values));
-	boost::hash_combine(seed, boost::hash_value( _int_values));
-	return seed;
-
-}
-
-
-template <>
-const std::vector<bool>&
-State::dump() const {
-	assert(_indexer.is_fully_binary());
-	return _bool_values;
-}
-
-template <>
-const std::vector<object_id>&
-State::dump() const {
-	assert(_indexer.is_fully_multivalued());
-	return _int_values;
+	return _indexer.hash(*this);
 }
 
 
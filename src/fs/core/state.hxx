@@ -1,8 +1,9 @@
-
 #pragma once
 
+#include <stdexcept>
+
 #include <fs/core/fs_types.hxx>
-// #include <fs/core/utils/bitsets.hxx>
+#include <fs/core/utils/state_arena.hxx>
 
 
 namespace fs0 {
@@ -13,55 +14,128 @@ class StateAtomIndexer;
 class ProblemInfo;
 class State;
 
+//! The StateAtomIndexer defines the packed layout of all the states of a problem.
+//! The values of all state variables are stored in a single contiguous buffer of 64-bit words:
+//! predicative variables take one bit each and come first, whereas each multivalued variable takes
+//! a field whose width is the minimum number of bits that can encode all values in its domain (plus
+//! an extra code for the invalid value). Fields never straddle a word boundary.
 class StateAtomIndexer {
 public:
-	using IndexElemT = std::pair<bool, unsigned>;
-	using IndexT = std::vector<IndexElemT>;
+	using WordT = StateArena::WordT;
+	static const unsigned WORD_BITS = 64;
+
+	//! The description of how the value of a single state variable is stored in the word buffer.
+	//! 'coded' fields store (value - base + 1), 0 standing for the invalid value. Non-coded fields
+	//! are used for variables with unbounded (numeric) domains, and store the raw 32-bit value plus a validity bit.
+	//! 'keys' is the offset of the Zobrist keys of the (coded) field, one per possible code.
+	struct FieldT {
+		unsigned word;
+		unsigned shift;
+		WordT mask;
+		object_id::value_t base;
+		type_id type;
+		bool coded;
+		bool predicative;
+		std::size_t keys;
+	};
+	using IndexT = std::vector<FieldT>;
+
+	//! What the layout needs to know about a state variable: whether it is predicative, its type, and,
+	//! for object and Boolean variables, the min. and max. values of its domain.
+	struct VariableT {
+		bool predicative;
+		type_id type;
+		object_id::value_t min;
+		object_id::value_t max;
+	};
 
 protected:
-	//! Assume _index[v] = (b,i). This means that the value of the state variable v
-	//! is stored in the i-th position of the vector of bools (if b is true) or the vector
-	//! of ints (if b is false)
+	//! _index[v] describes the field where the value of the state variable v is stored
 	const IndexT _index;
 
 	std::size_t _n_bool;
 	std::size_t _n_int;
 
+	//! The number of words of each state
+	std::size_t _n_words;
+
+	//! The Zobrist keys of all (variable, code) pairs of coded fields. The key of code 0 is always 0,
+	//! so that the hash of a state only depends on the variables with non-zero code.
+	std::vector<WordT> _zobrist;
+
+	//! _owners[w * WORD_BITS + b] is the variable whose field covers bit 'b' of word 'w'
+	std::vector<VariableIdx> _owners;
+
+	//! The arena where all the state buffers are allocated. Copies of the indexer allocate from the same arena.
+	std::shared_ptr<StateArena> _arena;
+
 	//! Private constructor
-	StateAtomIndexer(IndexT&& index, unsigned n_bool, unsigned n_int);
+	StateAtomIndexer(IndexT&& index, unsigned n_bool, unsigned n_int, std::size_t n_words, std::vector<WordT>&& zobrist);
 
 public:
-	//! Factory method
+	//! Factory methods
 	static StateAtomIndexer* create(const ProblemInfo& info);
+	static StateAtomIndexer* create(const std::vector<VariableT>& variables);
 
 	std::size_t size() const { return _index.size(); }
 
 	std::size_t num_bool() const { return _n_bool; }
 	std::size_t num_int() const { return _n_int; }
 
+	//! The number of 64-bit words required to store the value of all state variables
+	std::size_t num_words() const { return _n_words; }
+
 	bool is_fully_binary() const { return _n_int == 0; }
 	bool is_fully_multivalued() const { return _n_bool == 0; }
 
+	StateArena& arena() const { return *_arena; }
+
+	const FieldT& field(VariableIdx variable) const { return _index[variable]; }
+
 	//! Obtain and return the value of the given variable from the given state
-	object_id get(const State& state, VariableIdx variable) const;
+	inline object_id get(const State& state, VariableIdx variable) const;
 
 	//! Set a value into the state
 	void set(State& state, const Atom& atom) const;
-	void set(State& state, VariableIdx variable, const object_id& value) const;
+	inline void set(State& state, VariableIdx variable, const object_id& value) const;
+
+	//! Set a value into the state, and return the value that needs to be XOR'ed into the (Zobrist) hash
+	//! of the state to account for the change.
+	inline WordT update(State& state, VariableIdx variable, const object_id& value) const;
+
+	//! Overwrite the bits of the given word of the state that are set in 'mask' with the corresponding bits of 'values',
+	//! all of which must belong to predicative variables, and return the value that needs to be XOR'ed into the hash.
+	inline WordT update_bits(State& state, std::size_t word, WordT mask, WordT values) const;
+
+	//! Compute from scratch the Zobrist hash of the given state
+	WordT hash(const State& state) const;
+
+	//! Append to 'changed' the indexes of all variables that have different values in the two given states.
+	//! The cost is linear in the number of words of a state, plus the number of differing variables.
+	void diff(const State& s1, const State& s2, std::vector<VariableIdx>& changed) const;
+
+	//! Same as above, but on the raw words of two states, e.g. a copy of the words of some state that is no longer alive
+	void diff(const WordT* w1, const WordT* w2, std::vector<VariableIdx>& changed) const;
+
+protected:
+	//! Encode and decode values into / from the raw contents of a field
+	static inline WordT encode(const FieldT& field, const object_id& value);
+	static inline object_id decode(const FieldT& field, WordT raw);
+
+	//! The Zobrist key of the given raw contents of the field of the given variable
+	inline WordT key(const FieldT& field, VariableIdx variable, WordT raw) const;
 };
 
 class State {
 	friend class StateAtomIndexer;
 public:
-	// using BitsetT = boost::dynamic_bitset<>;
-	using BitsetT = std::vector<bool>;
+	using WordT = StateAtomIndexer::WordT;
 
 protected:
 	const StateAtomIndexer& _indexer;
 
-	//! A vector mapping state variable (implicit) ids to their value in the current state.
-	BitsetT _bool_values;
-	std::vector<object_id> _int_values;
+	//! The packed values of all state variables, allocated from the arena of the indexer.
+	WordT* _words;
 
 	std::size_t _hash;
 
@@ -71,7 +145,7 @@ protected:
 	State(const StateAtomIndexer& index, const std::vector<Atom>& atoms);
 
 public:
-	~State() = default;
+	~State();
 
 	//! Factory method
 	static State* create(const StateAtomIndexer& index, unsigned numAtoms, const std::vector<Atom>& atoms);
@@ -81,28 +155,36 @@ public:
 	//! state plus the new atoms. Note that we do not check that there are no contradictory atoms.
 	State(const State& state, const std::vector<Atom>& atoms);
 
-	//! Default copy constructors and assignment operators
-	State(const State&) = default;
-	State(State&&) = default;
+	//! Copy and move constructors. Copying a state costs one arena allocation plus a copy of its words.
+	State(const State& other);
+	State(State&& other) noexcept;
 	State& operator=(const State&) = delete;
 	State& operator=(State&&) = delete;
 
 	// Check the hash first for performance.
-	bool operator==(const State &rhs) const { return _hash == rhs._hash && _bool_values == rhs._bool_values && _int_values == rhs._int_values; }
+	bool operator==(const State &rhs) const;
 	bool operator!=(const State &rhs) const { return !(this->operator==(rhs));}
 
 
 	bool contains(const Atom& atom) const;
 
-	object_id getValue(const VariableIdx& variable) const;
+	object_id getValue(const VariableIdx& variable) const { return _indexer.get(*this, variable); }
 
-	unsigned numAtoms() const { return _bool_values.size() + _int_values.size(); }
+	unsigned numAtoms() const { return _indexer.size(); }
 
 	//! "Applies" the given atoms into the current state.
+	//! The hash of the state is updated incrementally, in time linear in the number of atoms.
 	void update(const std::vector<Atom>& atoms);
 
-	template <typename ValueT>
-	const std::vector<ValueT>& dump() const;
+	//! Overwrite the bits of the given word that are set in 'mask' with those of 'values', all of which must
+	//! belong to predicative variables (see StateAtomIndexer::update_bits). The hash is updated incrementally.
+	void update_bits(std::size_t word, WordT mask, WordT values) { _hash ^= _indexer.update_bits(*this, word, mask, values); }
+
+	//! Raw access to the packed representation of the state
+	const WordT* words() const { return _words; }
+	std::size_t num_words() const { return _indexer.num_words(); }
+
+	const StateAtomIndexer& indexer() const { return _indexer; }
 
 	//! Fast method to update values in state, it DOES NOT update the
 	//! hash, so use at your own peril!
@@ -128,4 +210,88 @@ public:
 	std::size_t hash() const { return _hash; }
 };
 
+
+inline StateAtomIndexer::WordT
+StateAtomIndexer::encode(const FieldT& field, const object_id& value) {
+	if (o_type(value) == type_id::invalid_t) return 0;
+	if (!field.coded) return (WordT(1) << 32) | value.value();
+	WordT code = WordT(object_id::value_t(value.value() - field.base)) + 1;
+	// A code out of range would silently overwrite the neighbouring fields of the word
+	if (code > field.mask) throw std::runtime_error("Value out of the domain of a state variable");
+	return code;
+}
+
+inline object_id
+StateAtomIndexer::decode(const FieldT& field, WordT raw) {
+	if (raw == 0) return object_id::INVALID;
+	if (!field.coded) return make_object(field.type, object_id::value_t(raw));
+	return make_object(field.type, object_id::value_t(field.base + object_id::value_t(raw - 1)));
+}
+
+inline object_id
+StateAtomIndexer::get(const State& state, VariableIdx variable) const {
+	assert(variable < _index.size());
+
+	// If the state is fully boolean, we can optimize the operation,
+	// since the bit index will be exactly `variable`
+	if (_n_int == 0) {
+		return make_object(type_id::bool_t, unsigned((state._words[variable / WORD_BITS] >> (variable % WORD_BITS)) & 1));
+	}
+
+	const FieldT& f = _index[variable];
+	WordT raw = (state._words[f.word] >> f.shift) & f.mask;
+	if (f.predicative) return make_object(type_id::bool_t, unsigned(raw));
+	return decode(f, raw);
+}
+
+inline StateAtomIndexer::WordT
+StateAtomIndexer::key(const FieldT& field, VariableIdx variable, WordT raw) const {
+	if (raw == 0) return 0;
+	if (field.coded) return _zobrist[field.keys + raw];
+
+	// Non-coded fields have too large a domain to tabulate their keys, so we mix
+	// the raw value with the variable index instead (splitmix64 finalizer)
+	WordT z = raw + (WordT(variable) + 1) * 0x9E3779B97F4A7C15ULL;
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+inline StateAtomIndexer::WordT
+StateAtomIndexer::update(State& state, VariableIdx variable, const object_id& value) const {
+	assert(variable < _index.size());
+	const FieldT& f = _index[variable];
+	WordT raw = f.predicative ? WordT(bool(value)) : encode(f, value);
+	WordT& word = state._words[f.word];
+	WordT old = (word >> f.shift) & f.mask;
+	if (old == raw) return 0;
+	word = (word & ~(f.mask << f.shift)) | (raw << f.shift);
+	return key(f, variable, old) ^ key(f, variable, raw);
+}
+
+inline StateAtomIndexer::WordT
+StateAtomIndexer::update_bits(State& state, std::size_t word, WordT mask, WordT values) const {
+	WordT& w = state._words[word];
+	WordT changed = (w ^ values) & mask;
+	w ^= changed;
+
+	// The key of a predicative variable is that of its code 1, as the key of code 0 is always 0
+	WordT delta = 0;
+	for (; changed; changed &= changed - 1) {
+		const FieldT& f = _index[_owners[word * WORD_BITS + __builtin_ctzll(changed)]];
+		assert(f.predicative);
+		delta ^= _zobrist[f.keys + 1];
+	}
+	return delta;
+}
+
+inline void
+StateAtomIndexer::set(State& state, VariableIdx variable, const object_id& value) const {
+	assert(variable < _index.size());
+	const FieldT& f = _index[variable];
+	WordT raw = f.predicative ? WordT(bool(value)) : encode(f, value);
+	WordT& word = state._words[f.word];
+	word = (word & ~(f.mask << f.shift)) | (raw << f.shift);
+}
+
 } // namespaces
@@ -84,6 +84,7 @@ void Config::load(const std::string& filename) {
 		{"naive", SuccessorGenerationStrategy::naive},
 		{"functional_aware", SuccessorGenerationStrategy::functional_aware},
 		{"match_tree", SuccessorGenerationStrategy::match_tree},
+		{"flat_match_tree", SuccessorGenerationStrategy::flat_match_tree},
 		{"adaptive", SuccessorGenerationStrategy::adaptive}}
 	);
 }
@@ -13,6 +13,7 @@
 #include <fs/core/utils/utils.hxx>
 #include <fs/core/utils/printers/registry.hxx>
 #include <fs/core/utils/config.hxx>
+#include <fs/core/utils/problem_image.hxx>
 #include <fs/core/state.hxx>
 #include <fs/core/fstrips/language_info.hxx>
 #include <fs/core/languages/fstrips/formulae.hxx>
@@ -165,7 +166,13 @@ ProblemInfo&
 Loader::loadProblemInfo(const rapidjson::Document& data, const std::string& data_dir, const BaseComponentFactory& factory) {
 	// Load and set the ProblemInfo data structure
 	auto info = std::make_unique<ProblemInfo>(data, data_dir);
+
+	// The static extensions are read from the precompiled problem image whenever possible
+	bool use_image = Config::instance().getOption<bool>("problem_image", true);
+	if (use_image) ProblemImage::init(data_dir);
 	loadFunctions(factory, *info);
+	if (use_image) ProblemImage::current()->export_if_outdated();
+
 	return ProblemInfo::setInstance(std::move(info));
 }
 
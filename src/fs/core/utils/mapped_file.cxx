@@ -0,0 +1,52 @@
+
+#include <fstream>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <fs/core/utils/mapped_file.hxx>
+
+
+namespace fs0 {
+
+MappedFile::MappedFile(const std::string& filename) : _data(nullptr), _size(0) {
+	int fd = ::open(filename.c_str(), O_RDONLY);
+	if (fd < 0) return;
+	struct stat st{};
+	if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+		void* data = ::mmap(nullptr, (std::size_t) st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (data != MAP_FAILED) {
+			_data = data;
+			_size = (std::size_t) st.st_size;
+		}
+	}
+	::close(fd);
+}
+
+MappedFile::~MappedFile() {
+	if (_data) ::munmap(_data, _size);
+}
+
+uint64_t hash_bytes(const char* data, std::size_t size, uint64_t hash) {
+	for (std::size_t i = 0; i < size; ++i) {
+		hash ^= (unsigned char) data[i];
+		hash *= 0x100000001b3ULL;
+	}
+	return hash;
+}
+
+uint64_t hash_file(const std::string& filename, uint64_t hash) {
+	std::ifstream is(filename, std::ios::binary);
+	if (is.fail()) return hash;
+	std::vector<char> buffer(1 << 16);
+	while (is) {
+		is.read(buffer.data(), buffer.size());
+		hash = hash_bytes(buffer.data(), (std::size_t) is.gcount(), hash);
+	}
+	return hash;
+}
+
+} // namespaces
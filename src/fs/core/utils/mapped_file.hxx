@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+
+namespace fs0 {
+
+//! A read-only memory mapping of a whole file, e.g. of some precompiled binary data.
+//! Empty and non-existing files are mapped as empty.
+class MappedFile {
+public:
+	explicit MappedFile(const std::string& filename);
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile(MappedFile&&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	MappedFile& operator=(MappedFile&&) = delete;
+
+	bool empty() const { return _data == nullptr; }
+
+	//! The contents of the file, seen as an array of 32-bit words. Trailing bytes that do not make up a whole word are ignored.
+	const uint32_t* words() const { return static_cast<const uint32_t*>(_data); }
+	std::size_t num_words() const { return _size / sizeof(uint32_t); }
+
+protected:
+	void* _data;
+	std::size_t _size;
+};
+
+//! The seed of the hash functions below
+const uint64_t FNV_SEED = 0xcbf29ce484222325ULL;
+
+//! 64-bit FNV-1a hash of the given bytes, chained from the given hash value
+uint64_t hash_bytes(const char* data, std::size_t size, uint64_t hash = FNV_SEED);
+
+//! Chain the contents of the given file into the given hash value. Missing files count as empty.
+uint64_t hash_file(const std::string& filename, uint64_t hash = FNV_SEED);
+
+} // namespaces
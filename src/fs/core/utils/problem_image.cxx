@@ -0,0 +1,192 @@
+
+#include <fstream>
+#include <map>
+
+#include <sys/stat.h>
+
+#include <boost/filesystem.hpp>
+
+#include <fs/core/utils/problem_image.hxx>
+#include <lapkt/tools/logging.hxx>
+
+
+namespace fsys = boost::filesystem;
+
+namespace fs0 {
+
+static const uint32_t MAGIC = 0x4d495346; // "FSIM"
+static const std::size_t HEADER_WORDS = 7;
+static const std::size_t ENTRY_WORDS = 9;
+
+std::unique_ptr<ProblemImage> ProblemImage::_instance = nullptr;
+
+void
+ProblemImage::init(const std::string& data_dir) {
+	uint64_t problem_hash = hash_file(data_dir + "/problem.json");
+	_instance = std::unique_ptr<ProblemImage>(new ProblemImage(data_dir + "/problem.image", problem_hash));
+}
+
+ProblemImage::ProblemImage(std::string path, uint64_t problem_hash) :
+	_path(std::move(path)), _problem_hash(problem_hash), _mapping(), _entries(), _recorded()
+{
+	map();
+}
+
+void
+ProblemImage::map() {
+	_mapping = std::make_unique<MappedFile>(_path);
+	const uint32_t* w = _mapping->words();
+	const std::size_t n = _mapping->num_words();
+	if (!w || n < HEADER_WORDS) return;
+
+	if (w[0] != MAGIC || w[1] != VERSION) {
+		LPT_INFO("main", "Ignoring problem image " << _path << " of a different format version");
+		return;
+	}
+
+	uint64_t checksum = hash_bytes(reinterpret_cast<const char*>(w + HEADER_WORDS), (n - HEADER_WORDS) * sizeof(uint32_t));
+	const uint32_t num_entries = w[2];
+	if (w[3] != uint32_t(checksum) || w[4] != uint32_t(checksum >> 32) || HEADER_WORDS + std::size_t(num_entries) * ENTRY_WORDS > n) {
+		LPT_INFO("main", "Ignoring corrupt problem image " << _path);
+		return;
+	}
+
+	if (w[5] != uint32_t(_problem_hash) || w[6] != uint32_t(_problem_hash >> 32)) {
+		LPT_INFO("main", "Ignoring problem image " << _path << " of a different problem.json");
+		return;
+	}
+
+	for (uint32_t i = 0; i < num_entries; ++i) {
+		const uint32_t* e = w + HEADER_WORDS + i * ENTRY_WORDS;
+		if (e[0] + (e[1] + 3) / 4 > n || e[8] > n) return; // Offsets out of bounds, this should never happen with a valid checksum
+		std::string name(reinterpret_cast<const char*>(w + e[0]), e[1]);
+		SignatureT sig{(uint64_t(e[3]) << 32) | e[2], (uint64_t(e[5]) << 32) | e[4]};
+		_entries.emplace(std::move(name), EntryT{sig, e[6], w + e[8]});
+	}
+	LPT_INFO("main", "Mapped problem image " << _path << " with " << _entries.size() << " data files");
+}
+
+std::string
+ProblemImage::key(const std::string& filename) {
+	return fsys::path(filename).filename().string();
+}
+
+bool
+ProblemImage::signature(const std::string& filename, SignatureT& sig) {
+	struct stat st{};
+	if (::stat(filename.c_str(), &st) != 0) return false;
+	sig.size = (uint64_t) st.st_size;
+	sig.mtime = uint64_t(st.st_mtim.tv_sec) * 1000000000ULL + uint64_t(st.st_mtim.tv_nsec);
+	return true;
+}
+
+bool
+ProblemImage::read(const std::string& filename, const RowInserter& inserter) const {
+	auto it = _entries.find(key(filename));
+	if (it == _entries.end()) return false;
+
+	SignatureT sig{};
+	if (!signature(filename, sig) || !(sig == it->second.signature)) return false;
+
+	const uint32_t* data = it->second.data;
+	for (uint32_t r = 0; r < it->second.num_rows; ++r) {
+		const uint32_t size = *data++;
+		std::vector<object_id> row;
+		row.reserve(size);
+		for (uint32_t i = 0; i < size; ++i, data += 2) {
+			row.push_back(make_object(static_cast<type_id>(data[0]), data[1]));
+		}
+		inserter(std::move(row));
+	}
+	return true;
+}
+
+void
+ProblemImage::record(const std::string& filename, const std::vector<std::vector<object_id>>& rows) {
+	SignatureT sig{};
+	if (!signature(filename, sig)) return; // Missing files are not recorded, and are parsed as empty in every run
+	_recorded[key(filename)] = RecordedT{sig, rows};
+}
+
+void
+ProblemImage::export_if_outdated() const {
+	if (_recorded.empty()) return; // All data files were read from the image
+
+	// The new image keeps all files of the current one (which is only mapped if it has the same problem.json),
+	// and adds (or replaces) those parsed in this run
+	struct OutputT { SignatureT signature; uint32_t num_rows; std::vector<uint32_t> data; };
+	std::map<std::string, OutputT> files;
+
+	for (const auto& [name, entry]:_entries) {
+		if (_recorded.count(name)) continue;
+		OutputT out{entry.signature, entry.num_rows, {}};
+		const uint32_t* data = entry.data;
+		for (uint32_t r = 0; r < entry.num_rows; ++r) {
+			const uint32_t size = data[0];
+			out.data.insert(out.data.end(), data, data + 1 + 2 * size);
+			data += 1 + 2 * size;
+		}
+		files.emplace(name, std::move(out));
+	}
+
+	for (const auto& [name, recorded]:_recorded) {
+		OutputT out{recorded.signature, (uint32_t) recorded.rows.size(), {}};
+		for (const auto& row:recorded.rows) {
+			out.data.push_back((uint32_t) row.size());
+			for (const object_id& o:row) {
+				out.data.push_back(static_cast<uint32_t>(o.type()));
+				out.data.push_back(o.value());
+			}
+		}
+		files.emplace(name, std::move(out));
+	}
+
+	std::vector<uint32_t> w(HEADER_WORDS + files.size() * ENTRY_WORDS, 0);
+	w[0] = MAGIC;
+	w[1] = VERSION;
+	w[2] = (uint32_t) files.size();
+
+	std::size_t i = 0;
+	for (const auto& [name, out]:files) {
+		uint32_t* e = &w[HEADER_WORDS + (i++) * ENTRY_WORDS];
+		e[0] = (uint32_t) w.size();
+		e[1] = (uint32_t) name.size();
+		e[2] = uint32_t(out.signature.size);
+		e[3] = uint32_t(out.signature.size >> 32);
+		e[4] = uint32_t(out.signature.mtime);
+		e[5] = uint32_t(out.signature.mtime >> 32);
+		e[6] = out.num_rows;
+		e[7] = 0; // Reserved
+
+		std::vector<uint32_t> padded((name.size() + 3) / 4, 0);
+		std::copy(name.begin(), name.end(), reinterpret_cast<char*>(padded.data()));
+		w.insert(w.end(), padded.begin(), padded.end());
+
+		e = &w[HEADER_WORDS + (i-1) * ENTRY_WORDS]; // 'w' might have been reallocated
+		e[8] = (uint32_t) w.size();
+		w.insert(w.end(), out.data.begin(), out.data.end());
+	}
+
+	uint64_t checksum = hash_bytes(reinterpret_cast<const char*>(w.data() + HEADER_WORDS), (w.size() - HEADER_WORDS) * sizeof(uint32_t));
+	w[3] = uint32_t(checksum);
+	w[4] = uint32_t(checksum >> 32);
+	w[5] = uint32_t(_problem_hash);
+	w[6] = uint32_t(_problem_hash >> 32);
+
+	// Write through a temporary file, so that concurrent runs never map a partial image
+	try {
+		fsys::path tmp(_path);
+		tmp += fsys::unique_path(".%%%%%%%%.tmp");
+		std::ofstream os(tmp.string(), std::ios::binary);
+		os.write(reinterpret_cast<const char*>(w.data()), w.size() * sizeof(uint32_t));
+		os.close();
+		if (os.fail()) throw std::runtime_error("could not write " + tmp.string());
+		fsys::rename(tmp, _path);
+		LPT_INFO("main", "Exported problem image " << _path << " with " << files.size() << " data files");
+
+	} catch (const std::exception& ex) {
+		LPT_INFO("main", "WARNING: Could not export problem image " << _path << ": " << ex.what());
+	}
+}
+
+} // namespaces
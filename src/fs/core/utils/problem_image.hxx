@@ -0,0 +1,99 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <fs/core/base.hxx>
+#include <fs/core/utils/mapped_file.hxx>
+
+
+namespace fs0 {
+
+//! A precompiled binary image of the text data files of a problem (i.e. the extensions of its static symbols),
+//! which is memory-mapped at startup, so that the rows of each file can be read straight from the mapping,
+//! without any parsing. The rest of the problem (problem.json, and the .csp files of the action schemas) is
+//! still parsed as usual. The image is a single, versioned file in the data directory; when some data file is
+//! missing from it, or is newer than its copy in the image, the file is parsed as usual and its rows
+//! are recorded, and a fresh image with all data files is exported once the problem has been loaded.
+//! As the rows are stored as already-resolved objects, the whole image is discarded if problem.json
+//! (where the objects and types of the problem are declared) differs from the one it was exported with.
+//!
+//! The layout of the image, in 32-bit words, is:
+//!   - A header: magic number, format version, number of entries, a 64-bit checksum of the rest of the image,
+//!     and a 64-bit hash of the problem.json file it was exported with.
+//!   - A directory with one record per data file: offset and size (in bytes) of its name, size and
+//!     modification time (in ns.) of the file when it was recorded, number of rows, a reserved word,
+//!     and offset of its data.
+//!   - The names and the data of all files. The data of a file is made up of one record per row, with the
+//!     number of objects in the row followed by the <type, value> pairs of its objects.
+class ProblemImage {
+public:
+	using RowInserter = std::function<void (std::vector<object_id>&&)>;
+
+	static const uint32_t VERSION = 2;
+
+	//! Set up the global image for the problem data in the given directory, mapping the existing image, if any and valid.
+	static void init(const std::string& data_dir);
+
+	//! The global image, or nullptr if none has been set up, in which case data files are always parsed
+	static ProblemImage* current() { return _instance.get(); }
+
+	//! If the image has an up-to-date copy of the given data file, feed all of its rows to the inserter and return true.
+	bool read(const std::string& filename, const RowInserter& inserter) const;
+
+	//! Record the rows of the given data file, which has just been parsed, for the next export
+	void record(const std::string& filename, const std::vector<std::vector<object_id>>& rows);
+
+	//! Write a new image with all data files read or recorded so far, if any of them was not in the current image.
+	//! Failures to write the image are reported, but not fatal.
+	void export_if_outdated() const;
+
+protected:
+	ProblemImage(std::string path, uint64_t problem_hash);
+
+	static std::unique_ptr<ProblemImage> _instance;
+
+	//! The signature of a data file, used to tell whether its copy in the image is up to date
+	struct SignatureT {
+		uint64_t size;
+		uint64_t mtime;
+		bool operator==(const SignatureT& other) const { return size == other.size && mtime == other.mtime; }
+	};
+	static bool signature(const std::string& filename, SignatureT& sig);
+
+	struct EntryT {
+		SignatureT signature;
+		uint32_t num_rows;
+		const uint32_t* data; // Pointer into the mapping
+	};
+
+	//! A data file parsed in this run
+	struct RecordedT {
+		SignatureT signature;
+		std::vector<std::vector<object_id>> rows;
+	};
+
+	//! The path of the image
+	const std::string _path;
+
+	//! The hash of the problem.json file of the problem
+	const uint64_t _problem_hash;
+
+	std::unique_ptr<MappedFile> _mapping;
+
+	//! The entries of the mapped image, indexed by file name
+	std::unordered_map<std::string, EntryT> _entries;
+
+	//! The data files parsed in this run, indexed by file name
+	std::unordered_map<std::string, RecordedT> _recorded;
+
+	//! Map the image, and index its entries, if it is valid
+	void map();
+
+	static std::string key(const std::string& filename);
+};
+
+} // namespaces
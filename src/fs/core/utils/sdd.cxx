@@ -4,7 +4,9 @@
 #include <fs/core/utils/sdd.hxx>
 #include <fs/core/utils/lexical_cast.hxx>
 #include <fs/core/state.hxx>
+#include <fs/core/utils/mapped_file.hxx>
 #include <fs/core/utils/system.hxx>
+#include <fs/core/utils/thread_pool.hxx>
 #include <lapkt/tools/logging.hxx>
 
 #include <lapkt/tools/resources_control.hxx>
@@ -17,15 +19,26 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/format.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <fs/core/utils/config.hxx>
 
+
 namespace fsys = boost::filesystem;
 using boost::format;
 
 namespace fs0 {
 
+//! The SDD library is not documented to be thread-safe, even across different managers, so that schema SDDs loaded
+//! concurrently only make their calls to it while holding this lock; the rest of the loading runs in parallel.
+static std::mutex sdd_library_mutex;
+
 unsigned varid(SddLiteral literal) {
     if (literal == 0) throw std::runtime_error("Given literal has value 0");
     return literal < 0 ? -1 * literal : literal;  // i.e. the absolute value
@@ -36,104 +49,341 @@ SDDModel::value_t truth_value(SddNode* node) {
     return sdd_node_literal(node) < 0 ? SDDModel::value_t::False : SDDModel::value_t::True;
 }
 
-//! Loads from disk all SDDs in the given directory (one per action schema)
-std::vector<std::shared_ptr<ActionSchemaSDD>>
-load_sdds_from_disk(const std::vector<const PartiallyGroundedAction*>& schemas, const std::string& dir) {
-    const ProblemInfo& info = ProblemInfo::getInstance();
-    const Config& config = Config::instance();
+using RelevantAtomsT = std::vector<std::pair<VariableIdx, unsigned>>;
+using BindingsT = std::vector<std::vector<std::pair<object_id, unsigned>>>;
 
-    std::vector<std::shared_ptr<ActionSchemaSDD>> sdds;
-
-    fsys::path path(dir);
-    if (!fsys::exists(path)) throw std::runtime_error("Non-existing base SDD directory: " + dir);
+static RelevantAtomsT parse_relevant_atoms(const fsys::path& path, const ProblemInfo& info) {
+    RelevantAtomsT relevant;
+    std::ifstream is(path.string());
+    if (is.fail()) {
+        throw std::runtime_error("Could not open filename '" + path.string() + "'");
+    }
+    std::string line;
+    while (std::getline(is, line)) {
+        // each line is of the form "holding,c:5"
+        std::vector<std::string> strings;
+        boost::split(strings, line, boost::is_any_of(":"));
+        assert(strings.size() == 2);
+        auto sdd_varid = boost::lexical_cast<unsigned>(strings[1]);
+
+        boost::split(strings, strings[0], boost::is_any_of(","));
+        assert(!strings.empty()); // We'll have at least the id of the symbol
+        auto symbol_id = info.getSymbolId(strings[0]);
+
+        std::vector<object_id> constant_values;
+        // Iterate but skipping first one
+        for (std::size_t i = 1; i < strings.size(); ++i) constant_values.emplace_back(info.get_object_id(strings[i]));
+        VariableIdx varid = info.resolveStateVariable(symbol_id, constant_values);
+
+        relevant.emplace_back(varid, sdd_varid);
+    }
+    return relevant;
+}
 
-    for (const auto& schema:schemas) {
-        // Each action schema has a number of filenames starting with the name of the schema
-        const std::string& schema_name = schema->getName();
-        std::string mng_fname = str(format("%1%.manager.sdd") % schema_name);
-        std::string vtree_fname = str(format("%1%.vtree.sdd") % schema_name);
-        std::string atoms_fname = str(format("%1%.atoms.data") % schema_name);
-        std::string bindings_fname = str(format("%1%.bindings.data") % schema_name);
-
-        // Load vtree and manager
-        LPT_DEBUG("cout", "Loading SDD and bookkeeping info corresponding to action \"" << schema_name << "\"");
-        LPT_DEBUG("cout", "Mem. usage: " << get_current_memory_in_kb() << "kB. (peak: " << get_peak_memory_in_kb() << " kB.)");
-        fsys::path vtree_path = dir / fsys::path(vtree_fname);
-        Vtree* vtree = sdd_vtree_read(vtree_path.string().c_str());
-        SddManager* manager = sdd_manager_new(vtree);
-
-        fsys::path manager_path = dir / fsys::path(mng_fname);
-        SddNode* node = sdd_read(manager_path.string().c_str(), manager);
-        LPT_DEBUG("cout", "Done. SDD Size: " << sdd_size(node));
+static BindingsT parse_bindings(const fsys::path& path, const ProblemInfo& info) {
+    BindingsT bindings;
+    std::ifstream is(path.string());
+    if (is.fail()) {
+        throw std::runtime_error("Could not open filename '" + path.string() + "'");
+    }
 
-        if (sdd_node_is_false(node)) {
-            std::cout << "Action " << schema_name << " has no applicable binding and will be ignored." << std::endl;
-            continue;
+    std::string line;
+    while (std::getline(is, line)) {
+        // i-th line is of the form "b:1,d:2,a:3,c:4" and corresponds to the bindings of parameter i of the schema
+        std::vector<std::string> strings;
+        boost::split(strings, line, boost::is_any_of(","));
+
+        std::vector<std::pair<object_id, unsigned>> param_bindings;
+        for (const auto& str:strings) {
+            std::vector<std::string> substrings;
+            boost::split(substrings, str, boost::is_any_of(":"));
+            assert(substrings.size() == 2);
+            const object_id& oid = info.get_object_id(substrings[0]);
+            param_bindings.emplace_back(oid, boost::lexical_cast<unsigned>(substrings[1]));
         }
 
-        // Load bookkeeping info for the schema
-        std::vector<std::pair<VariableIdx, unsigned>> relevant;
+        bindings.push_back(std::move(param_bindings));
+    }
+    return bindings;
+}
+
 
-        fsys::path atoms_path = dir / fsys::path(atoms_fname);
-        std::ifstream is(atoms_path.string());
-        if (is.fail()) {
-            throw std::runtime_error("Could not open filename '" + atoms_fname + "'");
-        }
-        std::string line;
-        while (std::getline(is, line)) {
-            // each line is of the form "holding,c:5"
-            std::vector<std::string> strings;
-            boost::split(strings, line, boost::is_any_of(":"));
-            assert(strings.size() == 2);
-            auto sdd_varid = boost::lexical_cast<unsigned>(strings[1]);
-
-            boost::split(strings, strings[0], boost::is_any_of(","));
-            assert(!strings.empty()); // We'll have at least the id of the symbol
-            auto symbol_id = info.getSymbolId(strings[0]);
-
-            std::vector<object_id> constant_values;
-            // Iterate but skipping first one
-            for (std::size_t i = 1; i < strings.size(); ++i) constant_values.emplace_back(info.get_object_id(strings[i]));
-            VariableIdx varid = info.resolveStateVariable(symbol_id, constant_values);
-
-            relevant.emplace_back(varid, sdd_varid);
-        }
+//! The binary cache of the bookkeeping data of a (minimized) schema SDD, made up of 32-bit words:
+//! a header with a magic number, the format version, the (64-bit) key of the cache entry and a checksum of
+//! the payload, followed by the payload: the (64-bit) hashes of the cached vtree and SDD files, the number of relevant
+//! atoms and their <variable, SDD id> pairs, then the number of parameters and, for each of them, the number of bindings
+//! and their <type, value, SDD id> triplets.
+//! The SDD and its vtree are cached next to it, in the format of the SDD library, after having been minimized.
+//! All files are written under temporary names and then renamed, and the bookkeeping file goes last, so that an entry
+//! is only valid once all of its files are complete; the hashes guard against SDD files from some other entry.
+namespace sdd_cache {
+
+static const uint32_t MAGIC = 0x44445346; // "FSDD"
+static const uint32_t VERSION = 2;
+static const std::size_t HEADER_WORDS = 6;
+
+static std::string entry_name(const std::string& schema_name, uint64_t key, const std::string& suffix) {
+    return str(format("%1%.%2$016x.%3%") % schema_name % key % suffix);
+}
 
-        std::vector<std::vector<std::pair<object_id, unsigned>>> bindings;
-        is = std::ifstream((dir / fsys::path(bindings_fname)).string());
-        if (is.fail()) {
-            throw std::runtime_error("Could not open filename '" + bindings_fname + "'");
+//! Load the bookkeeping data of the given entry, and return false if there is no valid entry with the given key
+static bool read(const fsys::path& filename, uint64_t key, uint64_t& vtree_hash, uint64_t& sdd_hash, RelevantAtomsT& relevant, BindingsT& bindings) {
+    MappedFile file(filename.string());
+    const uint32_t* w = file.words();
+    const std::size_t n = file.num_words();
+    if (!w || n < HEADER_WORDS + 2) return false;
+    if (w[0] != MAGIC || w[1] != VERSION || w[2] != uint32_t(key) || w[3] != uint32_t(key >> 32)) return false;
+
+    uint64_t checksum = hash_bytes(reinterpret_cast<const char*>(w + HEADER_WORDS), (n - HEADER_WORDS) * sizeof(uint32_t), FNV_SEED);
+    if (w[4] != uint32_t(checksum) || w[5] != uint32_t(checksum >> 32)) return false;
+
+    std::size_t i = HEADER_WORDS;
+    auto fetch = [&](std::size_t count) { // Bounds check on 'count' more words
+        if (i + count > n) throw std::runtime_error("Truncated SDD cache file " + filename.string());
+    };
+
+    fetch(4);
+    vtree_hash = uint64_t(w[i]) | (uint64_t(w[i+1]) << 32);
+    sdd_hash = uint64_t(w[i+2]) | (uint64_t(w[i+3]) << 32);
+    i += 4;
+
+    fetch(1);
+    uint32_t n_relevant = w[i++];
+    fetch(2 * std::size_t(n_relevant));
+    relevant.reserve(n_relevant);
+    for (uint32_t k = 0; k < n_relevant; ++k, i += 2) relevant.emplace_back(w[i], w[i+1]);
+
+    fetch(1);
+    uint32_t n_params = w[i++];
+    bindings.resize(n_params);
+    for (uint32_t p = 0; p < n_params; ++p) {
+        fetch(1);
+        uint32_t n_bindings = w[i++];
+        fetch(3 * std::size_t(n_bindings));
+        bindings[p].reserve(n_bindings);
+        for (uint32_t k = 0; k < n_bindings; ++k, i += 3) {
+            bindings[p].emplace_back(make_object(static_cast<type_id>(w[i]), w[i+1]), w[i+2]);
         }
+    }
+    return i == n;
+}
 
-        while (std::getline(is, line)) {
-            // i-th line is of the form "b:1,d:2,a:3,c:4" and corresponds to the bindings of parameter i of the schema
-            std::vector<std::string> strings;
-            boost::split(strings, line, boost::is_any_of(","));
-
-            std::vector<std::pair<object_id, unsigned>> param_bindings;
-            for (const auto& str:strings) {
-                std::vector<std::string> substrings;
-                boost::split(substrings, str, boost::is_any_of(":"));
-                assert(substrings.size() == 2);
-                const object_id& oid = info.get_object_id(substrings[0]);
-                param_bindings.emplace_back(oid, boost::lexical_cast<unsigned>(substrings[1]));
-            }
+//! A unique temporary name for the given file, in the same directory
+static fsys::path temporary(const fsys::path& filename) {
+    fsys::path tmp = filename;
+    tmp += fsys::unique_path(".%%%%%%%%.tmp");
+    return tmp;
+}
+
+//! Rename the given temporary file into its final name, and return false (removing it) on failure
+static bool commit(const fsys::path& tmp, const fsys::path& filename) {
+    boost::system::error_code ec;
+    fsys::rename(tmp, filename, ec);
+    if (ec) fsys::remove(tmp, ec);
+    return !ec;
+}
 
-            bindings.push_back(std::move(param_bindings));
+//! Return whether the given file exists and is not empty; the SDD library reports no errors when saving files
+static bool written(const fsys::path& filename) {
+    boost::system::error_code ec;
+    auto size = fsys::file_size(filename, ec);
+    return !ec && size > 0;
+}
+
+//! Write the given bookkeeping data through a temporary file, so that concurrent runs never see a partial entry.
+//! Return false if the file could not be written.
+static bool write(const fsys::path& filename, uint64_t key, uint64_t vtree_hash, uint64_t sdd_hash,
+                  const RelevantAtomsT& relevant, const BindingsT& bindings) {
+    std::vector<uint32_t> w(HEADER_WORDS, 0);
+    w.push_back(uint32_t(vtree_hash));
+    w.push_back(uint32_t(vtree_hash >> 32));
+    w.push_back(uint32_t(sdd_hash));
+    w.push_back(uint32_t(sdd_hash >> 32));
+    w.push_back((uint32_t) relevant.size());
+    for (const auto& elem:relevant) {
+        w.push_back(elem.first);
+        w.push_back(elem.second);
+    }
+    w.push_back((uint32_t) bindings.size());
+    for (const auto& param_bindings:bindings) {
+        w.push_back((uint32_t) param_bindings.size());
+        for (const auto& elem:param_bindings) {
+            w.push_back(static_cast<uint32_t>(elem.first.type()));
+            w.push_back(elem.first.value());
+            w.push_back(elem.second);
         }
+    }
+
+    uint64_t checksum = hash_bytes(reinterpret_cast<const char*>(w.data() + HEADER_WORDS), (w.size() - HEADER_WORDS) * sizeof(uint32_t), FNV_SEED);
+    w[0] = MAGIC;
+    w[1] = VERSION;
+    w[2] = uint32_t(key);
+    w[3] = uint32_t(key >> 32);
+    w[4] = uint32_t(checksum);
+    w[5] = uint32_t(checksum >> 32);
+
+    fsys::path tmp = temporary(filename);
+    std::ofstream os(tmp.string(), std::ios::binary);
+    os.write(reinterpret_cast<const char*>(w.data()), w.size() * sizeof(uint32_t));
+    os.close();
+    if (os.fail()) {
+        boost::system::error_code ec;
+        fsys::remove(tmp, ec);
+        return false;
+    }
+    return commit(tmp, filename);
+}
+
+//! Save the given (minimized) SDD and its vtree into the cache, plus the bookkeeping file that makes the entry valid.
+//! Return false if some file could not be written.
+static bool save(const fsys::path& meta, const fsys::path& vtree, const fsys::path& sdd, uint64_t key,
+                 SddManager* manager, SddNode* node, const RelevantAtomsT& relevant, const BindingsT& bindings) {
+    fsys::path vtree_tmp = temporary(vtree), sdd_tmp = temporary(sdd);
+    {
+        std::lock_guard<std::mutex> lock(sdd_library_mutex);
+        sdd_vtree_save(vtree_tmp.string().c_str(), sdd_manager_vtree(manager));
+        sdd_save(sdd_tmp.string().c_str(), node);
+    }
+
+    bool ok = written(vtree_tmp) && written(sdd_tmp);
+    uint64_t vtree_hash = ok ? hash_file(vtree_tmp.string()) : 0;
+    uint64_t sdd_hash = ok ? hash_file(sdd_tmp.string()) : 0;
+    ok = ok && commit(vtree_tmp, vtree) && commit(sdd_tmp, sdd);
+    if (!ok) {
+        boost::system::error_code ec;
+        fsys::remove(vtree_tmp, ec);
+        fsys::remove(sdd_tmp, ec);
+        return false;
+    }
+    return write(meta, key, vtree_hash, sdd_hash, relevant, bindings);
+}
 
-        auto minimization_time = config.getOption<unsigned>("sdd.minimization_time", 10);
-        if (minimization_time > 0) {
-            ActionSchemaSDD::minimize_sdd(manager, node, minimization_time);
-            // For debugging purposes:
-            // std::cout << "Printing SDD to " << str(format("/home/gfrances/tmp/vtrees/%1%.sdd.dot") % schema_name) << std::endl;
-            // sdd_save_as_dot(str(format("/home/gfrances/tmp/vtrees/%1%.sdd.dot") % schema_name).c_str(), node);
-            // sdd_vtree_save_as_dot(str(format("/home/gfrances/tmp/vtrees/%1%.vtree.dot") % schema_name).c_str(), sdd_manager_vtree(manager));
+} // namespace sdd_cache
+
+
+//! Load the SDD of the given schema, from the cache if possible, and return nullptr if the SDD is unsatisfiable.
+//! 'problem_key' is a hash of everything (beyond the SDD files of the schema) the cache entry depends on.
+static std::shared_ptr<ActionSchemaSDD>
+load_schema_sdd(const PartiallyGroundedAction& schema, const fsys::path& dir, const fsys::path& cache_dir,
+                uint64_t problem_key, unsigned minimization_time) {
+    const ProblemInfo& info = ProblemInfo::getInstance();
+
+    // Each action schema has a number of filenames starting with the name of the schema
+    const std::string& schema_name = schema.getName();
+    fsys::path manager_path = dir / fsys::path(str(format("%1%.manager.sdd") % schema_name));
+    fsys::path vtree_path = dir / fsys::path(str(format("%1%.vtree.sdd") % schema_name));
+    fsys::path atoms_path = dir / fsys::path(str(format("%1%.atoms.data") % schema_name));
+    fsys::path bindings_path = dir / fsys::path(str(format("%1%.bindings.data") % schema_name));
+
+    LPT_DEBUG("cout", "Loading SDD and bookkeeping info corresponding to action \"" << schema_name << "\"");
+
+    // The cache entry is keyed on the contents of all of the (original) files of the schema
+    uint64_t key = problem_key;
+    for (const auto& path:{manager_path, vtree_path, atoms_path, bindings_path}) key = hash_file(path.string(), key);
+
+    fsys::path cached_meta, cached_vtree, cached_manager;
+    if (!cache_dir.empty()) {
+        cached_meta = cache_dir / sdd_cache::entry_name(schema_name, key, "meta.bin");
+        cached_vtree = cache_dir / sdd_cache::entry_name(schema_name, key, "vtree.sdd");
+        cached_manager = cache_dir / sdd_cache::entry_name(schema_name, key, "manager.sdd");
+
+        RelevantAtomsT relevant;
+        BindingsT bindings;
+        uint64_t vtree_hash, sdd_hash;
+        // Check that the SDD files are those the entry was written with before handing them to the SDD library
+        if (sdd_cache::read(cached_meta, key, vtree_hash, sdd_hash, relevant, bindings)
+            && hash_file(cached_vtree.string()) == vtree_hash && hash_file(cached_manager.string()) == sdd_hash) {
+            LPT_INFO("cout", "Loading precompiled SDD of action \"" << schema_name << "\" from cache");
+            std::lock_guard<std::mutex> lock(sdd_library_mutex);
+            Vtree* vtree = sdd_vtree_read(cached_vtree.string().c_str());
+            SddManager* manager = sdd_manager_new(vtree);
+            SddNode* node = sdd_read(cached_manager.string().c_str(), manager);
+            if (sdd_node_is_false(node)) return nullptr;
+            return std::make_shared<ActionSchemaSDD>(schema, std::move(relevant), std::move(bindings), manager, vtree, node);
         }
+    }
+
+    // Load vtree and manager
+    Vtree* vtree;
+    SddManager* manager;
+    SddNode* node;
+    {
+        std::lock_guard<std::mutex> lock(sdd_library_mutex);
+        vtree = sdd_vtree_read(vtree_path.string().c_str());
+        manager = sdd_manager_new(vtree);
+        node = sdd_read(manager_path.string().c_str(), manager);
+        LPT_DEBUG("cout", "Done. SDD Size: " << sdd_size(node));
+        if (sdd_node_is_false(node)) return nullptr;
+    }
 
-        sdds.push_back(std::make_shared<ActionSchemaSDD>(*schema, relevant, bindings, manager, vtree, node));
+    // Load bookkeeping info for the schema
+    RelevantAtomsT relevant = parse_relevant_atoms(atoms_path, info);
+    BindingsT bindings = parse_bindings(bindings_path, info);
+
+    if (minimization_time > 0) {
+        std::lock_guard<std::mutex> lock(sdd_library_mutex);
+        ActionSchemaSDD::minimize_sdd(manager, node, minimization_time);
+        // For debugging purposes:
+        // std::cout << "Printing SDD to " << str(format("/home/gfrances/tmp/vtrees/%1%.sdd.dot") % schema_name) << std::endl;
+        // sdd_save_as_dot(str(format("/home/gfrances/tmp/vtrees/%1%.sdd.dot") % schema_name).c_str(), node);
+        // sdd_vtree_save_as_dot(str(format("/home/gfrances/tmp/vtrees/%1%.vtree.dot") % schema_name).c_str(), sdd_manager_vtree(manager));
     }
 
+    if (!cache_dir.empty() && !sdd_cache::save(cached_meta, cached_vtree, cached_manager, key, manager, node, relevant, bindings)) {
+        LPT_INFO("cout", "WARNING: Could not cache the SDD of action \"" << schema_name << "\"");
+    }
+
+    return std::make_shared<ActionSchemaSDD>(schema, std::move(relevant), std::move(bindings), manager, vtree, node);
+}
+
+//! Loads from disk all SDDs in the given directory (one per action schema)
+std::vector<std::shared_ptr<ActionSchemaSDD>>
+load_sdds_from_disk(const std::vector<const PartiallyGroundedAction*>& schemas, const std::string& dir) {
+    const ProblemInfo& info = ProblemInfo::getInstance();
+    const Config& config = Config::instance();
+
+    fsys::path path(dir);
+    if (!fsys::exists(path)) throw std::runtime_error("Non-existing base SDD directory: " + dir);
+
+    auto minimization_time = config.getOption<unsigned>("sdd.minimization_time", 10);
+
+    // Cache entries depend on the problem (e.g. the indexes of state variables) and on the minimization time
+    fsys::path cache_dir;
+    if (config.getOption<bool>("sdd.cache", true)) {
+        cache_dir = config.getOption<std::string>("sdd.cache_dir", (path / "cache").string());
+        boost::system::error_code ec;
+        fsys::create_directories(cache_dir, ec);
+        if (ec) {
+            LPT_INFO("cout", "WARNING: Could not create SDD cache directory " << cache_dir << ", SDDs won't be cached");
+            cache_dir.clear();
+        }
+    }
+    uint64_t problem_key = hash_file(info.getDataDir() + "/problem.json");
+    problem_key = hash_bytes(reinterpret_cast<const char*>(&minimization_time), sizeof(minimization_time), problem_key);
+
+    LPT_DEBUG("cout", "Mem. usage: " << get_current_memory_in_kb() << "kB. (peak: " << get_peak_memory_in_kb() << " kB.)");
+
+    // Each schema has its own SDD manager, hence schemas can be loaded independently. Hashing the files and parsing
+    // the bookkeeping data runs in parallel, while the calls to the SDD library (reading, minimizing and saving SDDs)
+    // are serialized through 'sdd_library_mutex'.
+    unsigned num_threads = config.getOption<unsigned>("sdd.loading_threads", 0);
+    if (num_threads == 0) num_threads = std::max(1u, std::thread::hardware_concurrency());
+    num_threads = (unsigned) std::max<std::size_t>(1, std::min<std::size_t>(num_threads, schemas.size()));
+
+    std::vector<std::shared_ptr<ActionSchemaSDD>> loaded(schemas.size());
+    ThreadPool pool(num_threads);
+    pool.parallel_for(schemas.size(), [&](std::size_t i, unsigned) {
+        loaded[i] = load_schema_sdd(*schemas[i], path, cache_dir, problem_key, minimization_time);
+    });
+
+    std::vector<std::shared_ptr<ActionSchemaSDD>> sdds;
+    for (std::size_t i = 0; i < schemas.size(); ++i) {
+        if (!loaded[i]) {
+            std::cout << "Action " << schemas[i]->getName() << " has no applicable binding and will be ignored." << std::endl;
+            continue;
+        }
+        sdds.push_back(std::move(loaded[i]));
+    }
 
     LPT_DEBUG("cout", "Mem. usage: " << get_current_memory_in_kb() << "kB. (peak: " << get_peak_memory_in_kb() << " kB.)");
 
@@ -167,8 +417,12 @@ ActionSchemaSDD::ActionSchemaSDD(const PartiallyGroundedAction& schema,
         std::vector<std::pair<VariableIdx, unsigned>> relevant,
         std::vector<std::vector<std::pair<object_id, unsigned>>> bindings,
         SddManager *manager, Vtree *vtree, SddNode *sddnode)
-        : schema_(schema), sddmanager_(manager), vtree_(vtree), sddnode_(sddnode), relevant_(std::move(relevant)), bindings_(std::move(bindings))
+        : schema_(schema), sddmanager_(manager), vtree_(vtree), sddnode_(sddnode), relevant_(std::move(relevant)), bindings_(std::move(bindings)),
+          block_size_(Config::instance().getOption<unsigned>("sdd.conditioning_block", 0))
 {
+    // By default, blocks of about sqrt(n) atoms balance the number of partial conditionings kept with
+    // the number of atoms that need to be conditioned on again when some atom changes
+    if (block_size_ == 0) block_size_ = std::max<std::size_t>(1, (std::size_t) std::sqrt((double) relevant_.size()));
 }
 
 ActionSchemaSDD::~ActionSchemaSDD() {
@@ -202,6 +456,74 @@ SddNode* ActionSchemaSDD::conjoin_with(const State &state) const {
 }
 
 
+SDDConditioning::~SDDConditioning() {
+    if (auto schema = schema_.lock()) schema->release(*this);
+}
+
+void ActionSchemaSDD::release(SDDConditioning& conditioning) {
+    for (std::size_t k = 1; k < conditioning.nodes_.size(); ++k) {
+        if (conditioning.nodes_[k]) sdd_deref(conditioning.nodes_[k], sddmanager_);
+    }
+    conditioning.nodes_.clear();
+    conditioning.values_.clear();
+    conditioning.schema_.reset();
+}
+
+SddNode* ActionSchemaSDD::condition_on(const State& state, SDDConditioning& conditioning) {
+    const std::size_t n = relevant_.size();
+    const std::size_t nblocks = (n + block_size_ - 1) / block_size_;
+    auto& nodes = conditioning.nodes_;
+    auto& values = conditioning.values_;
+
+    // A conditioning left by some other schema, e.g. of a previous model, is dropped
+    auto owner = conditioning.schema_.lock();
+    if (owner.get() != this) {
+        if (owner) owner->release(conditioning);
+        nodes.clear();
+        values.clear();
+        conditioning.schema_ = shared_from_this();
+    }
+
+    // Find the first atom whose value differs from that in the last conditioned state
+    std::size_t first_changed = 0;
+    if (nodes.empty()) {
+        nodes.assign(nblocks + 1, nullptr);
+        nodes[0] = sddnode_;
+        values.resize(n);
+        for (std::size_t i = 0; i < n; ++i) values[i] = (bool) state.getValue(relevant_[i].first);
+
+    } else {
+        first_changed = n;
+        for (std::size_t i = 0; i < n; ++i) {
+            bool value = (bool) state.getValue(relevant_[i].first);
+            if (value != values[i]) {
+                if (first_changed == n) first_changed = i;
+                values[i] = value;
+            }
+        }
+        if (first_changed == n) return nodes.back(); // Same relevant atoms as in the last state
+    }
+
+    for (std::size_t k = first_changed / block_size_; k < nblocks; ++k) {
+        SddNode* current = nodes[k];
+        for (std::size_t i = k * block_size_, end = std::min(n, (k + 1) * block_size_); i < end; ++i) {
+            if (sdd_node_is_false(current)) break;
+            auto literal = (SddLiteral) relevant_[i].second;
+            current = sdd_condition(values[i] ? literal : -literal, current, sddmanager_);
+        }
+        sdd_ref(current, sddmanager_);
+        if (nodes[k+1]) sdd_deref(nodes[k+1], sddmanager_);
+        nodes[k+1] = current;
+    }
+
+    // Conditionings that are no longer kept become dead nodes, which we collect now and then
+    sdd_ref(sddnode_, sddmanager_);
+    sdd_manager_garbage_collect_if(0.5, sddmanager_);
+    sdd_deref(sddnode_, sddmanager_);
+
+    return nodes.back();
+}
+
 SDDModel ActionSchemaSDD::collect_state_literals(const State &state) const {
     SDDModel literals(var_count()+1);
 
@@ -467,9 +789,9 @@ RecursiveModelEnumerator::models_with_cache(SddNode* node, Vtree* vtree) {
     }
 }
 
-std::vector<SDDModel> RecursiveModelEnumerator::models(SddNode* node) {
+std::vector<SDDModel> RecursiveModelEnumerator::models(SddNode* node, bool full_vtree) {
     if (sdd_node_is_false(node)) throw std::runtime_error("False SDD has no models");
-    auto vtree = sdd_node_is_true(node) ? sdd_manager_vtree(sddmanager_) : sdd_vtree_of(node);
+    auto vtree = (full_vtree || sdd_node_is_true(node)) ? sdd_manager_vtree(sddmanager_) : sdd_vtree_of(node);
     auto selected = models(node, vtree);
 //    std::cout << "SDD (" << sdd_size(node) << " nodes) has " << selected.size() << " models. Cache hits: " << cache_hits_ << "/" << computed_nodes_ << std::endl;
 //    std::cout << "A total of " << model_register_.size() << " models were computed, of which " << selected.size()
@@ -1,8 +1,10 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include <boost/serialization/vector.hpp>
 
 #include <fs/core/fs_types.hxx>
@@ -47,7 +49,34 @@ protected:
     std::vector<value_t> values_;
 };
 
-class ActionSchemaSDD {
+class ActionSchemaSDD;
+
+//! The partial conditionings of an action-schema SDD on the last state seen through some expansion context, see
+//! ActionSchemaSDD::condition_on. The conditioned nodes are referenced in the manager of the schema, and are
+//! dereferenced when the conditioning goes away, unless the schema has gone away first.
+class SDDConditioning {
+    friend class ActionSchemaSDD;
+public:
+    SDDConditioning() = default;
+    ~SDDConditioning();
+
+    SDDConditioning(const SDDConditioning&) = delete;
+    SDDConditioning& operator=(const SDDConditioning&) = delete;
+    SDDConditioning(SDDConditioning&&) = default;
+    SDDConditioning& operator=(SDDConditioning&&) = delete;
+
+protected:
+    //! The schema whose SDD has been conditioned
+    std::weak_ptr<ActionSchemaSDD> schema_;
+
+    //! 'nodes_[k]' is the SDD conditioned on the first 'k' blocks of relevant atoms, with their values in the last
+    //! conditioned state, which are kept in 'values_'. All of them but 'nodes_[0]', which is the unconditioned SDD,
+    //! are referenced, so that they survive garbage collections.
+    std::vector<SddNode*> nodes_;
+    std::vector<bool> values_;
+};
+
+class ActionSchemaSDD : public std::enable_shared_from_this<ActionSchemaSDD> {
 public:
     ActionSchemaSDD(const PartiallyGroundedAction& schema,
             std::vector<std::pair<VariableIdx, unsigned>> relevant,
@@ -56,6 +85,17 @@ public:
     ~ActionSchemaSDD();
 
     SddNode* conjoin_with(const State& state) const;
+
+    //! Return the schema SDD conditioned on the values that all relevant atoms take in the given state.
+    //! The relevant atoms are conditioned on in blocks, and the partial conditionings on the first k blocks of
+    //! the last state are kept in 'conditioning', so that a state that differs from the last one only in a few atoms
+    //! (e.g. its parent or a sibling) only needs to redo the conditionings from the first block with some changed atom on.
+    //! The returned node is owned by 'conditioning', and is valid until the next call with it.
+    SddNode* condition_on(const State& state, SDDConditioning& conditioning);
+
+    //! Dereference the nodes of the given conditioning, which must be one of this schema
+    void release(SDDConditioning& conditioning);
+
     unsigned var_count() const;
 
     SDDModel collect_state_literals(const State &state) const;
@@ -93,6 +133,9 @@ protected:
 
     //! 'bindings_[i]' contains the object_id corresponding
     std::vector<std::vector<std::pair<object_id, unsigned>>> bindings_;
+
+    //! The number of relevant atoms conditioned on in each block
+    std::size_t block_size_;
 };
 
 
@@ -104,7 +147,10 @@ public:
     RecursiveModelEnumerator(SddManager* manager, SDDModel&& fixed);
     virtual ~RecursiveModelEnumerator() = default;
 
-    std::vector<SDDModel> models(SddNode* node);
+    //! Return all models of the given node. If 'full_vtree' is true, models are enumerated over the whole vtree
+    //! of the manager, rather than over the vtree of the node only, which is necessary e.g. for conditioned nodes,
+    //! whose vtree might no longer cover all variables that are not fixed.
+    std::vector<SDDModel> models(SddNode* node, bool full_vtree = false);
     resultset_t models(SddNode* node, Vtree* vtree);
 
 
@@ -2,6 +2,7 @@
 #include <string>
 #include <fstream>
 #include <fs/core/utils/serializer.hxx>
+#include <fs/core/utils/problem_image.hxx>
 #include <fs/core/utils/serialize_tuple.hxx>
 #include <boost/algorithm/string.hpp>
 #include <fs/core/utils/lexical_cast.hxx>
@@ -50,11 +51,19 @@ Serializer::BinaryMap Serializer::bDeserializeBinaryMap(const std::string& filen
 */
 
 void Serializer::deserialize(const std::string& filename, DataInserter& inserter, const std::vector<type_id>& sym_signature_types) {
+	// Use the precompiled copy of the file, if there is an up-to-date one
+	ProblemImage* image = ProblemImage::current();
+	if (image && image->read(filename, inserter)) return;
+
+	std::vector<std::vector<object_id>> rows;
 	std::ifstream is(filename);
 	std::string line;
 	while (std::getline(is, line)) {
-		inserter(deserialize_line(line, sym_signature_types, ","));
+		auto row = deserialize_line(line, sym_signature_types, ",");
+		if (image) rows.push_back(row);
+		inserter(std::move(row));
 	}
+	if (image) image->record(filename, rows);
 }
 
 object_id Serializer::deserialize0AryElement(const std::string& filename, const std::vector<type_id>& sym_signature_types) {
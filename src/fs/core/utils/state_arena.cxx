@@ -0,0 +1,42 @@
+
+#include <algorithm>
+
+#include <fs/core/utils/state_arena.hxx>
+
+namespace fs0 {
+
+std::atomic<std::size_t> StateArena::_next_id(0);
+
+StateArena::StateArena(std::size_t block_words, std::size_t blocks_per_slab) :
+	_id(_next_id++),
+	// Each block needs to be able to hold at least the "next" pointer of the free list
+	_block_words(std::max<std::size_t>(block_words, 1)),
+	_blocks_per_slab(std::max<std::size_t>(blocks_per_slab, 1)),
+	_slabs_mutex(),
+	_slabs()
+{}
+
+void
+StateArena::refill(WordT*& head) {
+	WordT* slab = nullptr;
+	{
+		std::lock_guard<std::mutex> lock(_slabs_mutex);
+		_slabs.emplace_back(new WordT[_block_words * _blocks_per_slab]);
+		slab = _slabs.back().get();
+	}
+
+	// Thread the blocks of the new slab in front of the current free list
+	for (std::size_t i = 0; i < _blocks_per_slab; ++i) {
+		WordT* block = slab + i * _block_words;
+		*block = static_cast<WordT>(reinterpret_cast<std::uintptr_t>(head));
+		head = block;
+	}
+}
+
+std::size_t
+StateArena::reserved_bytes() const {
+	std::lock_guard<std::mutex> lock(_slabs_mutex);
+	return _slabs.size() * _blocks_per_slab * _block_words * sizeof(WordT);
+}
+
+} // namespaces
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace fs0 {
+
+//! A slab allocator for the fixed-size word buffers that back packed states.
+//! All the states of a given problem have exactly the same number of words, hence
+//! blocks can be recycled through a simple intrusive free list, and are carved out of large
+//! slabs so that generating a successor state costs no call to the general-purpose allocator.
+//! Free lists are kept per thread, so that states can be created and released concurrently;
+//! a block released by a thread other than the one that allocated it simply migrates to
+//! the free list of the releasing thread. Slabs are only returned when the arena is destroyed.
+class StateArena {
+public:
+	using WordT = uint64_t;
+
+	//! 'block_words' is the number of words of each block, i.e. of each state.
+	explicit StateArena(std::size_t block_words, std::size_t blocks_per_slab = 4096);
+	~StateArena() = default;
+
+	StateArena(const StateArena&) = delete;
+	StateArena(StateArena&&) = delete;
+	StateArena& operator=(const StateArena&) = delete;
+	StateArena& operator=(StateArena&&) = delete;
+
+	//! Return an (uninitialized) block of 'block_words()' words
+	WordT* allocate() {
+		WordT*& head = local_free_list();
+		if (!head) refill(head);
+		WordT* block = head;
+		head = reinterpret_cast<WordT*>(static_cast<std::uintptr_t>(*block));
+		return block;
+	}
+
+	//! Give back to the arena a block previously obtained through 'allocate()'
+	void release(WordT* block) {
+		WordT*& head = local_free_list();
+		*block = static_cast<WordT>(reinterpret_cast<std::uintptr_t>(head));
+		head = block;
+	}
+
+	std::size_t block_words() const { return _block_words; }
+
+	//! The total number of bytes reserved by the arena so far
+	std::size_t reserved_bytes() const;
+
+protected:
+	//! A unique ID for the arena, used to locate its thread-local free lists
+	const std::size_t _id;
+
+	const std::size_t _block_words;
+
+	const std::size_t _blocks_per_slab;
+
+	//! The slabs from which blocks are carved. Only accessed when some thread runs out of blocks.
+	mutable std::mutex _slabs_mutex;
+	std::vector<std::unique_ptr<WordT[]>> _slabs;
+
+	//! Return the head of the free list of blocks of this arena that belongs to the current thread.
+	//! Arena IDs are never reused, so stale entries left by destroyed arenas are never consulted again.
+	WordT*& local_free_list() {
+		thread_local std::vector<WordT*> heads;
+		if (_id >= heads.size()) heads.resize(_id + 1, nullptr);
+		return heads[_id];
+	}
+
+	//! Allocate a new slab and thread all of its blocks into the given free list
+	void refill(WordT*& head);
+
+	static std::atomic<std::size_t> _next_id;
+};
+
+} // namespaces
@@ -2,8 +2,10 @@
 #include "static.hxx"
 
 #include <fs/core/problem_info.hxx>
+#include <fs/core/utils/serializer.hxx>
 #include <lapkt/tools/logging.hxx>
 
+#include <fstream>
 #include <iostream>
 
 namespace fs0 {
@@ -13,6 +15,30 @@ std::ostream& operator<<( std::ostream& os, const StaticExtension& ex )
 	return ex.print(os, ProblemInfo::getInstance() );
 }
 
+static std::vector<object_id> _point(const object_id& x) { return {x}; }
+static std::vector<object_id> _point(const std::pair<object_id, object_id>& x) { return {x.first, x.second}; }
+static std::vector<object_id> _point(const std::tuple<object_id, object_id, object_id>& x) { return {std::get<0>(x), std::get<1>(x), std::get<2>(x)}; }
+static std::vector<object_id> _point(const std::vector<object_id>& x) { return x; }
+
+using ExtensionT = StaticTable::ExtensionT;
+
+//! Flatten the points of the given (flat) containers into the <point, value> pairs that StaticTables are built from
+template <typename MapT>
+static ExtensionT _map_extension(const MapT& data) {
+	ExtensionT extension;
+	extension.reserve(data.size());
+	for (const auto& entry:data) extension.emplace_back(_point(entry.first), entry.second);
+	return extension;
+}
+
+template <typename SetT>
+static ExtensionT _set_extension(const SetT& data) {
+	ExtensionT extension;
+	extension.reserve(data.size());
+	for (const auto& entry:data) extension.emplace_back(_point(entry), object_id::TRUE);
+	return extension;
+}
+
 std::unique_ptr<StaticExtension>
 StaticExtension::load_static_extension(const std::string& name, const ProblemInfo& info) {
 	unsigned id = info.getSymbolId(name);
@@ -26,160 +52,67 @@ StaticExtension::load_static_extension(const std::string& name, const ProblemInf
         sym_signature_types.push_back(info.get_type_id(data.getCodomainType()));
 	}
 	std::string filename = info.getDataDir() + "/" + name + ".data";
-	StaticExtension* extension = nullptr;
+	bool predicate = (type == SymbolData::Type::PREDICATE);
+	ExtensionT extension;
 
 	if (arity == 0) {
-		if ( type == SymbolData::Type::PREDICATE ) {
+		if (predicate) {
 			std::ifstream is(filename);
             // If the extension file does not exist, we assume the atom is a false nullary atom
             bool ext_file_exists = !is.fail();
-            extension = new ZeroaryFunction(make_object(ext_file_exists));
+            extension = {{{}, make_object(ext_file_exists)}};
 		}
 		else {
-			extension = new ZeroaryFunction(Serializer::deserialize0AryElement(filename, sym_signature_types));
+			extension = {{{}, Serializer::deserialize0AryElement(filename, sym_signature_types)}};
 		}
-
+		predicate = false; // Nullary symbols are tabulated as functions, so that they evaluate into their (only) value
 
 	} else if (arity == 1) {
-		if (type == SymbolData::Type::PREDICATE) extension = new UnaryPredicate(Serializer::deserializeUnarySet(filename, sym_signature_types));
-		else extension = new UnaryFunction(Serializer::deserializeUnaryMap(filename, sym_signature_types));
+		if (predicate) extension = _set_extension(Serializer::deserializeUnarySet(filename, sym_signature_types));
+		else extension = _map_extension(Serializer::deserializeUnaryMap(filename, sym_signature_types));
 
 	} else if (arity == 2) {
-		if (type == SymbolData::Type::PREDICATE) extension = new BinaryPredicate(Serializer::deserializeBinarySet(filename, sym_signature_types));
-		else extension = new BinaryFunction(Serializer::deserializeBinaryMap(filename, sym_signature_types));
+		if (predicate) extension = _set_extension(Serializer::deserializeBinarySet(filename, sym_signature_types));
+		else extension = _map_extension(Serializer::deserializeBinaryMap(filename, sym_signature_types));
 
 	} else if (arity == 3) {
-		if (type == SymbolData::Type::PREDICATE) extension = new Arity3Predicate(Serializer::deserializeArity3Set(filename, sym_signature_types));
-		else extension = new Arity3Function(Serializer::deserializeArity3Map(filename, sym_signature_types));
+		if (predicate) extension = _set_extension(Serializer::deserializeArity3Set(filename, sym_signature_types));
+		else extension = _map_extension(Serializer::deserializeArity3Map(filename, sym_signature_types));
 
 	} else {
-        if (type == SymbolData::Type::PREDICATE) extension = new ArbitraryArityPredicate(Serializer::deserializeSet(filename, sym_signature_types));
-        else extension = new ArbitraryArityFunction(Serializer::deserializeMap(filename, sym_signature_types));
-	}
-
-	LPT_DEBUG("loader", "Loaded extension for symbol '" << name << "'\n\t data: ");
-	extension->print(lapkt::tools::Logger::instance().log("DEBUG", "loader"), info) << std::endl;
-
-	return std::unique_ptr<StaticExtension>(extension);
-}
-
-std::ostream&
-ZeroaryFunction::print( std::ostream& os, const ProblemInfo& info ) const {
-	os << "[";
-	os << info.object_name(_data);
-	os << "]";
-
-	return os;
-}
-
-std::ostream&
-UnaryFunction::print( std::ostream& os, const ProblemInfo& info ) const {
-	os << "[";
-	for (const auto& entry : _data ) {
-		os << "( " << info.object_name(entry.first) << ", " << info.object_name(entry.second) << " ), ";
-	}
-	os << "]";
-
-	return os;
-}
-
-std::ostream&
-UnaryPredicate::print( std::ostream& os, const ProblemInfo& info ) const {
-	os << "[";
-	for (const auto& entry : _data ) {
-		os << "( " << info.object_name(entry) << " ), ";
-	}
-	os << "]";
-	return os;
-}
-
-std::ostream&
-BinaryFunction::print( std::ostream& os, const ProblemInfo& info ) const {
-	os << "[";
-	for (const auto& entry : _data ) {
-		os << "( ";
-		os << info.object_name(entry.first.first) << ", ";
-		os << info.object_name(entry.first.second) << ", ";
-		os << info.object_name(entry.second) << " ), ";
+        if (predicate) extension = _set_extension(Serializer::deserializeSet(filename, sym_signature_types));
+        else extension = _map_extension(Serializer::deserializeMap(filename, sym_signature_types));
 	}
-	os << "]";
-	return os;
-}
 
-std::ostream&
-BinaryPredicate::print( std::ostream& os, const ProblemInfo& info ) const {
-	os << "[";
-	for (const auto& entry : _data ) {
-		os << "( ";
-		os << info.object_name(entry.first) << ", ";
-		os << info.object_name(entry.second);
+	auto result = std::make_unique<StaticExtension>(StaticTable(arity, predicate, extension));
 
-		os << " ), ";
-	}
-	os << "]";
-	return os;
-}
-
-std::ostream&
-Arity3Function::print( std::ostream& os, const ProblemInfo& info ) const {
-	os << "[";
-	for (const auto& entry : _data ) {
-		os << "( ";
-		object_id x, y, z;
-		std::tie(x,y,z) = entry.first;
-		os << info.object_name(x) << ", ";
-		os << info.object_name(y) << ", ";
-		os << info.object_name(z) << ", ";
+#ifdef DEBUG
+	// Printing materializes the whole extension out of the table, hence only debug builds do it
+	LPT_DEBUG("loader", "Loaded extension for symbol '" << name << "'\n\t data: ");
+	result->print(lapkt::tools::Logger::instance().log("DEBUG", "loader"), info) << std::endl;
+#endif
 
-		os << info.object_name(entry.second) << " ), ";
-	}
-	os << "]";
-	return os;
+	return result;
 }
 
 std::ostream&
-Arity3Predicate::print( std::ostream& os, const ProblemInfo& info ) const {
+StaticExtension::print( std::ostream& os, const ProblemInfo& info ) const {
+	const unsigned arity = _table.arity();
+	const ExtensionT& extension = _table.extension();
 	os << "[";
-	for (const auto& entry : _data ) {
-		os << "( ";
-		object_id x, y, z;
-		std::tie(x,y,z) = entry;
-		os << info.object_name(x) << ", ";
-		os << info.object_name(y) << ", ";
-		os << info.object_name(z);
-
-		os << " ), ";
+	if (arity == 0) {
+		if (!extension.empty()) os << info.object_name(extension.front().second);
+		os << "]";
+		return os;
 	}
-	os << "]";
-	return os;
-}
 
-std::ostream&
-ArbitraryArityFunction::print( std::ostream& os, const ProblemInfo& info ) const {
-	os << "[";
-	for (const auto& e:_data) {
+	for (const auto& entry:extension) {
 		os << "( ";
-		auto sz = e.first.size();
-		for (unsigned i = 0; i < sz; ++i) {
-            os << info.object_name(e.first[i]);
-            if (i < sz-1) os << ", ";
+		for (unsigned i = 0; i < arity; ++i) {
+			os << info.object_name(entry.first[i]);
+			if (i < arity - 1) os << ", ";
 		}
-		os << info.object_name(e.second) << " ), ";
-	}
-	os << "]";
-	return os;
-}
-
-std::ostream&
-ArbitraryArityPredicate::print( std::ostream& os, const ProblemInfo& info ) const {
-	os << "[";
-	for (const auto& e:_data) {
-		os << "( ";
-        auto sz = e.size();
-        for (unsigned i = 0; i < sz; ++i) {
-            os << info.object_name(e[i]);
-            if (i < sz-1) os << ", ";
-        }
+		if (!_table.is_predicate()) os << ", " << info.object_name(entry.second);
 		os << " ), ";
 	}
 	os << "]";
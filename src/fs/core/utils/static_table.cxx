@@ -0,0 +1,154 @@
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+#include <fs/core/utils/static_table.hxx>
+
+
+namespace fs0 {
+
+//! Extensions whose dense array would have more cells than this are always hashed
+static const std::size_t MAX_DENSE_CELLS = 1 << 24;
+
+//! Dense arrays are used as long as they are not larger than this factor times the size of the extension (or than
+//! a minimum size, below which they are always cheap). Larger ones are mostly empty, and would waste memory and cache.
+static const std::size_t DENSITY_FACTOR = 8;
+static const std::size_t MIN_DENSE_CELLS = 1 << 12;
+
+StaticTable::StaticTable(unsigned arity, bool predicate, const ExtensionT& extension, uint32_t max_displacements) :
+	_arity(arity), _predicate(predicate), _layout(Layout::dense)
+{
+	if (build_dense(extension)) return;
+	_layout = Layout::perfect_hash;
+	if (build_perfect_hash(extension, max_displacements)) return;
+	_layout = Layout::hash_map;
+	build_hash_map(extension);
+}
+
+StaticTable::ExtensionT
+StaticTable::extension() const {
+	ExtensionT extension;
+	for (std::size_t s = 0; s < _values.size(); ++s) {
+		if (_values[s] == object_id::INVALID) continue;
+		std::vector<object_id> point(_arity);
+		for (unsigned i = 0; i < _arity; ++i) {
+			if (_layout == Layout::dense) point[i] = make_object(_types[i], uint32_t(_min[i] + (s / _strides[i]) % _extent[i]));
+			else point[i] = _points[s * _arity + i];
+		}
+		extension.emplace_back(std::move(point), _values[s]);
+	}
+	std::sort(extension.begin(), extension.end());
+	return extension;
+}
+
+bool
+StaticTable::build_dense(const ExtensionT& extension) {
+	_types.assign(_arity, type_id::invalid_t);
+	_min.assign(_arity, std::numeric_limits<uint32_t>::max());
+	std::vector<uint32_t> max(_arity, 0);
+
+	for (const auto& elem:extension) {
+		for (unsigned i = 0; i < _arity; ++i) {
+			const object_id& o = elem.first[i];
+			if (_types[i] == type_id::invalid_t) _types[i] = o.type();
+			else if (_types[i] != o.type()) return false; // Mixed types cannot be indexed by value alone
+			_min[i] = std::min(_min[i], o.value());
+			max[i] = std::max(max[i], o.value());
+		}
+	}
+
+	const std::size_t limit = std::min(MAX_DENSE_CELLS, std::max(MIN_DENSE_CELLS, DENSITY_FACTOR * extension.size()));
+	_extent.assign(_arity, 0);
+	_strides.assign(_arity, 0);
+	std::size_t cells = 1;
+	for (int i = (int) _arity - 1; i >= 0; --i) { // The last position varies fastest
+		uint64_t extent = extension.empty() ? 0 : uint64_t(max[i]) - _min[i] + 1;
+		if (extent > limit) return false;
+		_extent[i] = (uint32_t) extent;
+		_strides[i] = cells;
+		cells *= std::max<std::size_t>(_extent[i], 1);
+		if (cells > limit) return false;
+	}
+
+	_values.assign(extension.empty() && _arity > 0 ? 0 : cells, object_id::INVALID);
+	for (const auto& elem:extension) {
+		std::size_t offset = 0;
+		for (unsigned i = 0; i < _arity; ++i) offset += (elem.first[i].value() - _min[i]) * _strides[i];
+		_values[offset] = elem.second;
+	}
+	return true;
+}
+
+bool
+StaticTable::build_perfect_hash(const ExtensionT& extension, uint32_t max_displacements) {
+	_types.clear(); _min.clear(); _extent.clear(); _strides.clear();
+
+	const std::size_t n = extension.size();
+	const std::size_t num_buckets = std::max<std::size_t>(1, n / 4);
+
+	std::vector<uint64_t> hashes(n);
+	std::vector<std::vector<std::size_t>> buckets(num_buckets);
+	for (std::size_t k = 0; k < n; ++k) {
+		hashes[k] = hash(extension[k].first.data(), _arity, 0);
+		buckets[(hashes[k] >> 32) % num_buckets].push_back(k);
+	}
+
+	// Place the largest buckets first, while there are still plenty of free slots
+	std::vector<std::size_t> order(num_buckets);
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&buckets](std::size_t a, std::size_t b) { return buckets[a].size() > buckets[b].size(); });
+
+	_displacements.assign(num_buckets, 0);
+	std::vector<bool> taken(n, false);
+	std::vector<std::size_t> slots;
+	for (std::size_t b:order) {
+		const auto& bucket = buckets[b];
+		if (bucket.empty()) break;
+
+		for (uint32_t d = 0; ; ++d) {
+			if (d == max_displacements) return false;
+			slots.clear();
+			bool ok = true;
+			for (std::size_t k:bucket) {
+				std::size_t s = slot(hashes[k], d, n);
+				if (taken[s] || std::find(slots.begin(), slots.end(), s) != slots.end()) { ok = false; break; }
+				slots.push_back(s);
+			}
+			if (!ok) continue;
+
+			_displacements[b] = d;
+			for (std::size_t s:slots) taken[s] = true;
+			break;
+		}
+	}
+
+	_points.assign(n * _arity, object_id::INVALID);
+	_values.assign(n, object_id::INVALID);
+	for (std::size_t k = 0; k < n; ++k) {
+		std::size_t s = slot(hashes[k], _displacements[(hashes[k] >> 32) % num_buckets], n);
+		std::copy(extension[k].first.begin(), extension[k].first.end(), _points.begin() + s * _arity);
+		_values[s] = extension[k].second;
+	}
+	return true;
+}
+
+void
+StaticTable::build_hash_map(const ExtensionT& extension) {
+	_displacements.clear();
+
+	// Keep the load factor at most 1/2, so that probes are short and there is always some empty slot
+	std::size_t size = 2;
+	while (size < 2 * extension.size()) size <<= 1;
+	_points.assign(size * _arity, object_id::INVALID);
+	_values.assign(size, object_id::INVALID);
+
+	for (const auto& elem:extension) {
+		std::size_t s = hash(elem.first.data(), _arity, 0) & (size - 1);
+		while (_values[s] != object_id::INVALID) s = (s + 1) & (size - 1);
+		std::copy(elem.first.begin(), elem.first.end(), _points.begin() + s * _arity);
+		_values[s] = elem.second;
+	}
+}
+
+} // namespaces
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <fs/core/base.hxx>
+
+
+namespace fs0 {
+
+//! A read-only lookup table for the extension of a static symbol, meant to replace the binary searches
+//! on flat containers in the evaluation of static terms and atoms.
+//! If the points of the extension span small ranges of object values, the table is a dense multidimensional array,
+//! indexed with the (mixed-radix) offsets of the values of a point w.r.t. the smallest ones at each position;
+//! otherwise it is a minimal perfect hash over the points of the extension, built with the hash-and-displace
+//! method: points are spread into buckets, and each bucket is assigned a displacement that sends all
+//! of its points to free slots. In both cases a lookup costs a constant number of memory accesses.
+//! Should some bucket find no displacement within a bounded number of attempts, the table falls back to
+//! an (open-addressing) hash map over the points, where a lookup costs a short linear probe.
+class StaticTable {
+public:
+	using ExtensionT = std::vector<std::pair<std::vector<object_id>, object_id>>;
+
+	enum class Layout { dense, perfect_hash, hash_map };
+
+	//! The default max. number of displacements tried for each bucket of a perfect hash
+	static const uint32_t MAX_DISPLACEMENTS = 1 << 16;
+
+	//! A table for the given extension, made up of <point, value> pairs, where all points have the given arity.
+	//! Predicates are represented by taking their points as mapped into object_id::TRUE.
+	StaticTable(unsigned arity, bool predicate, const ExtensionT& extension, uint32_t max_displacements = MAX_DISPLACEMENTS);
+
+	StaticTable(const StaticTable&) = default;
+	StaticTable(StaticTable&&) = default;
+	StaticTable& operator=(const StaticTable&) = delete;
+	StaticTable& operator=(StaticTable&&) = delete;
+
+	unsigned arity() const { return _arity; }
+	bool is_predicate() const { return _predicate; }
+	Layout layout() const { return _layout; }
+
+	//! The <point, value> pairs of the extension, sorted by point
+	ExtensionT extension() const;
+
+	//! The value of the given point, or object_id::INVALID if the point is not in the extension
+	inline object_id find(const object_id* point) const;
+
+	//! The value of the symbol on the given point, i.e. the truth value of the point for predicates.
+	//! For functions, points not in the extension raise an std::out_of_range error, as evaluating them on flat maps did.
+	object_id evaluate(const object_id* point) const {
+		object_id value = find(point);
+		if (_predicate) return make_object(value != object_id::INVALID);
+		if (value == object_id::INVALID) throw std::out_of_range("Static function undefined on the given point");
+		return value;
+	}
+
+protected:
+	const unsigned _arity;
+	const bool _predicate;
+	Layout _layout;
+
+	//! For dense tables: the type of objects at each position, the smallest value, the number of values and the
+	//! stride of each position, and the value of each cell
+	std::vector<type_id> _types;
+	std::vector<uint32_t> _min;
+	std::vector<uint32_t> _extent;
+	std::vector<std::size_t> _strides;
+
+	//! For perfect hashes: the displacement of each bucket. For both kinds of hashed tables: the point at each slot
+	std::vector<uint32_t> _displacements;
+	std::vector<object_id> _points;
+
+	//! The values of the cells (dense tables) or slots (hashed tables). Empty cells or slots hold object_id::INVALID.
+	std::vector<object_id> _values;
+
+	static inline uint64_t hash(const object_id* point, unsigned arity, uint64_t seed);
+
+	//! The slot of a point with the given hash, in a bucket with the given displacement, among 'n' slots
+	static inline std::size_t slot(uint64_t h, uint32_t displacement, std::size_t n) {
+		uint64_t x = h + uint64_t(displacement) * 0x9E3779B97F4A7C15ULL;
+		x ^= x >> 33;
+		x *= 0xff51afd7ed558ccdULL;
+		x ^= x >> 33;
+		return std::size_t(x % n);
+	}
+
+	static inline bool equal(const object_id* p1, const object_id* p2, unsigned arity) {
+		for (unsigned i = 0; i < arity; ++i) {
+			if (p1[i] != p2[i]) return false;
+		}
+		return true;
+	}
+
+	bool build_dense(const ExtensionT& extension);
+	bool build_perfect_hash(const ExtensionT& extension, uint32_t max_displacements);
+	void build_hash_map(const ExtensionT& extension);
+};
+
+
+inline uint64_t
+StaticTable::hash(const object_id* point, unsigned arity, uint64_t seed) {
+	uint64_t h = seed;
+	for (unsigned i = 0; i < arity; ++i) {
+		h ^= (uint64_t(point[i].value()) << 8) | uint64_t(point[i].type());
+		h *= 0x9E3779B97F4A7C15ULL;
+		h ^= h >> 29;
+	}
+	return h;
+}
+
+inline object_id
+StaticTable::find(const object_id* point) const {
+	if (_layout == Layout::dense) {
+		std::size_t offset = 0;
+		for (unsigned i = 0; i < _arity; ++i) {
+			const object_id& o = point[i];
+			uint32_t delta = o.value() - _min[i];
+			if (o.type() != _types[i] || delta >= _extent[i]) return object_id::INVALID;
+			offset += delta * _strides[i];
+		}
+		return _values[offset];
+	}
+
+	if (_values.empty()) return object_id::INVALID;
+	uint64_t h = hash(point, _arity, 0);
+
+	if (_layout == Layout::perfect_hash) {
+		std::size_t s = slot(h, _displacements[(h >> 32) % _displacements.size()], _values.size());
+		return equal(&_points[s * _arity], point, _arity) ? _values[s] : object_id::INVALID;
+	}
+
+	// The hash map has a power-of-two number of slots, at least one of which is always empty
+	const std::size_t mask = _values.size() - 1;
+	for (std::size_t s = h & mask; _values[s] != object_id::INVALID; s = (s + 1) & mask) {
+		if (equal(&_points[s * _arity], point, _arity)) return _values[s];
+	}
+	return object_id::INVALID;
+}
+
+} // namespaces
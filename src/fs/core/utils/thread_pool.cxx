@@ -0,0 +1,117 @@
+
+#include <stdexcept>
+
+#include <fs/core/utils/thread_pool.hxx>
+#include <fs/core/utils/config.hxx>
+
+
+namespace fs0 {
+
+ThreadPool::ThreadPool(unsigned num_workers) :
+	_threads(),
+	_task(nullptr),
+	_ranges(num_workers > 0 ? num_workers : hardware_concurrency()),
+	_generation(0),
+	_running(0),
+	_stop(false),
+	_error()
+{
+	if (num_workers == 0) num_workers = hardware_concurrency();
+	_threads.reserve(num_workers - 1);
+	for (unsigned i = 1; i < num_workers; ++i) {
+		_threads.emplace_back([this, i] { work(i); });
+	}
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stop = true;
+	}
+	_work_available.notify_all();
+	for (auto& thread:_threads) thread.join();
+}
+
+unsigned
+ThreadPool::hardware_concurrency() {
+	unsigned n = std::thread::hardware_concurrency();
+	return n > 0 ? n : 1;
+}
+
+unsigned
+ThreadPool::num_workers(const Config& config, const std::string& key) {
+	int value = config.getOption<int>(key, 0);
+	if (value < 0) throw std::runtime_error("The number of threads given by option '" + key + "' cannot be negative");
+	return value > 0 ? unsigned(value) : hardware_concurrency();
+}
+
+void
+ThreadPool::parallel_for(std::size_t n, const TaskT& task) {
+	if (n == 0) return;
+
+	if (_threads.empty() || n == 1) { // No need to bother the workers
+		for (std::size_t i = 0; i < n; ++i) task(i, 0);
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_task = &task;
+		const std::size_t workers = _ranges.size();
+		for (std::size_t w = 0; w < workers; ++w) {
+			_ranges[w].next.store(n * w / workers, std::memory_order_relaxed);
+			_ranges[w].end = n * (w + 1) / workers;
+		}
+		_running = _threads.size();
+		_error = nullptr;
+		++_generation;
+	}
+	_work_available.notify_all();
+
+	run_iterations(0);
+
+	std::unique_lock<std::mutex> lock(_mutex);
+	_work_done.wait(lock, [this] { return _running == 0; });
+	_task = nullptr;
+
+	if (_error) std::rethrow_exception(_error);
+}
+
+void
+ThreadPool::work(unsigned worker) {
+	unsigned long seen = 0;
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_work_available.wait(lock, [this, seen] { return _stop || _generation != seen; });
+			if (_stop) return;
+			seen = _generation;
+		}
+
+		run_iterations(worker);
+
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			--_running;
+		}
+		_work_done.notify_one();
+	}
+}
+
+void
+ThreadPool::run_iterations(unsigned worker) {
+	const std::size_t workers = _ranges.size();
+	for (std::size_t k = 0; k < workers; ++k) {
+		RangeT& range = _ranges[(worker + k) % workers]; // Our own range first, then the others'
+		for (std::size_t i = range.next.fetch_add(1, std::memory_order_relaxed); i < range.end; i = range.next.fetch_add(1, std::memory_order_relaxed)) {
+			try {
+				(*_task)(i, worker);
+			} catch (...) {
+				std::lock_guard<std::mutex> lock(_mutex);
+				if (!_error) _error = std::current_exception();
+			}
+		}
+	}
+}
+
+} // namespaces
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs0 { class Config; }
+
+namespace fs0 {
+
+//! A fixed-size pool of worker threads to run parallel loops.
+//! The thread that runs a loop takes part in it as the worker with index 0, hence a pool of size n
+//! spawns only n-1 threads. The iterations of a loop are split into one contiguous range per worker;
+//! a worker that runs out of iterations in its own range steals them from the ranges of the others,
+//! so that loops with unbalanced iterations (e.g. expansions of states with different branching factors)
+//! still keep all workers busy, without all of them contending on a single shared counter.
+class ThreadPool {
+public:
+	//! The signature of the loop bodies: iteration index, and index of the worker that runs the iteration.
+	using TaskT = std::function<void(std::size_t, unsigned)>;
+
+	//! A pool with the given total number of workers; 0 means as many as hardware threads.
+	explicit ThreadPool(unsigned num_workers = 0);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool(ThreadPool&&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+	ThreadPool& operator=(ThreadPool&&) = delete;
+
+	//! The total number of workers, including the calling thread
+	unsigned size() const { return _threads.size() + 1; }
+
+	//! Run 'task(i, worker)' for every 'i' in [0, n), and block until all iterations are done.
+	//! If some iteration throws, the first exception is rethrown here, once all workers are done.
+	//! Not meant to be called concurrently from different threads.
+	void parallel_for(std::size_t n, const TaskT& task);
+
+	//! The number of hardware threads, or 1 if that cannot be determined
+	static unsigned hardware_concurrency();
+
+	//! The number of workers given by the integer option with the given key, where 0 (the default) means
+	//! as many as hardware threads. Throws if the value of the option is negative.
+	static unsigned num_workers(const Config& config, const std::string& key);
+
+protected:
+	std::vector<std::thread> _threads;
+
+	std::mutex _mutex;
+	std::condition_variable _work_available;
+	std::condition_variable _work_done;
+
+	//! The range of iterations of the current loop initially assigned to some worker.
+	//! Aligned to a cache line, so that workers claiming iterations from their own range do not interfere.
+	struct alignas(64) RangeT {
+		std::atomic<std::size_t> next;
+		std::size_t end;
+	};
+
+	//! The current loop
+	const TaskT* _task;
+	std::vector<RangeT> _ranges;
+
+	//! Incremented each time a new loop starts, so that workers can tell new loops from spurious wakeups
+	unsigned long _generation;
+
+	//! The number of spawned workers still running the current loop
+	unsigned _running;
+
+	bool _stop;
+
+	std::exception_ptr _error;
+
+	void work(unsigned worker);
+
+	//! Run iterations of the current loop until there are none left, first from the range of
+	//! the given worker, then from the ranges of the rest of workers.
+	void run_iterations(unsigned worker);
+};
+
+} // namespaces
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <random>
+
+#include <fs/core/actions/actions.hxx>
+#include <fs/core/actions/ground_action_store.hxx>
+#include <fs/core/actions/strips_table.hxx>
+#include <fs/core/languages/fstrips/language.hxx>
+#include <fs/core/state.hxx>
+#include <fs/core/atom.hxx>
+
+using namespace fs0;
+
+//! Checks the bitmask form of STRIPS actions against the interpretation of their precondition and GroundAction::apply,
+//! on random actions and states over 70 Boolean variables (hence two words) and a multivalued variable.
+class StripsTableTest : public testing::Test {
+protected:
+	static const unsigned NUM_BOOL = 70;
+	static const VariableIdx MULTIVALUED = NUM_BOOL;
+
+	void SetUp() override {
+		std::vector<StateAtomIndexer::VariableT> variables(NUM_BOOL, {true, type_id::bool_t, 0, 0});
+		variables.push_back({false, type_id::object_t, 0, 3});
+		_indexer.reset(StateAtomIndexer::create(variables));
+		_data.reset(new ActionData(0, "action", {}, {}, fs::BindingUnit({}, {}), new fs::Tautology(), {}, ActionData::Type::Control));
+	}
+
+	static const fs::Term* var(VariableIdx variable) { return new fs::StateVariable(variable, nullptr); }
+	static const fs::Term* constant(const object_id& value) { return new fs::Constant(value, 0); }
+
+	static const fs::Formula* atom(VariableIdx variable, const object_id& value, bool eq = true) {
+		std::vector<const fs::Term*> subterms{var(variable), constant(value)};
+		if (eq) return new fs::EQAtomicFormula(subterms);
+		return new fs::NEQAtomicFormula(subterms);
+	}
+
+	static const fs::ActionEffect* effect(VariableIdx variable, const object_id& value, const fs::Formula* condition = new fs::Tautology()) {
+		return new fs::ActionEffect(var(variable), constant(value), condition);
+	}
+
+	//! A random STRIPS action over Boolean variables, whose effects might assign the same variable more than once
+	void add_random_action() {
+		std::uniform_int_distribution<unsigned> num(1, 4), variable(0, NUM_BOOL - 1);
+		std::vector<const fs::Formula*> conjuncts;
+		for (unsigned i = 0, n = num(_rng); i < n; ++i) conjuncts.push_back(atom(variable(_rng), make_object(bool(_rng() % 2)), _rng() % 3));
+		std::vector<const fs::ActionEffect*> effects;
+		for (unsigned i = 0, n = num(_rng); i < n; ++i) effects.push_back(effect(variable(_rng), make_object(bool(_rng() % 2))));
+
+		const fs::Formula* precondition = (conjuncts.size() == 1) ? conjuncts[0] : new fs::Conjunction(conjuncts);
+		add_action(precondition, effects);
+	}
+
+	void add_action(const fs::Formula* precondition, const std::vector<const fs::ActionEffect*>& effects) {
+		_actions.emplace_back(new GroundAction(_actions.size(), *_data, Binding(), precondition, effects));
+		_store.add(*_actions.back());
+	}
+
+	std::unique_ptr<State> random_state() {
+		std::unique_ptr<State> state(State::create(*_indexer, _indexer->size(), {}));
+		for (VariableIdx variable = 0; variable < NUM_BOOL; ++variable) _indexer->update(*state, variable, make_object(bool(_rng() % 2)));
+		_indexer->update(*state, MULTIVALUED, make_object(type_id::object_t, unsigned(_rng() % 4)));
+		state->updateHash();
+		return state;
+	}
+
+	//! The successor of the given state through the given atoms
+	State successor(const State& state, const std::vector<Atom>& atoms) const {
+		State next(state);
+		for (const Atom& atom:atoms) _indexer->update(next, atom.getVariable(), atom.getValue());
+		next.updateHash();
+		return next;
+	}
+
+	std::mt19937 _rng{17};
+	std::unique_ptr<StateAtomIndexer> _indexer;
+	std::unique_ptr<ActionData> _data;
+	std::vector<std::unique_ptr<GroundAction>> _actions;
+	GroundActionStore _store;
+};
+
+
+TEST_F(StripsTableTest, AgreesWithActions) {
+	for (unsigned i = 0; i < 200; ++i) add_random_action();
+	auto table = StripsActionTable::create(_store, *_indexer);
+	ASSERT_TRUE(table);
+	ASSERT_EQ(table->num_covered(), _actions.size());
+
+	std::vector<Atom> changeset, atoms;
+	unsigned applicable = 0;
+	for (unsigned i = 0; i < 200; ++i) {
+		auto state = random_state();
+		for (const auto& action:_actions) {
+			ActionIdx id = action->getId();
+			bool expected = action->getPrecondition()->interpret(*state);
+			ASSERT_EQ(table->applicable(id, *state), expected);
+			if (!expected) continue;
+			++applicable;
+
+			atoms.clear();
+			action->apply(*state, atoms);
+			State next = table->next(id, *state, changeset);
+			State expected_next = successor(*state, atoms);
+			ASSERT_EQ(changeset, atoms);
+			ASSERT_EQ(next, expected_next);
+			ASSERT_EQ(next.hash(), expected_next.hash());
+		}
+	}
+	ASSERT_GT(applicable, 0);
+}
+
+//! Actions over multivalued variables, or with conditional effects, are not covered by the table
+TEST_F(StripsTableTest, Coverage) {
+	add_action(atom(MULTIVALUED, make_object(type_id::object_t, 2)), {effect(0, make_object(true))});
+	add_action(atom(1, make_object(true)), {effect(MULTIVALUED, make_object(type_id::object_t, 1))});
+	add_action(atom(1, make_object(true)), {effect(2, make_object(true), atom(3, make_object(false)))});
+	ASSERT_FALSE(StripsActionTable::create(_store, *_indexer));
+
+	add_action(new fs::Tautology(), {effect(2, make_object(true)), effect(65, make_object(false))});
+	auto table = StripsActionTable::create(_store, *_indexer);
+	ASSERT_TRUE(table);
+	ASSERT_EQ(table->num_covered(), 1);
+	ASSERT_FALSE(table->covers(0));
+	ASSERT_FALSE(table->covers(1));
+	ASSERT_FALSE(table->covers(2));
+	ASSERT_TRUE(table->covers(3));
+}
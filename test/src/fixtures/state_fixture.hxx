@@ -0,0 +1,42 @@
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <fs/core/state.hxx>
+
+namespace fs0 { namespace test {
+
+//! A base fixture for tests on states over some made-up state variables: a number of predicative variables, followed by
+//! some multivalued ones. States are only built from empty sets of atoms, and modified through the indexer, so that the
+//! tests do not depend on the ProblemInfo that debug builds check atom types against.
+class StateFixture : public testing::Test {
+protected:
+	using VariableT = StateAtomIndexer::VariableT;
+
+	//! An indexer for 'num_bool' predicative variables, followed by the given multivalued variables
+	static std::unique_ptr<StateAtomIndexer> make_indexer(unsigned num_bool, const std::vector<VariableT>& multivalued = {}) {
+		std::vector<VariableT> variables(num_bool, {true, type_id::bool_t, 0, 0});
+		variables.insert(variables.end(), multivalued.begin(), multivalued.end());
+		return std::unique_ptr<StateAtomIndexer>(StateAtomIndexer::create(variables));
+	}
+
+	//! Multivalued variables of the different types
+	static VariableT object_variable(object_id::value_t min, object_id::value_t max) { return {false, type_id::object_t, min, max}; }
+	static VariableT bool_variable() { return {false, type_id::bool_t, 0, 1}; }
+	static VariableT int_variable() { return {false, type_id::int_t, 0, 0}; }
+
+	//! The state where all variables have a zero code, i.e. are false or undefined
+	static std::unique_ptr<State> make_empty_state(const StateAtomIndexer& indexer) {
+		return std::unique_ptr<State>(State::create(indexer, indexer.size(), {}));
+	}
+	std::unique_ptr<State> make_empty_state() const { return make_empty_state(*_indexer); }
+
+	//! The indexer of the fixture, for those tests that need one single indexer
+	std::unique_ptr<StateAtomIndexer> _indexer;
+};
+
+} } // namespaces
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include <fs/core/languages/fstrips/language.hxx>
+#include <fs/core/languages/fstrips/bytecode.hxx>
+#include <fs/core/state.hxx>
+
+using namespace fs0;
+namespace fs = fs0::language::fstrips;
+
+//! Checks that formula programs agree with the interpretation of the formula AST over all states of a small problem,
+//! with two integer variables x0, x1 in [0..3], a Boolean variable b and an object variable o in [0..3].
+class FormulaProgramTest : public testing::Test {
+protected:
+	void SetUp() override {
+		std::vector<StateAtomIndexer::VariableT> variables;
+		variables.push_back({false, type_id::int_t, 0, 0});
+		variables.push_back({false, type_id::int_t, 0, 0});
+		variables.push_back({true, type_id::bool_t, 0, 0});
+		variables.push_back({false, type_id::object_t, 0, 3});
+		_indexer.reset(StateAtomIndexer::create(variables));
+	}
+
+	static const fs::Term* var(VariableIdx variable) { return new fs::StateVariable(variable, nullptr); }
+	static const fs::Term* integer(int value) { return new fs::Constant(make_object(value), 0); }
+	static const fs::Term* object(unsigned value) { return new fs::Constant(make_object(type_id::object_t, value), 0); }
+
+	template <typename FormulaT>
+	static const fs::Formula* rel(const fs::Term* lhs, const fs::Term* rhs) { return new FormulaT(std::vector<const fs::Term*>{lhs, rhs}); }
+
+	static const fs::Formula* conj(const std::vector<const fs::Formula*>& conjuncts) { return new fs::Conjunction(conjuncts); }
+
+	//! Check that the program of the given formula agrees with the formula on every state, and return on how many states it holds
+	unsigned check(const fs::Formula* formula) const {
+		std::unique_ptr<const fs::Formula> owner(formula);
+		fs::FormulaProgram program(formula);
+
+		unsigned satisfied = 0;
+		std::unique_ptr<State> state(State::create(*_indexer, _indexer->size(), {}));
+		for (int x0 = 0; x0 < 4; ++x0) {
+			for (int x1 = 0; x1 < 4; ++x1) {
+				for (bool b:{false, true}) {
+					for (unsigned o = 0; o < 4; ++o) {
+						_indexer->update(*state, 0, make_object(x0));
+						_indexer->update(*state, 1, make_object(x1));
+						_indexer->update(*state, 2, make_object(b));
+						_indexer->update(*state, 3, make_object(type_id::object_t, o));
+
+						bool expected = formula->interpret(*state);
+						EXPECT_EQ(program.satisfied(*state), expected) << "x0=" << x0 << ", x1=" << x1 << ", b=" << b << ", o=" << o;
+						satisfied += expected;
+					}
+				}
+			}
+		}
+		return satisfied;
+	}
+
+	std::unique_ptr<StateAtomIndexer> _indexer;
+};
+
+
+TEST_F(FormulaProgramTest, Comparisons) {
+	ASSERT_EQ(check(rel<fs::EQAtomicFormula>(var(0), var(1))), 4 * 2 * 4);
+	ASSERT_EQ(check(rel<fs::NEQAtomicFormula>(var(0), integer(2))), 3 * 4 * 2 * 4);
+	ASSERT_EQ(check(rel<fs::LTAtomicFormula>(var(0), var(1))), 6 * 2 * 4);
+	ASSERT_EQ(check(rel<fs::LEQAtomicFormula>(var(1), integer(1))), 4 * 2 * 2 * 4);
+	ASSERT_EQ(check(rel<fs::GTAtomicFormula>(integer(3), var(0))), 3 * 4 * 2 * 4);
+	ASSERT_EQ(check(rel<fs::GEQAtomicFormula>(var(0), var(1))), 10 * 2 * 4);
+	ASSERT_EQ(check(rel<fs::EQAtomicFormula>(var(3), object(2))), 4 * 4 * 2);
+	ASSERT_EQ(check(rel<fs::EQAtomicFormula>(var(2), new fs::Constant(make_object(true), 0))), 4 * 4 * 4);
+}
+
+//! Conjunctions are flattened into their atoms, and fail as soon as one of them fails
+TEST_F(FormulaProgramTest, Conjunctions) {
+	check(conj({rel<fs::LTAtomicFormula>(var(0), var(1)), rel<fs::LEQAtomicFormula>(var(1), integer(2)),
+	            rel<fs::EQAtomicFormula>(var(2), new fs::Constant(make_object(true), 0))}));
+	check(conj({rel<fs::NEQAtomicFormula>(var(0), integer(1)),
+	            conj({rel<fs::GEQAtomicFormula>(var(0), integer(0)), rel<fs::GTAtomicFormula>(var(1), var(0))})}));
+	check(conj({}));
+}
+
+//! Formulas without instructions of their own are evaluated through the AST
+TEST_F(FormulaProgramTest, Fallbacks) {
+	check(conj({rel<fs::EQAtomicFormula>(var(0), var(1)), new fs::Negation(rel<fs::EQAtomicFormula>(var(3), object(2)))}));
+	check(new fs::Disjunction({rel<fs::EQAtomicFormula>(var(0), integer(3)), rel<fs::EQAtomicFormula>(var(3), object(1))}));
+	check(conj({new fs::Disjunction({rel<fs::LTAtomicFormula>(var(0), integer(1)), rel<fs::GTAtomicFormula>(var(1), integer(2))}),
+	            rel<fs::NEQAtomicFormula>(var(3), object(0))}));
+}
+
+TEST_F(FormulaProgramTest, TruthValues) {
+	ASSERT_EQ(check(new fs::Tautology()), 4 * 4 * 2 * 4);
+	ASSERT_EQ(check(new fs::Contradiction()), 0);
+	ASSERT_EQ(check(conj({new fs::Tautology(), rel<fs::EQAtomicFormula>(var(0), integer(0))})), 4 * 2 * 4);
+	ASSERT_EQ(check(conj({rel<fs::EQAtomicFormula>(var(0), integer(0)), new fs::Contradiction()})), 0);
+}
@@ -0,0 +1,261 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+
+#include <fs/core/heuristics/relaxed_plan/relaxed_explorer.hxx>
+
+using namespace fs0;
+using fs0::gecode::RelaxedExplorer;
+
+static const unsigned UNREACHED = RelaxedExplorer::UNREACHED;
+
+//! Checks the queue-driven relaxed exploration against a reference layered RPG with the same semantics: layers are strict,
+//! i.e. the actions of a layer only use atoms of the previous layers, each newly-reached atom gets the first action that
+//! reaches it as its achiever, and the relaxed plan counts every distinct action once. This is not what NativeRPG::evaluate
+//! computes, since there atoms reached within a pass over the actions are already usable by the next actions of the pass,
+//! and the plan extractor counts an action once per plan atom it first achieves.
+class RelaxedExplorerTest : public testing::Test {
+protected:
+	static const unsigned NUM_ATOMS = 40;
+	static const unsigned NUM_ACTIONS = 60;
+
+	std::vector<std::vector<AtomIdx>> _preconditions;
+	std::vector<std::vector<AtomIdx>> _effects;
+	std::vector<AtomIdx> _goal;
+	std::mt19937 _rng{7};
+
+	//! The result of an evaluation: the h_FF value, the sorted relevant atoms, and the layer of each atom
+	struct EvaluationT {
+		long h;
+		std::vector<AtomIdx> relevant;
+		std::vector<unsigned> layers;
+	};
+
+	//! A random problem. If 'unique_achievers', each atom has at most one achiever, so that the relaxed plan is
+	//! the same whatever the order in which actions are processed, and h_FF values can be compared.
+	void random_problem(bool unique_achievers) {
+		std::uniform_int_distribution<unsigned> num_pre(0, 3), num_goal(1, 3), atom(0, NUM_ATOMS - 1), action(0, NUM_ACTIONS - 1);
+		_preconditions.assign(NUM_ACTIONS, {});
+		_effects.assign(NUM_ACTIONS, {});
+		_goal.clear();
+
+		for (unsigned a = 0; a < NUM_ACTIONS; ++a) {
+			for (unsigned i = 0, n = num_pre(_rng); i < n; ++i) add_distinct(_preconditions[a], atom(_rng));
+			if (!unique_achievers) {
+				for (unsigned i = 0, n = 1 + num_pre(_rng); i < n; ++i) add_distinct(_effects[a], atom(_rng));
+			}
+		}
+		if (unique_achievers) {
+			for (AtomIdx p = 0; p < NUM_ATOMS; ++p) {
+				if (_rng() % 4) _effects[action(_rng)].push_back(p);
+			}
+		}
+		for (unsigned i = 0, n = num_goal(_rng); i < n; ++i) add_distinct(_goal, atom(_rng));
+	}
+
+	std::vector<AtomIdx> random_seed() {
+		std::vector<AtomIdx> seed;
+		for (AtomIdx p = 0; p < NUM_ATOMS; ++p) {
+			if (_rng() % 5 == 0) seed.push_back(p);
+		}
+		return seed;
+	}
+
+	static void add_distinct(std::vector<AtomIdx>& atoms, AtomIdx atom) {
+		if (std::find(atoms.begin(), atoms.end(), atom) == atoms.end()) atoms.push_back(atom);
+	}
+
+	std::unique_ptr<RelaxedExplorer> explorer() const {
+		return std::unique_ptr<RelaxedExplorer>(new RelaxedExplorer(NUM_ATOMS, _preconditions, _effects, _goal));
+	}
+
+	//! The layered RPG from the given seed, up to the layer where the goal is reached or, if 'fixpoint', until no new atom is reached
+	EvaluationT layered(const std::vector<AtomIdx>& seed, bool fixpoint) const {
+		EvaluationT result{-1, {}, std::vector<unsigned>(NUM_ATOMS, UNREACHED)};
+		std::vector<unsigned> achiever(NUM_ATOMS, UNREACHED);
+		for (AtomIdx p:seed) result.layers[p] = 0;
+
+		for (unsigned layer = 0; fixpoint || !goal_reached(result.layers); ++layer) {
+			std::vector<AtomIdx> novel;
+			for (unsigned a = 0; a < NUM_ACTIONS; ++a) {
+				bool applicable = std::all_of(_preconditions[a].begin(), _preconditions[a].end(), [&](AtomIdx p) { return result.layers[p] <= layer; });
+				if (!applicable) continue;
+				for (AtomIdx p:_effects[a]) {
+					if (result.layers[p] != UNREACHED || achiever[p] != UNREACHED) continue;
+					achiever[p] = a;
+					novel.push_back(p);
+				}
+			}
+			if (novel.empty()) break;
+			for (AtomIdx p:novel) result.layers[p] = layer + 1;
+		}
+		if (!goal_reached(result.layers)) return result;
+
+		// Backchain from the goal through the achievers, counting the distinct actions of the relaxed plan
+		std::vector<bool> in_plan(NUM_ACTIONS, false), supported(NUM_ATOMS, false);
+		std::vector<AtomIdx> open(_goal);
+		result.h = 0;
+		while (!open.empty()) {
+			AtomIdx p = open.back();
+			open.pop_back();
+			if (supported[p] || result.layers[p] == 0) continue;
+			supported[p] = true;
+			if (result.layers[p] == 1) result.relevant.push_back(p);
+			if (in_plan[achiever[p]]) continue;
+			in_plan[achiever[p]] = true;
+			++result.h;
+			open.insert(open.end(), _preconditions[achiever[p]].begin(), _preconditions[achiever[p]].end());
+		}
+		std::sort(result.relevant.begin(), result.relevant.end());
+		return result;
+	}
+
+	bool goal_reached(const std::vector<unsigned>& layers) const {
+		return std::all_of(_goal.begin(), _goal.end(), [&](AtomIdx p) { return layers[p] != UNREACHED; });
+	}
+
+	static EvaluationT evaluate(RelaxedExplorer& explorer, const std::vector<AtomIdx>& seed) {
+		EvaluationT result{0, {}, std::vector<unsigned>(NUM_ATOMS)};
+		result.h = explorer.hff(seed, result.relevant);
+		std::sort(result.relevant.begin(), result.relevant.end());
+		for (AtomIdx p = 0; p < NUM_ATOMS; ++p) result.layers[p] = explorer.layer(p);
+		return result;
+	}
+
+	//! The h_max value, i.e. the max. layer of the goal atoms
+	unsigned hmax(const std::vector<unsigned>& layers) const {
+		unsigned h = 0;
+		for (AtomIdx p:_goal) h = std::max(h, layers[p]);
+		return h;
+	}
+};
+
+TEST_F(RelaxedExplorerTest, EmptySeed) {
+	// Only an action with no precondition can get the exploration started
+	_preconditions = {{}, {0}, {1}};
+	_effects = {{0}, {1}, {2}};
+	_goal = {2};
+	std::vector<AtomIdx> relevant;
+	EXPECT_EQ(explorer()->hff({}, relevant), 3);
+	EXPECT_EQ(relevant, std::vector<AtomIdx>({0}));
+
+	_preconditions = {{3}};
+	_effects = {{2}};
+	EXPECT_EQ(explorer()->hff({}, relevant), -1);
+}
+
+TEST_F(RelaxedExplorerTest, AgreesWithLayeredRPG) {
+	for (unsigned problem = 0; problem < 50; ++problem) {
+		random_problem(true);
+		auto e = explorer();
+		for (unsigned s = 0; s < 20; ++s) {
+			auto seed = (s == 0) ? std::vector<AtomIdx>() : random_seed();
+			EvaluationT expected = layered(seed, false);
+			EvaluationT actual = evaluate(*e, seed);
+			ASSERT_EQ(actual.h, expected.h);
+			if (expected.h < 0) continue;
+			EXPECT_EQ(actual.relevant, expected.relevant);
+			EXPECT_EQ(hmax(actual.layers), hmax(expected.layers));
+		}
+	}
+}
+
+TEST_F(RelaxedExplorerTest, AgreesWithLayeredRPGOnTies) {
+	// With several achievers per atom, the relaxed plans might differ, but not the layers nor the reachability of the goal
+	for (unsigned problem = 0; problem < 50; ++problem) {
+		random_problem(false);
+		auto e = explorer();
+		for (unsigned s = 0; s < 20; ++s) {
+			auto seed = random_seed();
+			EvaluationT expected = layered(seed, false);
+			EvaluationT actual = evaluate(*e, seed);
+			ASSERT_EQ(actual.h < 0, expected.h < 0);
+			if (expected.h < 0) continue;
+			EXPECT_EQ(hmax(actual.layers), hmax(expected.layers));
+			EXPECT_GE(actual.h, (long) hmax(actual.layers));
+			for (AtomIdx p:_goal) EXPECT_EQ(actual.layers[p], expected.layers[p]);
+		}
+	}
+}
+
+TEST_F(RelaxedExplorerTest, IncrementalDeleteAndReAdd) {
+	// 0 -> 1 -> 2 -> 3, plus a shortcut 4 -> 3
+	_preconditions = {{0}, {1}, {2}, {4}};
+	_effects = {{1}, {2}, {3}, {3}};
+	_goal = {3};
+	auto e = explorer();
+	e->set_incremental(4);
+	std::vector<AtomIdx> relevant;
+
+	EXPECT_EQ(e->hff({0, 4}, relevant), 1);
+	EXPECT_EQ(e->layer(3), 1u);
+	EXPECT_EQ(e->layer(2), 2u);
+
+	// Deleting atom 4 invalidates the layer of 3, which must be recomputed through the chain
+	EXPECT_EQ(e->hff({0}, relevant), 3);
+	EXPECT_EQ(e->layer(3), 3u);
+	EXPECT_EQ(e->layer(4), UNREACHED);
+
+	// Deleting atom 0 too makes the goal unreachable
+	EXPECT_EQ(e->hff({}, relevant), -1);
+	EXPECT_EQ(e->layer(1), UNREACHED);
+
+	// Re-adding the atoms brings back the original layers
+	EXPECT_EQ(e->hff({2}, relevant), 1);
+	EXPECT_EQ(e->layer(3), 1u);
+	EXPECT_EQ(e->hff({0, 4}, relevant), 1);
+	EXPECT_EQ(e->layer(1), 1u);
+	EXPECT_EQ(e->layer(2), 2u);
+	EXPECT_EQ(e->layer(3), 1u);
+}
+
+TEST_F(RelaxedExplorerTest, IncrementalAgreesWithLayeredRPG) {
+	// Random walks over seeds that differ in a few atoms, so that the fixpoint is repaired, plus the occasional jump
+	// to an unrelated seed, which differs in more than 'max_delta' atoms and makes the fixpoint be computed from scratch
+	const unsigned max_delta = 4;
+	for (unsigned problem = 0; problem < 50; ++problem) {
+		random_problem(problem % 2 == 0);
+		auto e = explorer();
+		e->set_incremental(max_delta);
+		auto seed = random_seed();
+		for (unsigned s = 0; s < 40; ++s) {
+			if (s % 10 == 9) {
+				seed = random_seed();
+			} else {
+				for (unsigned i = 0, n = 1 + _rng() % max_delta; i < n; ++i) {
+					AtomIdx p = _rng() % NUM_ATOMS;
+					auto it = std::find(seed.begin(), seed.end(), p);
+					if (it == seed.end()) seed.push_back(p);
+					else seed.erase(it);
+				}
+			}
+
+			EvaluationT expected = layered(seed, true);
+			EvaluationT actual = evaluate(*e, seed);
+			ASSERT_EQ(actual.layers, expected.layers);
+			ASSERT_EQ(actual.h < 0, expected.h < 0);
+			if (problem % 2 == 0) {
+				EXPECT_EQ(actual.h, expected.h);
+				EXPECT_EQ(actual.relevant, expected.relevant);
+			}
+		}
+	}
+}
+
+TEST_F(RelaxedExplorerTest, IncrementalFallback) {
+	// With max_delta = 0, every change of seed makes the fixpoint be computed from scratch
+	for (unsigned problem = 0; problem < 20; ++problem) {
+		random_problem(true);
+		auto e = explorer();
+		e->set_incremental(0);
+		for (unsigned s = 0; s < 20; ++s) {
+			auto seed = random_seed();
+			EvaluationT expected = layered(seed, true);
+			EvaluationT actual = evaluate(*e, seed);
+			ASSERT_EQ(actual.layers, expected.layers);
+			EXPECT_EQ(actual.h, expected.h);
+		}
+	}
+}
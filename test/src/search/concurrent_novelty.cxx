@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include <fs/core/search/novelty/concurrent_novelty.hxx>
+
+using namespace fs0;
+using namespace fs0::bfws;
+
+class ConcurrentNovelty : public testing::Test {};
+
+
+TEST_F(ConcurrentNovelty, Width1) {
+	ConcurrentNoveltyTable table(10, 1);
+	ASSERT_EQ(table.evaluate({0, 1, 2}), 1);
+	ASSERT_EQ(table.evaluate({0, 1, 2}), 2);
+	ASSERT_EQ(table.evaluate({2, 1}), 2);
+	ASSERT_EQ(table.evaluate({2, 3}), 1);
+}
+
+//! A width-2 table only reports new pairs: new single atoms are the business of the width-1 table
+TEST_F(ConcurrentNovelty, Width2) {
+	ConcurrentNoveltyTable table(10, 2);
+	ASSERT_EQ(table.evaluate({0, 1}), 2);
+	ASSERT_EQ(table.evaluate({1, 0}), 3);
+	ASSERT_EQ(table.evaluate({5}), 3); // A new atom, but no new pair
+	ASSERT_EQ(table.evaluate({0, 1, 5}), 2);
+	ASSERT_EQ(table.evaluate({0, 5}), 3);
+	ASSERT_EQ(table.evaluate({1, 5}), 3);
+}
+
+//! Only the tuples with some atom in 'novel' are considered and recorded
+TEST_F(ConcurrentNovelty, NovelAtoms) {
+	ConcurrentNoveltyTable table(10, 2);
+	ASSERT_EQ(table.evaluate({0, 1, 2}, {2}), 2); // Records {0,2} and {1,2}, but not {0,1}
+	ASSERT_EQ(table.evaluate({0, 2}), 3);
+	ASSERT_EQ(table.evaluate({0, 1}), 2);
+	ASSERT_EQ(table.evaluate({0, 1, 2}, {0, 1}), 3);
+}
+
+//! Each tuple is claimed by exactly one of the threads that evaluate states with it concurrently
+TEST_F(ConcurrentNovelty, Concurrency) {
+	const unsigned num_threads = 8, num_atoms = 200;
+	ConcurrentNoveltyTable table(num_atoms, 2);
+	std::vector<unsigned> novel_states(num_threads, 0);
+
+	std::vector<std::thread> threads;
+	for (unsigned t = 0; t < num_threads; ++t) {
+		threads.emplace_back([&, t] {
+			for (AtomIdx a = 0; a < num_atoms; ++a) {
+				for (AtomIdx b = a + 1; b < num_atoms; ++b) {
+					if (table.evaluate({a, b}) == 2) ++novel_states[t];
+				}
+			}
+		});
+	}
+	for (auto& thread:threads) thread.join();
+
+	unsigned total = 0;
+	for (unsigned n:novel_states) total += n;
+	ASSERT_EQ(total, num_atoms * (num_atoms - 1) / 2);
+}
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include <fs/core/heuristics/heuristic_cache.hxx>
+#include <fs/core/state.hxx>
+#include <fs/core/atom.hxx>
+#include "fixtures/state_fixture.hxx"
+
+using namespace fs0;
+
+class HeuristicCacheTest : public fs0::test::StateFixture {
+protected:
+	static const unsigned NUM_BOOL = 20;
+
+	void SetUp() override {
+		_indexer = make_indexer(NUM_BOOL, {object_variable(0, 7), int_variable()});
+	}
+
+	//! The state where only the given Boolean variable is true
+	std::unique_ptr<State> make_state(VariableIdx variable) const {
+		auto state = make_empty_state();
+		_indexer->update(*state, variable, make_object(true));
+		state->updateHash();
+		return state;
+	}
+
+	//! A mix of predicative, object and integer atoms, more than the average number per entry
+	static std::vector<Atom> relevant_atoms(unsigned n) {
+		std::vector<Atom> atoms;
+		for (unsigned i = 0; i < n; ++i) {
+			if (i % 3 == 0) atoms.emplace_back(i % NUM_BOOL, make_object(true));
+			else if (i % 3 == 1) atoms.emplace_back(VariableIdx(NUM_BOOL), make_object(type_id::object_t, i % 8));
+			else atoms.emplace_back(VariableIdx(NUM_BOOL + 1), make_object(type_id::int_t, uint32_t(-int32_t(i))));
+		}
+		return atoms;
+	}
+};
+
+//! With a single entry, all states fall on the same entry, and only the fingerprint tells them apart
+TEST_F(HeuristicCacheTest, FingerprintCollision) {
+	HeuristicCache cache(1, 64);
+	ASSERT_EQ(cache.size(), 1);
+	auto s1 = make_state(1), s2 = make_state(2);
+	long h = 0;
+
+	EXPECT_FALSE(cache.lookup(*s1, h, nullptr));
+	cache.store(*s1, 5, nullptr);
+	EXPECT_TRUE(cache.lookup(*s1, h, nullptr));
+	EXPECT_EQ(h, 5);
+	EXPECT_FALSE(cache.lookup(*s2, h, nullptr));
+	EXPECT_EQ(h, 5); // Untouched by the miss
+
+	// The colliding state overwrites the entry
+	cache.store(*s2, 7, nullptr);
+	EXPECT_TRUE(cache.lookup(*s2, h, nullptr));
+	EXPECT_EQ(h, 7);
+	EXPECT_FALSE(cache.lookup(*s1, h, nullptr));
+
+	// Dead ends are cached as any other value
+	cache.store(*s1, -1, nullptr);
+	EXPECT_TRUE(cache.lookup(*s1, h, nullptr));
+	EXPECT_EQ(h, -1);
+}
+
+TEST_F(HeuristicCacheTest, RelevantAtoms) {
+	HeuristicCache cache(16, 256);
+	auto s1 = make_state(1), s2 = make_state(2), s3 = make_state(3);
+	long h = 0;
+
+	// Many more atoms than the average per entry round-trip, and are appended to what the vector holds
+	auto atoms = relevant_atoms(40);
+	cache.store(*s1, 3, &atoms);
+	std::vector<Atom> relevant{Atom(0, make_object(false))};
+	ASSERT_TRUE(cache.lookup(*s1, h, &relevant));
+	EXPECT_EQ(h, 3);
+	ASSERT_EQ(relevant.size(), atoms.size() + 1);
+	EXPECT_TRUE(std::equal(atoms.begin(), atoms.end(), relevant.begin() + 1));
+
+	// An empty relaxed plan is stored as such
+	std::vector<Atom> none;
+	cache.store(*s2, 0, &none);
+	relevant.clear();
+	EXPECT_TRUE(cache.lookup(*s2, h, &relevant));
+	EXPECT_TRUE(relevant.empty());
+
+	// A value stored without its atoms serves only the lookups that do not need them
+	cache.store(*s3, 4, nullptr);
+	EXPECT_FALSE(cache.lookup(*s3, h, &relevant));
+	EXPECT_TRUE(relevant.empty());
+	EXPECT_TRUE(cache.lookup(*s3, h, nullptr));
+	EXPECT_EQ(h, 4);
+}
+
+//! Once the ring wraps around, the atoms of the older entries are gone, but their heuristic values are not
+TEST_F(HeuristicCacheTest, RingWrapAround) {
+	HeuristicCache cache(32, 16);
+	ASSERT_EQ(cache.ring_size(), 16);
+
+	// Four states on different entries of the table
+	std::vector<std::unique_ptr<State>> states;
+	std::vector<bool> taken(cache.size(), false);
+	for (VariableIdx v = 0; v < NUM_BOOL && states.size() < 4; ++v) {
+		auto state = make_state(v);
+		std::size_t entry = state->hash() & (cache.size() - 1);
+		if (taken[entry]) continue;
+		taken[entry] = true;
+		states.push_back(std::move(state));
+	}
+	ASSERT_EQ(states.size(), 4);
+
+	auto atoms = relevant_atoms(6);
+	for (unsigned i = 0; i < 4; ++i) cache.store(*states[i], i, &atoms);
+
+	// The 24 atoms written so far have overwritten the first 8, i.e. those of the first two states
+	long h = 0;
+	std::vector<Atom> relevant;
+	for (unsigned i = 0; i < 4; ++i) {
+		EXPECT_TRUE(cache.lookup(*states[i], h, nullptr));
+		EXPECT_EQ(h, i);
+		EXPECT_EQ(cache.lookup(*states[i], h, &relevant), i >= 2);
+		EXPECT_EQ(relevant.size(), (i >= 2) ? atoms.size() : 0);
+		if (i >= 2) {
+			EXPECT_EQ(relevant, atoms);
+		}
+		relevant.clear();
+	}
+
+	// Relaxed plans with more atoms than the ring can hold are stored without them
+	auto many = relevant_atoms(17);
+	cache.store(*states[3], 9, &many);
+	EXPECT_FALSE(cache.lookup(*states[3], h, &relevant));
+	EXPECT_TRUE(cache.lookup(*states[3], h, nullptr));
+	EXPECT_EQ(h, 9);
+}
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+
+#include <fs/core/search/nodes/node_pool.hxx>
+
+using namespace lapkt;
+
+namespace {
+
+//! A minimal pooled node with a parent pointer, which counts how many instances are alive
+struct TestNode : public PooledNode<TestNode> {
+	static int alive;
+
+	using ptr_t = IntrusivePtr<TestNode>;
+
+	int value;
+	ptr_t parent;
+
+	TestNode(int value_, ptr_t parent_) : value(value_), parent(std::move(parent_)) { ++alive; }
+	~TestNode() { --alive; }
+};
+
+int TestNode::alive = 0;
+
+} // namespace
+
+
+class NodePoolTest : public testing::Test {
+protected:
+	void SetUp() override { TestNode::alive = 0; }
+};
+
+
+TEST_F(NodePoolTest, ReferenceCounting) {
+	NodePool<TestNode> pool(4);
+	auto root = pool.make(0, nullptr);
+	ASSERT_EQ(root.use_count(), 1);
+
+	{
+		auto child = pool.make(1, root);
+		ASSERT_EQ(root.use_count(), 2);
+		auto copy = child;
+		ASSERT_EQ(child.use_count(), 2);
+		ASSERT_EQ(pool.live(), 2);
+	}
+	ASSERT_EQ(root.use_count(), 1);
+	ASSERT_EQ(pool.live(), 1);
+
+	root = nullptr;
+	ASSERT_EQ(pool.live(), 0);
+	ASSERT_EQ(TestNode::alive, 0);
+}
+
+//! Releasing the last node of a chain releases all its ancestors
+TEST_F(NodePoolTest, Chains) {
+	NodePool<TestNode> pool(4); // Small slabs, so that several of them are needed
+	IntrusivePtr<TestNode> node = pool.make(0, nullptr);
+	for (int i = 1; i < 100; ++i) node = pool.make(i, node);
+	ASSERT_EQ(pool.live(), 100);
+	ASSERT_EQ(node->parent->value, 98);
+
+	node.reset();
+	ASSERT_EQ(pool.live(), 0);
+	ASSERT_EQ(TestNode::alive, 0);
+}
+
+//! Slots of released nodes are reused
+TEST_F(NodePoolTest, Recycling) {
+	NodePool<TestNode> pool(4);
+	TestNode* address;
+	{
+		auto node = pool.make(0, nullptr);
+		address = node.get();
+	}
+	auto node = pool.make(1, nullptr);
+	ASSERT_EQ(node.get(), address);
+	ASSERT_EQ(node->value, 1);
+}
+
+//! Nodes can outlive the pool that created them
+TEST_F(NodePoolTest, OutlivePool) {
+	IntrusivePtr<TestNode> survivor;
+	{
+		NodePool<TestNode> pool(4);
+		auto root = pool.make(0, nullptr);
+		survivor = pool.make(1, root);
+	}
+	ASSERT_EQ(TestNode::alive, 2);
+	ASSERT_EQ(survivor->parent->value, 0);
+	survivor.reset();
+	ASSERT_EQ(TestNode::alive, 0);
+}
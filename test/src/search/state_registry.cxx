@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include <fs/core/search/state_registry.hxx>
+#include <fs/core/atom.hxx>
+#include "fixtures/state_fixture.hxx"
+
+using namespace fs0;
+
+class StateRegistryTest : public fs0::test::StateFixture {
+protected:
+	void SetUp() override {
+		_indexer = make_indexer(20);
+	}
+
+	//! The state where exactly the variables whose bit is set in 'bits' are true
+	State make_state(unsigned bits) const {
+		auto state = make_empty_state();
+		state->update_bits(0, (1u << 20) - 1, bits);
+		return State(std::move(*state));
+	}
+};
+
+
+TEST_F(StateRegistryTest, Interning) {
+	StateRegistry registry(4); // Small, so that the table needs to grow
+	for (unsigned i = 0; i < 500; ++i) {
+		auto registered = registry.insert(make_state(i));
+		ASSERT_TRUE(registered.second);
+		ASSERT_EQ(registered.first, i); // IDs are dense
+	}
+
+	for (unsigned i = 0; i < 500; ++i) {
+		State state = make_state(i);
+		auto registered = registry.insert(state);
+		ASSERT_FALSE(registered.second);
+		ASSERT_EQ(registered.first, i);
+		ASSERT_EQ(registry.find(state), i);
+		ASSERT_EQ(registry.get(i), state);
+	}
+	ASSERT_EQ(registry.size(), 500);
+	ASSERT_EQ(registry.find(make_state(1000)), INVALID_STATE_ID);
+
+	// Interned states have stable addresses
+	const State* first = &registry.get(0);
+	for (unsigned i = 500; i < 2000; ++i) registry.insert(make_state(i));
+	ASSERT_EQ(first, &registry.get(0));
+
+	registry.clear();
+	ASSERT_EQ(registry.size(), 0);
+	ASSERT_FALSE(registry.contains(make_state(0)));
+}
+
+TEST_F(StateRegistryTest, Release) {
+	StateRegistry registry(4);
+	for (unsigned i = 0; i < 300; ++i) registry.insert(make_state(i));
+
+	// Release every third state; the rest must still be found, despite the holes left in the probe sequences
+	for (unsigned i = 0; i < 300; i += 3) registry.release(i);
+	for (unsigned i = 0; i < 300; ++i) {
+		ASSERT_EQ(registry.contains(make_state(i)), i % 3 != 0);
+		if (i % 3 != 0) {
+			ASSERT_EQ(registry.find(make_state(i)), i);
+		}
+	}
+
+	// Released states are new if inserted again, and get a fresh ID
+	auto registered = registry.insert(make_state(3));
+	ASSERT_TRUE(registered.second);
+	ASSERT_EQ(registered.first, 300);
+	ASSERT_EQ(registry.get(300), make_state(3));
+}
+
+TEST_F(StateRegistryTest, IDSet) {
+	StateIDSet set;
+	ASSERT_FALSE(set.contains(0));
+	set.insert(1000);
+	ASSERT_TRUE(set.contains(1000));
+	ASSERT_FALSE(set.contains(999));
+	set.erase(1000);
+	ASSERT_FALSE(set.contains(1000));
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+
+#include <fs/core/state.hxx>
+#include <fs/core/atom.hxx>
+#include "fixtures/state_fixture.hxx"
+
+using namespace fs0;
+
+class PackedState : public fs0::test::StateFixture {
+protected:
+	using WordT = StateAtomIndexer::WordT;
+
+	//! 70 predicative variables, so that they span two words, plus an object variable
+	//! with domain [10, 14], a Boolean multivalued variable and an integer variable.
+	static std::unique_ptr<StateAtomIndexer> make_indexer() {
+		return StateFixture::make_indexer(70, {object_variable(10, 14), bool_variable(), int_variable()});
+	}
+};
+
+
+TEST_F(PackedState, RoundTrip) {
+	auto indexer = make_indexer();
+	auto state = make_empty_state(*indexer);
+	ASSERT_EQ(indexer->size(), 73);
+
+	indexer->update(*state, 3, object_id::TRUE);
+	indexer->update(*state, 69, object_id::TRUE);
+	indexer->update(*state, 70, make_object(type_id::object_t, 14));
+	indexer->update(*state, 71, object_id::FALSE);
+	indexer->update(*state, 72, make_object(type_id::int_t, -5));
+
+	for (VariableIdx var = 0; var < 70; ++var) {
+		ASSERT_EQ(bool(state->getValue(var)), var == 3 || var == 69);
+	}
+	ASSERT_EQ(state->getValue(70), make_object(type_id::object_t, 14));
+	ASSERT_EQ(state->getValue(71), object_id::FALSE);
+	ASSERT_EQ(state->getValue(72), make_object(type_id::int_t, -5));
+
+	// Predicative variables are packed one bit each, from the first word on
+	ASSERT_EQ(state->words()[0], WordT(1) << 3);
+	ASSERT_EQ(state->words()[1] & ((WordT(1) << 6) - 1), WordT(1) << 5);
+}
+
+TEST_F(PackedState, OutOfDomainValuesDoNotCorruptNeighbours) {
+	auto indexer = make_indexer();
+	auto state = make_empty_state(*indexer);
+	indexer->update(*state, 71, object_id::TRUE);
+
+	ASSERT_THROW(indexer->update(*state, 70, make_object(type_id::object_t, 18)), std::runtime_error);
+	ASSERT_THROW(indexer->update(*state, 70, make_object(type_id::object_t, 9)), std::runtime_error);
+	ASSERT_EQ(state->getValue(70), object_id::INVALID);
+	ASSERT_EQ(state->getValue(71), object_id::TRUE);
+}
+
+TEST_F(PackedState, IncrementalHash) {
+	auto indexer = make_indexer();
+	auto state = make_empty_state(*indexer);
+	WordT hash = indexer->hash(*state);
+
+	std::vector<std::pair<VariableIdx, object_id>> changes = {
+		{0, object_id::TRUE}, {65, object_id::TRUE}, {70, make_object(type_id::object_t, 12)},
+		{0, object_id::FALSE}, {70, make_object(type_id::object_t, 10)}, {72, make_object(type_id::int_t, 7)},
+		{65, object_id::TRUE}, // Setting an already set value must not change the hash
+	};
+	for (const auto& change:changes) {
+		hash ^= indexer->update(*state, change.first, change.second);
+		ASSERT_EQ(hash, indexer->hash(*state));
+	}
+
+	// The hash only depends on the values, not on the order in which they were set
+	auto other = make_empty_state(*indexer);
+	indexer->update(*other, 72, make_object(type_id::int_t, 7));
+	indexer->update(*other, 65, object_id::TRUE);
+	indexer->update(*other, 70, make_object(type_id::object_t, 10));
+	ASSERT_EQ(indexer->hash(*other), hash);
+
+	// Bulk updates of predicative variables
+	hash ^= indexer->update_bits(*state, 1, WordT(0x3), WordT(0x2));
+	ASSERT_EQ(hash, indexer->hash(*state));
+	ASSERT_TRUE(bool(state->getValue(65)));
+	ASSERT_FALSE(bool(state->getValue(64)));
+}
+
+TEST_F(PackedState, Diff) {
+	auto indexer = make_indexer();
+	auto s1 = make_empty_state(*indexer);
+	auto s2 = make_empty_state(*indexer);
+	indexer->update(*s2, 1, object_id::TRUE);
+	indexer->update(*s2, 2, object_id::TRUE);
+	indexer->update(*s2, 70, make_object(type_id::object_t, 13));
+
+	std::vector<VariableIdx> changed;
+	indexer->diff(*s1, *s2, changed);
+	std::sort(changed.begin(), changed.end());
+	ASSERT_EQ(changed, std::vector<VariableIdx>({1, 2, 70}));
+}
@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <unordered_set>
+
+#include <fs/core/state.hxx>
+#include <fs/core/atom.hxx>
+#include "fixtures/state_fixture.hxx"
+
+using namespace fs0;
+
+class ZobristHash : public fs0::test::StateFixture {
+protected:
+	void SetUp() override {
+		_indexer = make_indexer(10, {object_variable(0, 7), int_variable(), int_variable()});
+	}
+};
+
+
+//! The hash of the state where all variables have a zero code (i.e. false or invalid) is zero,
+//! and every single-atom state has a different hash
+TEST_F(ZobristHash, Keys) {
+	auto empty = make_empty_state();
+	ASSERT_EQ(empty->hash(), 0);
+
+	std::unordered_set<std::size_t> hashes;
+	auto add = [&](VariableIdx variable, const object_id& value) {
+		auto state = make_empty_state();
+		_indexer->update(*state, variable, value);
+		state->updateHash();
+		ASSERT_NE(state->hash(), 0);
+		ASSERT_TRUE(hashes.insert(state->hash()).second);
+	};
+	for (VariableIdx var = 0; var < 10; ++var) add(var, object_id::TRUE);
+	for (int value = 0; value <= 7; ++value) add(10, make_object(type_id::object_t, value));
+
+	// Numeric variables mix the value with the variable index, so equal values of different variables hash differently
+	for (int value = -3; value <= 3; ++value) {
+		add(11, make_object(type_id::int_t, value));
+		add(12, make_object(type_id::int_t, value));
+	}
+}
+
+TEST_F(ZobristHash, CopiesAndEquality) {
+	auto s1 = make_empty_state();
+	_indexer->update(*s1, 4, object_id::TRUE);
+	_indexer->update(*s1, 10, make_object(type_id::object_t, 3));
+	s1->updateHash();
+
+	State copy(*s1);
+	ASSERT_EQ(copy.hash(), s1->hash());
+	ASSERT_EQ(copy, *s1);
+
+	State moved(std::move(copy));
+	ASSERT_EQ(moved.hash(), s1->hash());
+	ASSERT_EQ(moved, *s1);
+
+	// Bulk updates of the bits of predicative variables are accounted for incrementally
+	moved.update_bits(0, 0x30, 0x20);
+	ASSERT_NE(moved, *s1);
+	ASSERT_EQ(moved.hash(), _indexer->hash(moved));
+	moved.update_bits(0, 0x30, 0x10);
+	ASSERT_EQ(moved.hash(), s1->hash());
+	ASSERT_EQ(moved, *s1);
+}
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include <fs/core/utils/static_table.hxx>
+
+using namespace fs0;
+
+class StaticTableTest : public testing::Test {
+protected:
+	using ExtensionT = StaticTable::ExtensionT;
+
+	static object_id obj(uint32_t value) { return make_object(type_id::object_t, value); }
+
+	//! A binary function over points whose values are too spread for a dense table
+	static ExtensionT sparse_function(unsigned size) {
+		ExtensionT extension;
+		for (uint32_t i = 0; i < size; ++i) {
+			extension.push_back({{obj(i * 10007), obj(i * 7919 + 3)}, obj(i)});
+		}
+		return extension;
+	}
+
+	//! Check that all points of the extension, and no other, are found in the table with their value
+	static void check(const StaticTable& table, const ExtensionT& extension) {
+		for (const auto& elem:extension) {
+			ASSERT_EQ(table.find(elem.first.data()), elem.second);
+		}
+
+		ExtensionT sorted = extension;
+		std::sort(sorted.begin(), sorted.end());
+		for (const auto& elem:extension) {
+			std::vector<object_id> other{elem.first[0], obj(elem.first[1].value() + 1)};
+			auto it = std::lower_bound(sorted.begin(), sorted.end(), other, [](const auto& elem, const auto& point) { return elem.first < point; });
+			if (it != sorted.end() && it->first == other) continue;
+			ASSERT_EQ(table.find(other.data()), object_id::INVALID);
+		}
+		ASSERT_EQ(table.extension(), sorted);
+	}
+};
+
+
+TEST_F(StaticTableTest, Dense) {
+	ExtensionT extension;
+	for (uint32_t x = 5; x < 15; ++x) {
+		for (uint32_t y = 0; y < 4; ++y) {
+			if ((x + y) % 3) extension.push_back({{obj(x), obj(y)}, obj(x * y)});
+		}
+	}
+	StaticTable table(2, false, extension);
+	ASSERT_EQ(table.layout(), StaticTable::Layout::dense);
+	check(table, extension);
+
+	// Points out of the ranges of the table, or with objects of other types, are not in the extension
+	std::vector<object_id> below{obj(4), obj(0)}, above{obj(15), obj(0)}, other_type{make_object(type_id::int_t, 5), obj(0)};
+	ASSERT_EQ(table.find(below.data()), object_id::INVALID);
+	ASSERT_EQ(table.find(above.data()), object_id::INVALID);
+	ASSERT_EQ(table.find(other_type.data()), object_id::INVALID);
+	ASSERT_THROW(table.evaluate(below.data()), std::out_of_range);
+}
+
+TEST_F(StaticTableTest, PerfectHash) {
+	ExtensionT extension = sparse_function(1000);
+	StaticTable table(2, false, extension);
+	ASSERT_EQ(table.layout(), StaticTable::Layout::perfect_hash);
+	check(table, extension);
+}
+
+//! If some bucket finds no displacement within the given number of attempts, the table falls back to a hash map
+TEST_F(StaticTableTest, HashMapFallback) {
+	ExtensionT extension = sparse_function(1000);
+	StaticTable table(2, false, extension, 1);
+	ASSERT_EQ(table.layout(), StaticTable::Layout::hash_map);
+	check(table, extension);
+}
+
+TEST_F(StaticTableTest, Predicate) {
+	ExtensionT extension = sparse_function(100);
+	for (auto& elem:extension) elem.second = object_id::TRUE;
+	StaticTable table(2, true, extension);
+
+	std::vector<object_id> member = extension[17].first, other{obj(1), obj(2)};
+	ASSERT_EQ(table.evaluate(member.data()), object_id::TRUE);
+	ASSERT_EQ(table.evaluate(other.data()), object_id::FALSE);
+}
+
+TEST_F(StaticTableTest, Empty) {
+	StaticTable table(2, true, {});
+	std::vector<object_id> point{obj(1), obj(2)};
+	ASSERT_EQ(table.evaluate(point.data()), object_id::FALSE);
+	ASSERT_TRUE(table.extension().empty());
+}